@@ -25,6 +25,8 @@
 #include "parquet/file_reader.h"
 #include "parquet/metadata.h"
 #include "parquet/printer.h"
+#include "parquet/row_filter.h"
+#include "parquet/row_selection.h"
 
 // Schemas
 #include "parquet/api/schema.h"
@@ -17,6 +17,8 @@
 
 #include "benchmark/benchmark.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include "parquet/arrow/reader.h"
@@ -195,6 +197,67 @@ BENCHMARK_TEMPLATE2(BM_ReadColumn, true, DoubleType);
 BENCHMARK_TEMPLATE2(BM_ReadColumn, false, BooleanType);
 BENCHMARK_TEMPLATE2(BM_ReadColumn, true, BooleanType);
 
+// Wrap values into lists of 0 to 7 elements, every 16th list being null
+std::shared_ptr<::arrow::Array> WrapIntoLists(
+    const std::shared_ptr<::arrow::Array>& values) {
+  ::arrow::MemoryPool* pool = ::arrow::default_memory_pool();
+  std::vector<int32_t> offsets_vector = {0};
+  std::vector<bool> valid;
+  while (offsets_vector.back() < values->length()) {
+    const bool is_valid = valid.size() % 16 != 15;
+    const int64_t list_length = is_valid ? static_cast<int64_t>(valid.size() % 8) : 0;
+    offsets_vector.push_back(static_cast<int32_t>(
+        std::min(offsets_vector.back() + list_length, values->length())));
+    valid.push_back(is_valid);
+  }
+  const int64_t length = static_cast<int64_t>(valid.size());
+
+  auto offsets = std::make_shared<::arrow::PoolBuffer>(pool);
+  EXIT_NOT_OK(offsets->Resize((length + 1) * sizeof(int32_t)));
+  memcpy(offsets->mutable_data(), offsets_vector.data(), (length + 1) * sizeof(int32_t));
+  auto null_bitmap = std::make_shared<::arrow::PoolBuffer>(pool);
+  EXIT_NOT_OK(null_bitmap->Resize(::arrow::BitUtil::BytesForBits(length)));
+  int64_t null_count = 0;
+  for (int64_t i = 0; i < length; i++) {
+    ::arrow::BitUtil::SetBitTo(null_bitmap->mutable_data(), i, valid[i]);
+    null_count += !valid[i];
+  }
+  return std::make_shared<::arrow::ListArray>(::arrow::list(values->type()), length,
+                                              offsets, values, null_bitmap, null_count);
+}
+
+template <int nesting_depth>
+static void BM_ReadListColumn(::benchmark::State& state) {
+  std::vector<int32_t> values(BENCHMARK_SIZE, 128);
+  std::shared_ptr<::arrow::Table> values_table = TableFromVector<Int32Type>(values, true);
+  std::shared_ptr<::arrow::Array> array = values_table->column(0)->data()->chunk(0);
+  for (int i = 0; i < nesting_depth; i++) {
+    array = WrapIntoLists(array);
+  }
+  auto field = ::arrow::field("column", array->type(), true);
+  auto column = std::make_shared<::arrow::Column>(field, array);
+  std::shared_ptr<::arrow::Table> table =
+      ::arrow::Table::Make(::arrow::schema({field}), {column});
+
+  auto output = std::make_shared<InMemoryOutputStream>();
+  EXIT_NOT_OK(WriteTable(*table, ::arrow::default_memory_pool(), output, BENCHMARK_SIZE));
+  std::shared_ptr<Buffer> buffer = output->GetBuffer();
+
+  while (state.KeepRunning()) {
+    auto reader =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+    FileReader filereader(::arrow::default_memory_pool(), std::move(reader));
+    std::shared_ptr<::arrow::Table> table;
+    EXIT_NOT_OK(filereader.ReadTable(&table));
+  }
+  // Values plus their repetition and definition levels
+  state.SetBytesProcessed(state.iterations() * BENCHMARK_SIZE *
+                          (sizeof(int32_t) + 2 * sizeof(int16_t)));
+}
+
+BENCHMARK_TEMPLATE(BM_ReadListColumn, 1);
+BENCHMARK_TEMPLATE(BM_ReadListColumn, 2);
+
 }  // namespace benchmark
 
 }  // namespace parquet
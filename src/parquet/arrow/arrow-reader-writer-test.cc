@@ -26,13 +26,17 @@
 #include <arrow/compute/api.h>
 #include <cstdint>
 #include <functional>
+#include <numeric>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "parquet/api/reader.h"
 #include "parquet/api/writer.h"
 
+#include "parquet/arrow/dataset.h"
 #include "parquet/arrow/reader.h"
+#include "parquet/arrow/record_reader.h"
 #include "parquet/arrow/schema.h"
 #include "parquet/arrow/test-util.h"
 #include "parquet/arrow/writer.h"
@@ -322,16 +326,24 @@ using ParquetWriter = TypedColumnWriter<ParquetDataType<T>>;
 
 void WriteTableToBuffer(const std::shared_ptr<Table>& table, int num_threads,
                         int64_t row_group_size,
+                        const std::shared_ptr<WriterProperties>& properties,
                         const std::shared_ptr<ArrowWriterProperties>& arrow_properties,
                         std::shared_ptr<Buffer>* out) {
   auto sink = std::make_shared<InMemoryOutputStream>();
 
   ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
-                                row_group_size, default_writer_properties(),
-                                arrow_properties));
+                                row_group_size, properties, arrow_properties));
   *out = sink->GetBuffer();
 }
 
+void WriteTableToBuffer(const std::shared_ptr<Table>& table, int num_threads,
+                        int64_t row_group_size,
+                        const std::shared_ptr<ArrowWriterProperties>& arrow_properties,
+                        std::shared_ptr<Buffer>* out) {
+  WriteTableToBuffer(table, num_threads, row_group_size, default_writer_properties(),
+                     arrow_properties, out);
+}
+
 namespace internal {
 
 void AssertArraysEqual(const Array& expected, const Array& actual) {
@@ -1574,6 +1586,154 @@ TEST(TestArrowReadWrite, MultithreadedRead) {
   ASSERT_NO_FATAL_FAILURE(AssertTablesEqual(*table, *result));
 }
 
+TEST(TestArrowReadWrite, MultithreadedWrite) {
+  const int num_columns = 20;
+  const int num_rows = 1000;
+  const int64_t row_group_size = 300;
+
+  std::shared_ptr<Table> table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(num_columns, num_rows, 2, &table));
+
+  auto arrow_properties = ArrowWriterProperties::Builder().set_num_threads(4)->build();
+  std::shared_ptr<Table> result;
+  ASSERT_NO_FATAL_FAILURE(
+      DoSimpleRoundtrip(table, 1, row_group_size, {}, &result, arrow_properties));
+  ASSERT_NO_FATAL_FAILURE(AssertTablesEqual(*table, *result));
+
+  // The column chunks are serialized in schema order, as by a single thread
+  std::shared_ptr<Buffer> parallel_buffer, serial_buffer;
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(table, 1, row_group_size, arrow_properties,
+                                             &parallel_buffer));
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(
+      table, 1, row_group_size, default_arrow_writer_properties(), &serial_buffer));
+  ASSERT_TRUE(parallel_buffer->Equals(*serial_buffer));
+}
+
+TEST(TestArrowReadWrite, MultithreadedReadRowGroups) {
+  const int num_columns = 3;
+  const int num_rows = 1000;
+  const int num_threads = 4;
+  const int64_t row_group_size = 100;
+
+  std::shared_ptr<Table> table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(num_columns, num_rows, 1, &table));
+
+  // A narrow projection is read row group by row group, one chunk each
+  std::shared_ptr<Table> result;
+  std::vector<int> column_subset = {0, 2};
+  ASSERT_NO_FATAL_FAILURE(
+      DoSimpleRoundtrip(table, num_threads, row_group_size, column_subset, &result));
+
+  ASSERT_EQ(2, result->num_columns());
+  ASSERT_EQ(num_rows, result->num_rows());
+  for (int i = 0; i < result->num_columns(); ++i) {
+    const ChunkedArray& chunked_array = *result->column(i)->data();
+    ASSERT_EQ(num_rows / row_group_size, chunked_array.num_chunks());
+    for (int j = 0; j < chunked_array.num_chunks(); ++j) {
+      auto expected = table->column(column_subset[i])->data()->chunk(0)->Slice(
+          j * row_group_size, row_group_size);
+      ASSERT_TRUE(expected->Equals(chunked_array.chunk(j)));
+    }
+  }
+
+  // The same table is returned by a single-threaded read, as one chunk
+  std::shared_ptr<Table> serial_result;
+  ASSERT_NO_FATAL_FAILURE(
+      DoSimpleRoundtrip(table, 1, row_group_size, column_subset, &serial_result));
+  ASSERT_EQ(1, serial_result->column(0)->data()->num_chunks());
+  ASSERT_NO_FATAL_FAILURE(AssertTablesEqual(*serial_result, *result, false));
+}
+
+TEST(TestArrowReadWrite, ReadTableChunkLayout) {
+  const int num_rows = 100;
+  const int64_t row_group_size = 25;
+  const int num_row_groups = static_cast<int>(num_rows / row_group_size);
+
+  std::shared_ptr<Array> list_array;
+  std::shared_ptr<::DataType> list_type;
+  MakeListArray(num_rows, &list_type, &list_array);
+  std::shared_ptr<Table> double_table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(1, num_rows, 1, &double_table));
+
+  auto schema = ::arrow::schema(
+      {::arrow::field("a", list_type), double_table->schema()->field(0)});
+  std::shared_ptr<Table> table =
+      Table::Make(schema, {list_array, double_table->column(0)->data()->chunk(0)});
+
+  // With 1 thread, the columns are one chunk however many row groups there are
+  std::shared_ptr<Table> serial_result;
+  ASSERT_NO_FATAL_FAILURE(
+      DoSimpleRoundtrip(table, 1, row_group_size, {}, &serial_result));
+  ASSERT_NO_FATAL_FAILURE(AssertTablesEqual(*table, *serial_result));
+
+  // With more threads, they have one chunk per row group
+  std::shared_ptr<Table> parallel_result;
+  ASSERT_NO_FATAL_FAILURE(
+      DoSimpleRoundtrip(table, 4, row_group_size, {}, &parallel_result));
+  ASSERT_NO_FATAL_FAILURE(AssertTablesEqual(*table, *parallel_result, false));
+  for (int i = 0; i < parallel_result->num_columns(); ++i) {
+    const ChunkedArray& chunked_array = *parallel_result->column(i)->data();
+    ASSERT_EQ(num_row_groups, chunked_array.num_chunks());
+    for (int j = 0; j < num_row_groups; ++j) {
+      auto expected = table->column(i)->data()->chunk(0)->Slice(j * row_group_size,
+                                                                row_group_size);
+      ASSERT_TRUE(expected->Equals(chunked_array.chunk(j)));
+    }
+  }
+
+  // Unless the file has a single row group
+  ASSERT_NO_FATAL_FAILURE(DoSimpleRoundtrip(table, 4, num_rows, {}, &parallel_result));
+  ASSERT_NO_FATAL_FAILURE(AssertTablesEqual(*table, *parallel_result));
+}
+
+TEST(TestArrowReadWrite, SharedExecutor) {
+  const int num_columns = 10;
+  const int num_rows = 1000;
+  const int64_t row_group_size = 250;
+
+  std::shared_ptr<Table> table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(num_columns, num_rows, 1, &table));
+
+  // The writer encodes columns and compresses pages on the same two threads
+  auto executor = std::make_shared<::parquet::WorkStealingExecutor>(2);
+  auto properties = WriterProperties::Builder()
+                        .compression(Compression::SNAPPY)
+                        ->page_compression_threads(2)
+                        ->data_pagesize(1024)
+                        ->executor(executor)
+                        ->build();
+  auto arrow_properties = ArrowWriterProperties::Builder()
+                              .set_num_threads(4)
+                              ->set_executor(executor)
+                              ->build();
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(table, 1, row_group_size, properties,
+                                             arrow_properties, &buffer));
+
+  // Concurrent readers of the file share the threads too
+  std::vector<std::shared_ptr<Table>> results(4);
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < results.size(); ++i) {
+    readers.emplace_back([&buffer, &executor, &results, i]() {
+      std::unique_ptr<FileReader> reader;
+      ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                                  ::arrow::default_memory_pool(),
+                                  ::parquet::default_reader_properties(), nullptr,
+                                  &reader));
+      reader->set_num_threads(4);
+      reader->set_executor(executor);
+      ASSERT_OK_NO_THROW(reader->ReadTable(&results[i]));
+    });
+  }
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  for (const std::shared_ptr<Table>& result : results) {
+    ASSERT_NE(nullptr, result);
+    ASSERT_NO_FATAL_FAILURE(AssertTablesEqual(*table, *result, false));
+  }
+}
+
 TEST(TestArrowReadWrite, ReadSingleRowGroup) {
   const int num_columns = 20;
   const int num_rows = 1000;
@@ -1603,6 +1763,47 @@ TEST(TestArrowReadWrite, ReadSingleRowGroup) {
   ASSERT_TRUE(table->Equals(*concatenated));
 }
 
+TEST(TestArrowReadWrite, ParallelPageDecoding) {
+  const int num_columns = 3;
+  const int num_rows = 1000;
+
+  std::shared_ptr<Table> table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(num_columns, num_rows, 1, &table));
+
+  // Many small data pages, with and without a dictionary page
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(table, 1, num_rows / 2,
+                                             ::parquet::WriterProperties::Builder()
+                                                 .data_pagesize(512)
+                                                 ->disable_dictionary("col1")
+                                                 ->build(),
+                                             default_arrow_writer_properties(), &buffer));
+
+  auto parquet_reader = ParquetFileReader::Open(std::make_shared<BufferReader>(buffer));
+  for (int j = 0; j < num_columns; ++j) {
+    ASSERT_LT(4u, parquet_reader->RowGroup(0)->GetColumnPageLocations(j).size());
+  }
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  reader->set_num_threads(4);
+  reader->set_parallel_page_decoding(true);
+
+  for (int i = 0; i < reader->num_row_groups(); ++i) {
+    std::shared_ptr<Table> result;
+    ASSERT_OK_NO_THROW(reader->ReadRowGroup(i, &result));
+    ASSERT_EQ(num_columns, result->num_columns());
+    for (int j = 0; j < num_columns; ++j) {
+      auto expected =
+          table->column(j)->data()->chunk(0)->Slice(i * num_rows / 2, num_rows / 2);
+      ASSERT_EQ(1, result->column(j)->data()->num_chunks());
+      ASSERT_TRUE(expected->Equals(result->column(j)->data()->chunk(0)));
+    }
+  }
+}
+
 TEST(TestArrowReadWrite, GetRecordBatchReader) {
   const int num_columns = 20;
   const int num_rows = 1000;
@@ -1636,6 +1837,231 @@ TEST(TestArrowReadWrite, GetRecordBatchReader) {
   ASSERT_EQ(nullptr, batch);
 }
 
+void AssertSelectedRows(const Array& expected, const RowSelection& selection,
+                        const Array& actual) {
+  ASSERT_EQ(selection.num_rows_selected(), actual.length());
+  int64_t position = 0;
+  for (const RowSelection::Range& range : selection.ranges()) {
+    ASSERT_TRUE(expected.Slice(range.offset, range.length)
+                    ->Equals(*actual.Slice(position, range.length)));
+    position += range.length;
+  }
+}
+
+TEST(TestArrowReadWrite, ReadRowGroupWithSelection) {
+  const int num_columns = 5;
+  const int num_rows = 1000;
+
+  std::shared_ptr<Table> table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(num_columns, num_rows, 1, &table));
+
+  // Small data pages, so that some of them are skipped entirely
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(
+      table, 1, num_rows / 2,
+      ::parquet::WriterProperties::Builder().data_pagesize(512)->build(),
+      default_arrow_writer_properties(), &buffer));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+
+  const std::vector<int> column_indices = {0, 2, 4};
+  const RowSelection selection =
+      RowSelection::FromRanges({{0, 10}, {17, 1}, {100, 150}, {499, 1}});
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(1, column_indices, selection, &result));
+  ASSERT_EQ(3, result->num_columns());
+  for (int i = 0; i < result->num_columns(); ++i) {
+    auto expected =
+        table->column(column_indices[i])->data()->chunk(0)->Slice(num_rows / 2);
+    ASSERT_NO_FATAL_FAILURE(
+        AssertSelectedRows(*expected, selection, *result->column(i)->data()->chunk(0)));
+  }
+
+  // A selection from a bitmap
+  std::vector<uint8_t> bitmap(::arrow::BitUtil::BytesForBits(num_rows / 2), 0x5A);
+  const RowSelection bitmap_selection =
+      RowSelection::FromBitmap(bitmap.data(), 0, num_rows / 2);
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, column_indices, bitmap_selection, &result));
+  for (int i = 0; i < result->num_columns(); ++i) {
+    auto expected = table->column(column_indices[i])->data()->chunk(0);
+    ASSERT_NO_FATAL_FAILURE(AssertSelectedRows(*expected, bitmap_selection,
+                                               *result->column(i)->data()->chunk(0)));
+  }
+
+  // The selection must fit into the row group
+  ASSERT_RAISES(Invalid, reader->ReadRowGroup(0, column_indices,
+                                              RowSelection::All(num_rows), &result));
+}
+
+TEST(TestArrowReadWrite, ReadListRowGroupWithSelection) {
+  const int num_rows = 100;
+
+  std::shared_ptr<Array> list_array;
+  std::shared_ptr<::DataType> list_type;
+  MakeListArray(num_rows, &list_type, &list_array);
+
+  auto schema = ::arrow::schema({::arrow::field("a", list_type)});
+  std::shared_ptr<Table> table = Table::Make(schema, {list_array});
+
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(
+      table, 1, num_rows,
+      ::parquet::WriterProperties::Builder().data_pagesize(256)->build(),
+      default_arrow_writer_properties(), &buffer));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+
+  const RowSelection selection =
+      RowSelection::FromRanges({{1, 3}, {10, 1}, {40, 30}, {99, 1}});
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadRowGroup(0, {0}, selection, &result));
+  ASSERT_NO_FATAL_FAILURE(
+      AssertSelectedRows(*list_array, selection, *result->column(0)->data()->chunk(0)));
+}
+
+TEST(TestArrowReadWrite, GetRecordBatchReaderWithSelection) {
+  const int num_columns = 20;
+  const int num_rows = 1000;
+
+  std::shared_ptr<Table> table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(num_columns, num_rows, 1, &table));
+
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(table, 1, num_rows / 4,
+                                             default_arrow_writer_properties(), &buffer));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+
+  std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+  ASSERT_RAISES(Invalid, reader->GetRecordBatchReader(
+                             {0, 1}, {0, 1}, {RowSelection::All(10)}, &rb_reader));
+
+  // The row group with an empty selection is not returned
+  ASSERT_OK_NO_THROW(reader->GetRecordBatchReader(
+      {3, 0, 1}, {0, 1},
+      {RowSelection::FromRanges({{5, 20}}), RowSelection(), RowSelection::All(250)},
+      &rb_reader));
+
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  ASSERT_EQ(20, batch->num_rows());
+  ASSERT_EQ(2, batch->num_columns());
+  ASSERT_TRUE(batch->column(1)->Equals(
+      *table->column(1)->data()->chunk(0)->Slice(3 * num_rows / 4 + 5, 20)));
+
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  ASSERT_EQ(250, batch->num_rows());
+  ASSERT_TRUE(batch->column(0)->Equals(
+      *table->column(0)->data()->chunk(0)->Slice(num_rows / 4, 250)));
+
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+}
+
+TEST(TestArrowReadWrite, ReadTableWithFilter) {
+  const int num_columns = 5;
+  const int num_rows = 1000;
+  const int row_group_size = num_rows / 4;
+
+  std::shared_ptr<Table> table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(num_columns, num_rows, 1, &table));
+
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(
+      table, 1, row_group_size,
+      ::parquet::WriterProperties::Builder().data_pagesize(512)->build(),
+      default_arrow_writer_properties(), &buffer));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+
+  // col0 > 5e9 AND col1 < 0
+  const RowFilter filter({ColumnPredicate::Make<::parquet::DoubleType>(
+                              0, [](const double& value) { return value > 5e9; }),
+                          ColumnPredicate::Make<::parquet::DoubleType>(
+                              1, [](const double& value) { return value < 0; })});
+
+  auto col0 = std::static_pointer_cast<::arrow::DoubleArray>(
+      table->column(0)->data()->chunk(0));
+  auto col1 = std::static_pointer_cast<::arrow::DoubleArray>(
+      table->column(1)->data()->chunk(0));
+  std::vector<uint8_t> expected_bitmap(::arrow::BitUtil::BytesForBits(num_rows), 0);
+  for (int i = 0; i < num_rows; ++i) {
+    if (col0->IsValid(i) && col0->Value(i) > 5e9 && col1->IsValid(i) &&
+        col1->Value(i) < 0) {
+      ::arrow::BitUtil::SetBit(expected_bitmap.data(), i);
+    }
+  }
+
+  const std::vector<int> column_indices = {1, 2, 4};
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(column_indices, filter, &result));
+  ASSERT_EQ(3, result->num_columns());
+  ASSERT_EQ(RowSelection::FromBitmap(expected_bitmap.data(), 0, num_rows)
+                .num_rows_selected(),
+            result->num_rows());
+
+  // Each row group with selected rows is a chunk of the result
+  int chunk = 0;
+  for (int i = 0; i < reader->num_row_groups(); ++i) {
+    RowSelection selection;
+    ASSERT_OK_NO_THROW(reader->EvaluateFilter(i, filter, &selection));
+    ASSERT_TRUE(RowSelection::FromBitmap(expected_bitmap.data(), i * row_group_size,
+                                         row_group_size)
+                    .Equals(selection));
+    if (selection.empty()) {
+      continue;
+    }
+    for (int j = 0; j < result->num_columns(); ++j) {
+      auto expected = table->column(column_indices[j])->data()->chunk(0)->Slice(
+          i * row_group_size, row_group_size);
+      ASSERT_NO_FATAL_FAILURE(AssertSelectedRows(
+          *expected, selection, *result->column(j)->data()->chunk(chunk)));
+    }
+    ++chunk;
+  }
+
+  // The record batch reader evaluates the filter row group by row group
+  std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+  ASSERT_OK_NO_THROW(
+      reader->GetRecordBatchReader({2, 0}, column_indices, filter, &rb_reader));
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  for (int i : {2, 0}) {
+    const RowSelection selection = RowSelection::FromBitmap(
+        expected_bitmap.data(), i * row_group_size, row_group_size);
+    ASSERT_OK(rb_reader->ReadNext(&batch));
+    ASSERT_EQ(3, batch->num_columns());
+    auto expected =
+        table->column(2)->data()->chunk(0)->Slice(i * row_group_size, row_group_size);
+    ASSERT_NO_FATAL_FAILURE(AssertSelectedRows(*expected, selection, *batch->column(1)));
+  }
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+
+  // Without any matching row, the result is empty but keeps its schema
+  const RowFilter none({ColumnPredicate::Make<::parquet::DoubleType>(
+      0, [](const double& value) { return false; })});
+  ASSERT_OK_NO_THROW(reader->ReadTable(column_indices, none, &result));
+  ASSERT_EQ(3, result->num_columns());
+  ASSERT_EQ(0, result->num_rows());
+
+  // Predicates must match the physical type of their column
+  const RowFilter mistyped({ColumnPredicate::Make<::parquet::Int32Type>(
+      0, [](const int32_t& value) { return true; })});
+  ASSERT_RAISES(IOError, reader->ReadTable(column_indices, mistyped, &result));
+}
+
 TEST(TestArrowReadWrite, ScanContents) {
   const int num_columns = 20;
   const int num_rows = 1000;
@@ -1775,6 +2201,43 @@ auto GenerateList = [](int length, std::shared_ptr<::DataType>* type,
   MakeListArray(length, type, array);
 };
 
+TEST(TestArrowReadWrite, LevelsToListOffsets) {
+  // list<list<int32>> with nullable outer and inner lists and values:
+  // [[[1, null], []], null, [], [null], [[2], [3, 4, 5]]]
+  const std::vector<int16_t> def_levels = {5, 4, 3, 0, 1, 2, 5, 5, 5, 5};
+  const std::vector<int16_t> rep_levels = {0, 2, 1, 0, 0, 0, 0, 1, 2, 2};
+  std::vector<::parquet::internal::ListLevel> list_levels(2);
+  list_levels[0].nullable = true;
+  list_levels[0].empty_def_level = 1;
+  list_levels[1].nullable = true;
+  list_levels[1].empty_def_level = 3;
+
+  ASSERT_OK(::parquet::internal::LevelsToListOffsets(
+      def_levels.data(), rep_levels.data(), static_cast<int64_t>(def_levels.size()),
+      4, default_memory_pool(), &list_levels));
+
+  ASSERT_EQ(5, list_levels[0].length);
+  ASSERT_EQ(1, list_levels[0].null_count);
+  ASSERT_EQ(5, list_levels[1].length);
+  ASSERT_EQ(1, list_levels[1].null_count);
+  const std::vector<std::vector<int32_t>> expected_offsets = {{0, 2, 2, 2, 3, 5},
+                                                              {0, 2, 2, 2, 3, 6}};
+  const std::vector<std::vector<bool>> expected_valid = {
+      {true, false, true, true, true}, {true, true, false, true, true}};
+  for (size_t j = 0; j < list_levels.size(); ++j) {
+    const int32_t* offsets =
+        reinterpret_cast<const int32_t*>(list_levels[j].offsets->data());
+    for (size_t i = 0; i < expected_offsets[j].size(); ++i) {
+      ASSERT_EQ(expected_offsets[j][i], offsets[i]) << "level " << j << " list " << i;
+    }
+    for (size_t i = 0; i < expected_valid[j].size(); ++i) {
+      ASSERT_EQ(expected_valid[j][i],
+                ::arrow::BitUtil::GetBit(list_levels[j].valid_bits->data(), i))
+          << "level " << j << " list " << i;
+    }
+  }
+}
+
 TEST(TestArrowReadWrite, TableWithChunkedColumns) {
   std::vector<ArrayFactory> functions = {GenerateInt32, GenerateList};
 
@@ -1888,6 +2351,179 @@ TEST(TestArrowReadWrite, DictionaryColumnChunkedWrite) {
   AssertTablesEqual(*expected_table, *result, false);
 }
 
+// Rows id = first_id, first_id + 1, ... and value = id / 2, so that the
+// statistics of each row group cover a distinct range of ids
+void MakeDatasetFile(int64_t first_id, int num_row_groups, int64_t row_group_size,
+                     std::shared_ptr<Buffer>* out) {
+  std::vector<int64_t> ids(num_row_groups * row_group_size);
+  std::iota(ids.begin(), ids.end(), first_id);
+  std::vector<double> values(ids.size());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    values[i] = static_cast<double>(ids[i]) / 2;
+  }
+  std::shared_ptr<Array> id_array, value_array;
+  ::arrow::ArrayFromVector<::arrow::Int64Type, int64_t>(ids, &id_array);
+  ::arrow::ArrayFromVector<::arrow::DoubleType, double>(values, &value_array);
+  auto schema = ::arrow::schema({::arrow::field("id", ::arrow::int64(), false),
+                                 ::arrow::field("value", ::arrow::float64(), false)});
+  ASSERT_NO_FATAL_FAILURE(WriteTableToBuffer(Table::Make(schema, {id_array, value_array}),
+                                             1, row_group_size,
+                                             default_arrow_writer_properties(), out));
+}
+
+// Open num_files files of 4 row groups of 50 rows, with consecutive ids
+void OpenDataset(int num_files,
+                 const std::shared_ptr<DatasetReaderProperties>& properties,
+                 std::unique_ptr<DatasetReader>* out) {
+  std::vector<std::shared_ptr<::arrow::io::ReadableFileInterface>> files;
+  for (int i = 0; i < num_files; ++i) {
+    std::shared_ptr<Buffer> buffer;
+    ASSERT_NO_FATAL_FAILURE(MakeDatasetFile(i * 200, 4, 50, &buffer));
+    files.push_back(std::make_shared<BufferReader>(buffer));
+  }
+  ASSERT_OK_NO_THROW(
+      DatasetReader::Open(files, ::arrow::default_memory_pool(), properties, out));
+}
+
+void ReadDatasetIds(DatasetReader* dataset, std::vector<int64_t>* out) {
+  std::shared_ptr<::arrow::RecordBatchReader> batch_reader;
+  ASSERT_OK(dataset->GetRecordBatchReader(&batch_reader));
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  while (true) {
+    ASSERT_OK_NO_THROW(batch_reader->ReadNext(&batch));
+    if (batch == nullptr) {
+      break;
+    }
+    ASSERT_TRUE(batch->schema()->Equals(*dataset->schema()));
+    const auto& ids = static_cast<const ::arrow::Int64Array&>(*batch->column(0));
+    out->insert(out->end(), ids.raw_values(), ids.raw_values() + ids.length());
+  }
+}
+
+TEST(TestDatasetReader, ReadInOrder) {
+  auto executor = std::make_shared<::parquet::WorkStealingExecutor>(3);
+  std::vector<int64_t> expected(5 * 200);
+  std::iota(expected.begin(), expected.end(), 0);
+
+  // Row groups are returned in order whether they are read one at a time or
+  // many at once
+  for (int64_t memory_budget : {static_cast<int64_t>(1), DEFAULT_DATASET_MEMORY_BUDGET}) {
+    auto properties = DatasetReaderProperties::Builder()
+                          .set_executor(executor)
+                          ->set_num_threads(2)
+                          ->set_max_row_groups_in_flight(8)
+                          ->set_memory_budget(memory_budget)
+                          ->build();
+    std::unique_ptr<DatasetReader> dataset;
+    ASSERT_NO_FATAL_FAILURE(OpenDataset(5, properties, &dataset));
+    ASSERT_EQ(5, dataset->num_files());
+    ASSERT_EQ(5, dataset->num_selected_files());
+    ASSERT_EQ(20, dataset->num_row_groups());
+    ASSERT_EQ(20, dataset->num_selected_row_groups());
+    ASSERT_EQ(2, dataset->schema()->num_fields());
+
+    std::vector<int64_t> ids;
+    ASSERT_NO_FATAL_FAILURE(ReadDatasetIds(dataset.get(), &ids));
+    ASSERT_EQ(expected, ids);
+  }
+
+  // A reader dropped before the end waits for its reads
+  std::unique_ptr<DatasetReader> dataset;
+  ASSERT_NO_FATAL_FAILURE(
+      OpenDataset(5, DatasetReaderProperties::Builder().set_executor(executor)->build(),
+                  &dataset));
+  std::shared_ptr<::arrow::RecordBatchReader> batch_reader;
+  ASSERT_OK(dataset->GetRecordBatchReader(&batch_reader));
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  ASSERT_OK_NO_THROW(batch_reader->ReadNext(&batch));
+  ASSERT_EQ(50, batch->num_rows());
+  batch_reader.reset();
+}
+
+TEST(TestDatasetReader, PruneWithStatistics) {
+  const int64_t min_id = 250;
+  const int64_t max_id = 520;
+  auto properties = DatasetReaderProperties::Builder()
+                        .add_range(ColumnRange::Make<::parquet::Int64Type>(
+                            "id", &min_id, &max_id))
+                        ->build();
+  std::unique_ptr<DatasetReader> dataset;
+  ASSERT_NO_FATAL_FAILURE(OpenDataset(5, properties, &dataset));
+  ASSERT_EQ(5, dataset->num_files());
+  ASSERT_EQ(2, dataset->num_selected_files());
+  ASSERT_EQ(20, dataset->num_row_groups());
+  ASSERT_EQ(6, dataset->num_selected_row_groups());
+
+  // Pruning is by row group, so all rows of the selected row groups are read
+  std::vector<int64_t> expected(300);
+  std::iota(expected.begin(), expected.end(), 250);
+  std::vector<int64_t> ids;
+  ASSERT_NO_FATAL_FAILURE(ReadDatasetIds(dataset.get(), &ids));
+  ASSERT_EQ(expected, ids);
+
+  // Row groups must match all ranges, and open ranges bound one side only
+  const double max_value = 130;
+  properties = DatasetReaderProperties::Builder()
+                   .add_range(ColumnRange::Make<::parquet::Int64Type>("id", &min_id,
+                                                                      nullptr))
+                   ->add_range(ColumnRange::Make<::parquet::DoubleType>("value", nullptr,
+                                                                        &max_value))
+                   ->build();
+  ASSERT_NO_FATAL_FAILURE(OpenDataset(5, properties, &dataset));
+  ASSERT_EQ(1, dataset->num_selected_files());
+  ASSERT_EQ(1, dataset->num_selected_row_groups());
+
+  // Nothing to read
+  const int64_t beyond = 1000;
+  properties = DatasetReaderProperties::Builder()
+                   .add_range(ColumnRange::Make<::parquet::Int64Type>("id", &beyond,
+                                                                      nullptr))
+                   ->set_columns({"value"})
+                   ->build();
+  ASSERT_NO_FATAL_FAILURE(OpenDataset(5, properties, &dataset));
+  ASSERT_EQ(0, dataset->num_selected_files());
+  ASSERT_EQ(1, dataset->schema()->num_fields());
+  std::shared_ptr<::arrow::RecordBatchReader> batch_reader;
+  ASSERT_OK(dataset->GetRecordBatchReader(&batch_reader));
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  ASSERT_OK_NO_THROW(batch_reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+}
+
+TEST(TestDatasetReader, Errors) {
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_NO_FATAL_FAILURE(MakeDatasetFile(0, 1, 10, &buffer));
+  std::shared_ptr<Table> table;
+  ASSERT_NO_FATAL_FAILURE(MakeDoubleTable(2, 10, 1, &table));
+  std::shared_ptr<Buffer> other_buffer;
+  ASSERT_NO_FATAL_FAILURE(
+      WriteTableToBuffer(table, 1, 10, default_arrow_writer_properties(), &other_buffer));
+
+  auto file = std::make_shared<BufferReader>(buffer);
+  auto other_file = std::make_shared<BufferReader>(other_buffer);
+
+  std::unique_ptr<DatasetReader> dataset;
+  ::arrow::MemoryPool* pool = ::arrow::default_memory_pool();
+  const auto properties = default_dataset_reader_properties();
+  const std::vector<std::shared_ptr<::arrow::io::ReadableFileInterface>> no_files;
+  ASSERT_RAISES(Invalid, DatasetReader::Open(no_files, pool, properties, &dataset));
+
+  // Files must have the same schema
+  ASSERT_RAISES(Invalid,
+                DatasetReader::Open({file, other_file}, pool, properties, &dataset));
+
+  // Ranges must match the physical type of their column
+  const int32_t bound = 0;
+  auto mistyped = DatasetReaderProperties::Builder()
+                      .add_range(ColumnRange::Make<::parquet::Int32Type>("id", &bound,
+                                                                         nullptr))
+                      ->build();
+  ASSERT_RAISES(Invalid, DatasetReader::Open({file}, pool, mistyped, &dataset));
+
+  auto missing = DatasetReaderProperties::Builder().set_columns({"x"})->build();
+  ASSERT_RAISES(Invalid, DatasetReader::Open({file}, pool, missing, &dataset));
+}
+
 TEST(TestArrowWrite, CheckChunkSize) {
   const int num_columns = 2;
   const int num_rows = 128;
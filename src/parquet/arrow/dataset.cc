@@ -0,0 +1,468 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/arrow/dataset.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/io/file.h"
+
+#include "parquet/arrow/reader.h"
+#include "parquet/exception.h"
+#include "parquet/util/comparison.h"
+
+using arrow::MemoryPool;
+using arrow::RecordBatchReader;
+using arrow::Status;
+using arrow::Table;
+
+using ReadableFileInterface = arrow::io::ReadableFileInterface;
+
+namespace parquet {
+namespace arrow {
+
+// ----------------------------------------------------------------------
+// ColumnRange
+
+template <typename DType>
+TypedColumnRange<DType>::TypedColumnRange(const std::string& column_path, const T* min,
+                                          const T* max)
+    : ColumnRange(column_path),
+      has_min_(min != nullptr),
+      min_(min != nullptr ? *min : T()),
+      has_max_(max != nullptr),
+      max_(max != nullptr ? *max : T()) {}
+
+template <typename DType>
+bool TypedColumnRange<DType>::MayMatch(const ColumnDescriptor* descr,
+                                       const RowGroupStatistics& statistics) const {
+  if (descr->physical_type() != DType::type_num ||
+      statistics.physical_type() != DType::type_num) {
+    throw ParquetException("Column does not have the physical type of the range");
+  }
+  // num_values does not count nulls, which are outside of any range
+  if (statistics.num_values() == 0) {
+    return false;
+  }
+  const auto& typed = static_cast<const TypedRowGroupStatistics<DType>&>(statistics);
+  if (!typed.HasMinMax()) {
+    return true;
+  }
+  auto less = std::static_pointer_cast<CompareDefault<DType>>(
+      Comparator::Make(descr));
+  if (has_min_ && (*less)(typed.max(), min_)) {
+    return false;
+  }
+  if (has_max_ && (*less)(max_, typed.min())) {
+    return false;
+  }
+  return true;
+}
+
+template class PARQUET_TEMPLATE_EXPORT TypedColumnRange<BooleanType>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnRange<Int32Type>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnRange<Int64Type>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnRange<FloatType>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnRange<DoubleType>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnRange<ByteArrayType>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnRange<FLBAType>;
+
+std::shared_ptr<DatasetReaderProperties> default_dataset_reader_properties() {
+  static std::shared_ptr<DatasetReaderProperties> default_properties =
+      DatasetReaderProperties::Builder().build();
+  return default_properties;
+}
+
+// ----------------------------------------------------------------------
+// DatasetReader
+
+namespace {
+
+// A row group left after pruning
+struct SelectedRowGroup {
+  int file;
+  int row_group;
+  // Uncompressed size of the selected column chunks, charged to the budget
+  int64_t size;
+};
+
+// What is left to read of a dataset once it is opened
+struct DatasetScan {
+  std::shared_ptr<DatasetReaderProperties> properties;
+  std::shared_ptr<Executor> executor;
+  std::shared_ptr<::arrow::Schema> schema;
+  // Readers of the files with selected row groups, nullptr for the others
+  std::vector<std::unique_ptr<FileReader>> readers;
+  // Leaf indices of the selected columns in the schema of each file
+  std::vector<std::vector<int>> column_indices;
+  // In the order they are returned, by file then by row group
+  std::vector<SelectedRowGroup> row_groups;
+};
+
+// Reads the selected row groups on the executor, as many at once as the limits
+// of the properties allow, and returns them in order
+class DatasetRecordBatchReader : public RecordBatchReader {
+ public:
+  explicit DatasetRecordBatchReader(const DatasetScan* scan)
+      : scan_(scan),
+        next_row_group_(0),
+        reserved_bytes_(0),
+        current_size_(0),
+        num_in_flight_(0) {}
+
+  ~DatasetRecordBatchReader() {
+    // The reads use the file readers, and write to pending_
+    WaitUntil([this]() { return num_in_flight_ == 0; });
+  }
+
+  std::shared_ptr<::arrow::Schema> schema() const override { return scan_->schema; }
+
+  Status ReadNext(std::shared_ptr<::arrow::RecordBatch>* out) override {
+    while (true) {
+      if (table_batch_reader_ != nullptr) {
+        std::shared_ptr<::arrow::RecordBatch> batch;
+        RETURN_NOT_OK(table_batch_reader_->ReadNext(&batch));
+        if (batch != nullptr) {
+          *out = batch;
+          return Status::OK();
+        }
+        table_batch_reader_.reset();
+        table_.reset();
+        reserved_bytes_ -= current_size_;
+        current_size_ = 0;
+      }
+
+      ScheduleReads();
+      if (pending_.empty()) {
+        *out = nullptr;
+        return Status::OK();
+      }
+
+      // Row groups are returned in order, whichever read completes first
+      std::unique_ptr<PendingRead> read = std::move(pending_.front());
+      pending_.pop_front();
+      WaitUntil([&read]() { return read->done; });
+      if (!read->status.ok()) {
+        reserved_bytes_ -= read->size;
+        return read->status;
+      }
+      current_size_ = read->size;
+      table_ = read->table;
+      table_batch_reader_.reset(new ::arrow::TableBatchReader(*table_));
+      ScheduleReads();
+    }
+  }
+
+ private:
+  struct PendingRead {
+    int64_t size;
+    bool done;
+    Status status;
+    std::shared_ptr<Table> table;
+  };
+
+  // Start the reads of the next row groups, while they fit in the budget
+  void ScheduleReads() {
+    const DatasetReaderProperties& properties = *scan_->properties;
+    const int max_in_flight = properties.max_row_groups_in_flight();
+    while (next_row_group_ < scan_->row_groups.size()) {
+      const SelectedRowGroup& row_group = scan_->row_groups[next_row_group_];
+      const int num_reserved =
+          static_cast<int>(pending_.size()) + (table_ != nullptr ? 1 : 0);
+      if (num_reserved >= max_in_flight) {
+        break;
+      }
+      // A row group over the budget is read once nothing else is held
+      if (num_reserved > 0 &&
+          reserved_bytes_ + row_group.size > properties.memory_budget()) {
+        break;
+      }
+      reserved_bytes_ += row_group.size;
+      ++next_row_group_;
+
+      pending_.emplace_back(new PendingRead());
+      PendingRead* read = pending_.back().get();
+      read->size = row_group.size;
+      read->done = false;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++num_in_flight_;
+      }
+      FileReader* reader = scan_->readers[row_group.file].get();
+      const std::vector<int>* column_indices = &scan_->column_indices[row_group.file];
+      const int i = row_group.row_group;
+      scan_->executor->Submit(
+          [this, read, reader, column_indices, i]() {
+            std::shared_ptr<Table> table;
+            Status status;
+            try {
+              status = reader->ReadRowGroup(i, *column_indices, &table);
+            } catch (const std::exception& e) {
+              status = Status::IOError(e.what());
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            read->status = status;
+            read->table = table;
+            read->done = true;
+            --num_in_flight_;
+            read_done_.notify_all();
+          },
+          row_group.size, this);
+    }
+  }
+
+  // Wait until done() holds under mutex_. Called from a thread of the executor,
+  // run the reads of this reader meanwhile, so that they progress even if all
+  // of its threads wait on them
+  void WaitUntil(const std::function<bool()>& done) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!done()) {
+      lock.unlock();
+      const bool ran_task = scan_->executor->RunPendingTask(this);
+      lock.lock();
+      if (!ran_task && !done()) {
+        read_done_.wait(lock);
+      }
+    }
+  }
+
+  const DatasetScan* scan_;
+
+  // Index in scan_->row_groups of the next row group to read
+  size_t next_row_group_;
+  // Sizes of the row groups read or being read, and not consumed yet
+  int64_t reserved_bytes_;
+  int64_t current_size_;
+  std::deque<std::unique_ptr<PendingRead>> pending_;
+
+  std::shared_ptr<Table> table_;
+  std::unique_ptr<::arrow::TableBatchReader> table_batch_reader_;
+
+  // Guards the PendingRead written by the reads, and num_in_flight_
+  std::mutex mutex_;
+  std::condition_variable read_done_;
+  int num_in_flight_;
+};
+
+}  // namespace
+
+class DatasetReader::Impl {
+ public:
+  typedef std::function<Status(int, std::shared_ptr<ReadableFileInterface>*)> FileOpener;
+
+  Impl(MemoryPool* pool, const std::shared_ptr<DatasetReaderProperties>& properties)
+      : pool_(pool), num_row_groups_(0), num_selected_files_(0) {
+    scan_.properties = properties;
+    scan_.executor = properties->executor();
+  }
+
+  Status Open(int num_files, const FileOpener& open_file) {
+    if (num_files == 0) {
+      return Status::Invalid("A dataset needs at least one file");
+    }
+    scan_.readers.resize(num_files);
+    scan_.column_indices.resize(num_files);
+    std::vector<std::shared_ptr<::arrow::Schema>> schemas(num_files);
+    std::vector<int> num_row_groups(num_files, 0);
+    std::vector<std::vector<SelectedRowGroup>> selected(num_files);
+
+    // Footers are read, and row groups pruned, one file per task
+    Executor* executor = scan_.executor.get();
+    RETURN_NOT_OK(executor->ParallelFor(
+        executor->capacity(), num_files,
+        [this, &open_file, &schemas, &num_row_groups, &selected](int i) {
+          return OpenFile(i, open_file, &schemas[i], &num_row_groups[i], &selected[i]);
+        }));
+
+    scan_.schema = schemas[0];
+    for (int i = 0; i < num_files; ++i) {
+      if (!schemas[i]->Equals(*scan_.schema)) {
+        std::stringstream ss;
+        ss << "Schema of file " << i << " differs from the schema of file 0:\n"
+           << schemas[i]->ToString() << "\nvs\n"
+           << scan_.schema->ToString();
+        return Status::Invalid(ss.str());
+      }
+      num_row_groups_ += num_row_groups[i];
+      if (selected[i].empty()) {
+        // Nothing is read from the file, so it does not need to stay open
+        scan_.readers[i].reset();
+        continue;
+      }
+      ++num_selected_files_;
+      scan_.row_groups.insert(scan_.row_groups.end(), selected[i].begin(),
+                              selected[i].end());
+    }
+    return Status::OK();
+  }
+
+  std::shared_ptr<::arrow::Schema> schema() const { return scan_.schema; }
+
+  int num_files() const { return static_cast<int>(scan_.readers.size()); }
+
+  int num_selected_files() const { return num_selected_files_; }
+
+  int64_t num_row_groups() const { return num_row_groups_; }
+
+  int64_t num_selected_row_groups() const {
+    return static_cast<int64_t>(scan_.row_groups.size());
+  }
+
+  Status GetRecordBatchReader(std::shared_ptr<RecordBatchReader>* out) const {
+    *out = std::make_shared<DatasetRecordBatchReader>(&scan_);
+    return Status::OK();
+  }
+
+ private:
+  Status OpenFile(int i, const FileOpener& open_file,
+                  std::shared_ptr<::arrow::Schema>* schema, int* num_row_groups,
+                  std::vector<SelectedRowGroup>* selected) {
+    const DatasetReaderProperties& properties = *scan_.properties;
+    std::unique_ptr<FileReader>* reader = &scan_.readers[i];
+    std::shared_ptr<ReadableFileInterface> file;
+    RETURN_NOT_OK(open_file(i, &file));
+    RETURN_NOT_OK(::parquet::arrow::OpenFile(
+        file, pool_, properties.reader_properties(), nullptr, reader));
+    (*reader)->set_num_threads(properties.num_threads());
+    (*reader)->set_executor(scan_.executor);
+
+    const std::shared_ptr<FileMetaData> metadata =
+        (*reader)->parquet_reader()->metadata();
+    const SchemaDescriptor* descr = metadata->schema();
+    std::vector<int>* column_indices = &scan_.column_indices[i];
+    if (properties.column_paths().empty()) {
+      for (int c = 0; c < descr->num_columns(); ++c) {
+        column_indices->push_back(c);
+      }
+    } else {
+      for (const std::string& path : properties.column_paths()) {
+        const int c = descr->ColumnIndex(path);
+        if (c < 0) {
+          std::stringstream ss;
+          ss << "File " << i << " has no column " << path;
+          return Status::Invalid(ss.str());
+        }
+        column_indices->push_back(c);
+      }
+    }
+    RETURN_NOT_OK((*reader)->GetSchema(*column_indices, schema));
+
+    const std::vector<std::shared_ptr<ColumnRange>>& ranges = properties.ranges();
+    std::vector<int> range_columns;
+    for (const std::shared_ptr<ColumnRange>& range : ranges) {
+      const int c = descr->ColumnIndex(range->column_path());
+      if (c < 0 || descr->Column(c)->physical_type() != range->physical_type()) {
+        std::stringstream ss;
+        ss << "File " << i << " has no column " << range->column_path()
+           << " of the physical type of its range";
+        return Status::Invalid(ss.str());
+      }
+      range_columns.push_back(c);
+    }
+
+    *num_row_groups = metadata->num_row_groups();
+    for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+      std::unique_ptr<RowGroupMetaData> row_group = metadata->RowGroup(rg);
+      bool may_match = true;
+      for (size_t r = 0; r < ranges.size() && may_match; ++r) {
+        std::unique_ptr<ColumnChunkMetaData> chunk =
+            row_group->ColumnChunk(range_columns[r]);
+        may_match = !chunk->is_stats_set() ||
+                    ranges[r]->MayMatch(descr->Column(range_columns[r]),
+                                        *chunk->statistics());
+      }
+      if (!may_match) {
+        continue;
+      }
+      int64_t size = 0;
+      for (int c : *column_indices) {
+        size += row_group->ColumnChunk(c)->total_uncompressed_size();
+      }
+      selected->push_back({i, rg, size});
+    }
+    return Status::OK();
+  }
+
+  MemoryPool* pool_;
+  DatasetScan scan_;
+  int64_t num_row_groups_;
+  int num_selected_files_;
+};
+
+DatasetReader::DatasetReader(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+DatasetReader::~DatasetReader() {}
+
+Status DatasetReader::Open(
+    const std::vector<std::shared_ptr<ReadableFileInterface>>& files, MemoryPool* pool,
+    const std::shared_ptr<DatasetReaderProperties>& properties,
+    std::unique_ptr<DatasetReader>* out) {
+  std::unique_ptr<Impl> impl(new Impl(pool, properties));
+  RETURN_NOT_OK(impl->Open(
+      static_cast<int>(files.size()),
+      [&files](int i, std::shared_ptr<ReadableFileInterface>* file) {
+        *file = files[i];
+        return Status::OK();
+      }));
+  out->reset(new DatasetReader(std::move(impl)));
+  return Status::OK();
+}
+
+Status DatasetReader::Open(const std::vector<std::string>& paths, MemoryPool* pool,
+                           const std::shared_ptr<DatasetReaderProperties>& properties,
+                           std::unique_ptr<DatasetReader>* out) {
+  std::unique_ptr<Impl> impl(new Impl(pool, properties));
+  RETURN_NOT_OK(impl->Open(
+      static_cast<int>(paths.size()),
+      [&paths, pool](int i, std::shared_ptr<ReadableFileInterface>* file) {
+        std::shared_ptr<::arrow::io::ReadableFile> handle;
+        RETURN_NOT_OK(::arrow::io::ReadableFile::Open(paths[i], pool, &handle));
+        *file = handle;
+        return Status::OK();
+      }));
+  out->reset(new DatasetReader(std::move(impl)));
+  return Status::OK();
+}
+
+std::shared_ptr<::arrow::Schema> DatasetReader::schema() const {
+  return impl_->schema();
+}
+
+int DatasetReader::num_files() const { return impl_->num_files(); }
+
+int DatasetReader::num_selected_files() const { return impl_->num_selected_files(); }
+
+int64_t DatasetReader::num_row_groups() const { return impl_->num_row_groups(); }
+
+int64_t DatasetReader::num_selected_row_groups() const {
+  return impl_->num_selected_row_groups();
+}
+
+Status DatasetReader::GetRecordBatchReader(std::shared_ptr<RecordBatchReader>* out) {
+  return impl_->GetRecordBatchReader(out);
+}
+
+}  // namespace arrow
+}  // namespace parquet
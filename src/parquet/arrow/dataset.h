@@ -0,0 +1,282 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_ARROW_DATASET_H
+#define PARQUET_ARROW_DATASET_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/api/reader.h"
+#include "parquet/util/executor.h"
+
+#include "arrow/io/interfaces.h"
+
+namespace arrow {
+
+class MemoryPool;
+class RecordBatchReader;
+class Schema;
+class Status;
+}  // namespace arrow
+
+namespace parquet {
+namespace arrow {
+
+static constexpr int64_t DEFAULT_DATASET_MEMORY_BUDGET = 256 * 1024 * 1024;
+
+/// \brief An inclusive range of values of one leaf column. DatasetReader skips
+/// the row groups, and the files, whose column chunk statistics show that none
+/// of their values fall into the range
+class PARQUET_EXPORT ColumnRange {
+ public:
+  virtual ~ColumnRange() = default;
+
+  /// \brief Range [*min, *max] of the leaf column at column_path, e.g. "a.b".
+  /// A null bound leaves that side of the range open. The bytes of ByteArray
+  /// and FLBA bounds are not copied and must outlive the range
+  template <typename DType>
+  static std::shared_ptr<ColumnRange> Make(const std::string& column_path,
+                                           const typename DType::c_type* min,
+                                           const typename DType::c_type* max);
+
+  const std::string& column_path() const { return column_path_; }
+
+  /// \brief Physical type of the column, which the bounds are compared as
+  virtual Type::type physical_type() const = 0;
+
+  /// \brief Return false if the statistics of a chunk of column descr show that
+  /// none of its values fall into the range. Null values never do. Throws
+  /// ParquetException if the column is not of physical_type()
+  virtual bool MayMatch(const ColumnDescriptor* descr,
+                        const RowGroupStatistics& statistics) const = 0;
+
+ protected:
+  explicit ColumnRange(const std::string& column_path) : column_path_(column_path) {}
+
+ private:
+  std::string column_path_;
+};
+
+template <typename DType>
+class PARQUET_EXPORT TypedColumnRange : public ColumnRange {
+ public:
+  typedef typename DType::c_type T;
+
+  TypedColumnRange(const std::string& column_path, const T* min, const T* max);
+
+  Type::type physical_type() const override { return DType::type_num; }
+
+  bool MayMatch(const ColumnDescriptor* descr,
+                const RowGroupStatistics& statistics) const override;
+
+ private:
+  bool has_min_;
+  T min_;
+  bool has_max_;
+  T max_;
+};
+
+template <typename DType>
+std::shared_ptr<ColumnRange> ColumnRange::Make(const std::string& column_path,
+                                               const typename DType::c_type* min,
+                                               const typename DType::c_type* max) {
+  return std::make_shared<TypedColumnRange<DType>>(column_path, min, max);
+}
+
+class PARQUET_EXPORT DatasetReaderProperties {
+ public:
+  class Builder {
+   public:
+    Builder()
+        : reader_properties_(default_reader_properties()),
+          num_threads_(1),
+          max_row_groups_in_flight_(0),
+          memory_budget_(DEFAULT_DATASET_MEMORY_BUDGET) {}
+    virtual ~Builder() {}
+
+    /// Dot-separated paths of the leaf columns to read. All columns of the first
+    /// file are read by default
+    Builder* set_columns(const std::vector<std::string>& column_paths) {
+      column_paths_ = column_paths;
+      return this;
+    }
+
+    /// Skip the row groups with no value in range. Row groups must have values
+    /// in all ranges to be read
+    Builder* add_range(const std::shared_ptr<ColumnRange>& range) {
+      ranges_.push_back(range);
+      return this;
+    }
+
+    Builder* set_reader_properties(const ReaderProperties& properties) {
+      reader_properties_ = properties;
+      return this;
+    }
+
+    /// Number of columns of a row group that are decoded concurrently, as in
+    /// FileReader::set_num_threads
+    Builder* set_num_threads(int num_threads) {
+      num_threads_ = num_threads;
+      return this;
+    }
+
+    /// Run the footer, row group and column reads on the threads of executor
+    /// instead of default_executor()
+    Builder* set_executor(const std::shared_ptr<Executor>& executor) {
+      executor_ = executor;
+      return this;
+    }
+
+    /// Number of row groups read ahead of the consumer at most, across all
+    /// files. Defaults to the capacity of the executor
+    Builder* set_max_row_groups_in_flight(int max_row_groups_in_flight) {
+      max_row_groups_in_flight_ = max_row_groups_in_flight;
+      return this;
+    }
+
+    /// Bound on the uncompressed size of the row groups being read or waiting
+    /// to be consumed. A row group larger than the budget is still read, alone
+    Builder* set_memory_budget(int64_t bytes) {
+      memory_budget_ = bytes;
+      return this;
+    }
+
+    std::shared_ptr<DatasetReaderProperties> build() {
+      return std::shared_ptr<DatasetReaderProperties>(new DatasetReaderProperties(
+          column_paths_, ranges_, reader_properties_, num_threads_, executor_,
+          max_row_groups_in_flight_, memory_budget_));
+    }
+
+   private:
+    std::vector<std::string> column_paths_;
+    std::vector<std::shared_ptr<ColumnRange>> ranges_;
+    ReaderProperties reader_properties_;
+    int num_threads_;
+    std::shared_ptr<Executor> executor_;
+    int max_row_groups_in_flight_;
+    int64_t memory_budget_;
+  };
+
+  const std::vector<std::string>& column_paths() const { return column_paths_; }
+
+  const std::vector<std::shared_ptr<ColumnRange>>& ranges() const { return ranges_; }
+
+  const ReaderProperties& reader_properties() const { return reader_properties_; }
+
+  int num_threads() const { return num_threads_; }
+
+  std::shared_ptr<Executor> executor() const {
+    return executor_ ? executor_ : default_executor();
+  }
+
+  int max_row_groups_in_flight() const {
+    return max_row_groups_in_flight_ > 0 ? max_row_groups_in_flight_
+                                         : executor()->capacity();
+  }
+
+  int64_t memory_budget() const { return memory_budget_; }
+
+ private:
+  DatasetReaderProperties(const std::vector<std::string>& column_paths,
+                          const std::vector<std::shared_ptr<ColumnRange>>& ranges,
+                          const ReaderProperties& reader_properties, int num_threads,
+                          const std::shared_ptr<Executor>& executor,
+                          int max_row_groups_in_flight, int64_t memory_budget)
+      : column_paths_(column_paths),
+        ranges_(ranges),
+        reader_properties_(reader_properties),
+        num_threads_(num_threads),
+        executor_(executor),
+        max_row_groups_in_flight_(max_row_groups_in_flight),
+        memory_budget_(memory_budget) {}
+
+  const std::vector<std::string> column_paths_;
+  const std::vector<std::shared_ptr<ColumnRange>> ranges_;
+  const ReaderProperties reader_properties_;
+  const int num_threads_;
+  const std::shared_ptr<Executor> executor_;
+  const int max_row_groups_in_flight_;
+  const int64_t memory_budget_;
+};
+
+std::shared_ptr<DatasetReaderProperties> PARQUET_EXPORT
+default_dataset_reader_properties();
+
+/// \brief Reads a set of Parquet files with the same schema as one stream of
+/// record batches.
+///
+/// The footers of the files are read in parallel when the dataset is opened,
+/// and the row groups that fall outside of the ranges of the properties are
+/// pruned using their statistics. The remaining row groups are then read ahead
+/// of the consumer on the shared executor, within the memory budget, and
+/// returned in the order of the files and of the row groups in each file.
+class PARQUET_EXPORT DatasetReader {
+ public:
+  ~DatasetReader();
+
+  static ::arrow::Status Open(
+      const std::vector<std::shared_ptr<::arrow::io::ReadableFileInterface>>& files,
+      ::arrow::MemoryPool* pool,
+      const std::shared_ptr<DatasetReaderProperties>& properties,
+      std::unique_ptr<DatasetReader>* out);
+
+  /// \brief Open the local files at paths, which is done on the executor too
+  static ::arrow::Status Open(const std::vector<std::string>& paths,
+                              ::arrow::MemoryPool* pool,
+                              const std::shared_ptr<DatasetReaderProperties>& properties,
+                              std::unique_ptr<DatasetReader>* out);
+
+  /// \brief Schema of the selected columns, common to all files
+  std::shared_ptr<::arrow::Schema> schema() const;
+
+  int num_files() const;
+
+  /// \brief Number of files with at least one row group left after pruning
+  int num_selected_files() const;
+
+  int64_t num_row_groups() const;
+
+  /// \brief Number of row groups left after pruning
+  int64_t num_selected_row_groups() const;
+
+  /// \brief Return a reader of the selected row groups. Each row group is read
+  /// as one table whose chunks are returned as batches. The DatasetReader must
+  /// outlive the RecordBatchReader
+  ::arrow::Status GetRecordBatchReader(std::shared_ptr<::arrow::RecordBatchReader>* out);
+
+ private:
+  class Impl;
+  explicit DatasetReader(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
+extern template class PARQUET_EXPORT TypedColumnRange<BooleanType>;
+extern template class PARQUET_EXPORT TypedColumnRange<Int32Type>;
+extern template class PARQUET_EXPORT TypedColumnRange<Int64Type>;
+extern template class PARQUET_EXPORT TypedColumnRange<FloatType>;
+extern template class PARQUET_EXPORT TypedColumnRange<DoubleType>;
+extern template class PARQUET_EXPORT TypedColumnRange<ByteArrayType>;
+extern template class PARQUET_EXPORT TypedColumnRange<FLBAType>;
+
+}  // namespace arrow
+}  // namespace parquet
+
+#endif  // PARQUET_ARROW_DATASET_H
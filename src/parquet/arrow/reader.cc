@@ -20,6 +20,8 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstring>
+#include <functional>
 #include <mutex>
 #include <queue>
 #include <string>
@@ -31,12 +33,14 @@
 #include "arrow/util/bit-util.h"
 #include "arrow/util/decimal.h"
 #include "arrow/util/logging.h"
-#include "arrow/util/parallel.h"
 
 #include "parquet/arrow/record_reader.h"
 #include "parquet/arrow/schema.h"
 #include "parquet/column_reader.h"
+#include "parquet/row_filter.h"
+#include "parquet/row_selection.h"
 #include "parquet/schema.h"
+#include "parquet/util/executor.h"
 #include "parquet/util/schema-util.h"
 
 using arrow::Array;
@@ -56,9 +60,9 @@ using parquet::schema::Node;
 
 // Help reduce verbosity
 using ParquetReader = parquet::ParquetFileReader;
-using arrow::ParallelFor;
 using arrow::RecordBatchReader;
 
+using parquet::internal::ListLevel;
 using parquet::internal::RecordReader;
 
 namespace parquet {
@@ -153,14 +157,28 @@ class SingleRowGroupIterator : public FileColumnIterator {
   bool done_;
 };
 
+// Create the iterator of a leaf column, so that nested readers can restrict all
+// of their leaf columns to the same row groups
+typedef std::function<FileColumnIterator*(int, ParquetFileReader*)>
+    FileColumnIteratorFactory;
+
+static FileColumnIterator* MakeAllRowGroupsIterator(int column_index,
+                                                    ParquetFileReader* reader) {
+  return new AllRowGroupsIterator(column_index, reader);
+}
+
 class RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
  public:
   explicit RowGroupRecordBatchReader(const std::vector<int>& row_group_indices,
                                      const std::vector<int>& column_indices,
+                                     const std::vector<RowSelection>& row_selections,
+                                     const RowFilter& filter,
                                      std::shared_ptr<::arrow::Schema> schema,
                                      FileReader* reader)
       : row_group_indices_(row_group_indices),
         column_indices_(column_indices),
+        row_selections_(row_selections),
+        filter_(filter),
         schema_(schema),
         file_reader_(reader),
         next_row_group_(0) {}
@@ -182,14 +200,35 @@ class RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
       }
     }
 
+    // row groups without any selected rows are not read at all
+    const bool has_selection = !row_selections_.empty() || !filter_.empty();
+    RowSelection selection;
+    for (; next_row_group_ < row_group_indices_.size(); next_row_group_++) {
+      if (!row_selections_.empty()) {
+        selection = row_selections_[next_row_group_];
+      } else if (!filter_.empty()) {
+        RETURN_NOT_OK(file_reader_->EvaluateFilter(row_group_indices_[next_row_group_],
+                                                   filter_, &selection));
+      }
+      if (!has_selection || !selection.empty()) {
+        break;
+      }
+    }
+
     // all row groups has been consumed
     if (next_row_group_ == row_group_indices_.size()) {
       *out = nullptr;
       return Status::OK();
     }
 
-    RETURN_NOT_OK(file_reader_->ReadRowGroup(row_group_indices_[next_row_group_],
-                                             column_indices_, &table_));
+    const int row_group_index = row_group_indices_[next_row_group_];
+    if (!has_selection) {
+      RETURN_NOT_OK(
+          file_reader_->ReadRowGroup(row_group_index, column_indices_, &table_));
+    } else {
+      RETURN_NOT_OK(file_reader_->ReadRowGroup(row_group_index, column_indices_,
+                                               selection, &table_));
+    }
 
     next_row_group_++;
     table_batch_reader_.reset(new ::arrow::TableBatchReader(*table_.get()));
@@ -199,6 +238,8 @@ class RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
  private:
   std::vector<int> row_group_indices_;
   std::vector<int> column_indices_;
+  std::vector<RowSelection> row_selections_;
+  RowFilter filter_;
   std::shared_ptr<::arrow::Schema> schema_;
   FileReader* file_reader_;
   size_t next_row_group_;
@@ -212,7 +253,10 @@ class RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
 class FileReader::Impl {
  public:
   Impl(MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader)
-      : pool_(pool), reader_(std::move(reader)), num_threads_(1) {}
+      : pool_(pool),
+        reader_(std::move(reader)),
+        num_threads_(1),
+        parallel_page_decoding_(false) {}
 
   virtual ~Impl() {}
 
@@ -222,17 +266,26 @@ class FileReader::Impl {
                          std::shared_ptr<Array>* out);
   Status GetReaderForNode(int index, const Node* node, const std::vector<int>& indices,
                           int16_t def_level,
+                          const FileColumnIteratorFactory& iterator_factory,
                           std::unique_ptr<ColumnReader::ColumnReaderImpl>* out);
   Status ReadColumn(int i, std::shared_ptr<Array>* out);
   Status ReadColumnChunk(int column_index, int row_group_index,
                          std::shared_ptr<Array>* out);
+  Status ReadColumnChunk(int column_index, int row_group_index,
+                         const RowSelection& row_selection, std::shared_ptr<Array>* out);
   Status GetSchema(std::shared_ptr<::arrow::Schema>* out);
   Status GetSchema(const std::vector<int>& indices,
                    std::shared_ptr<::arrow::Schema>* out);
   Status ReadRowGroup(int row_group_index, const std::vector<int>& indices,
                       std::shared_ptr<::arrow::Table>* out);
+  Status ReadRowGroup(int row_group_index, const std::vector<int>& indices,
+                      const RowSelection& row_selection,
+                      std::shared_ptr<::arrow::Table>* out);
   Status ReadTable(const std::vector<int>& indices, std::shared_ptr<Table>* table);
+  Status ReadTable(const std::vector<int>& indices, const RowFilter& filter,
+                   std::shared_ptr<Table>* table);
   Status ReadTable(std::shared_ptr<Table>* table);
+  Status EvaluateFilter(int row_group_index, const RowFilter& filter, RowSelection* out);
   Status ReadRowGroup(int i, std::shared_ptr<Table>* table);
 
   bool CheckForFlatColumn(const ColumnDescriptor* descr);
@@ -246,19 +299,57 @@ class FileReader::Impl {
 
   void set_num_threads(int num_threads) { num_threads_ = num_threads; }
 
+  void set_executor(const std::shared_ptr<Executor>& executor) { executor_ = executor; }
+
+  void set_parallel_page_decoding(bool parallel_page_decoding) {
+    parallel_page_decoding_ = parallel_page_decoding;
+  }
+
   ParquetFileReader* reader() { return reader_.get(); }
 
  private:
+  Status GetColumn(int i, const FileColumnIteratorFactory& iterator_factory,
+                   std::unique_ptr<ColumnReader>* out);
+
+  // Read the part of schema field i in one row group
+  Status ReadSchemaFieldChunk(int i, const std::vector<int>& indices,
+                              int row_group_index, std::shared_ptr<Array>* out);
+
+  // Decode ranges of the data pages of a column chunk on several threads and
+  // stitch the results. *out is left null if the column chunk cannot be split
+  Status ReadColumnChunkPages(int column_index, int row_group_index,
+                              std::shared_ptr<Array>* out);
+
+  // Compressed size of the columns of schema field i that are in indices, in
+  // one row group; the cost hint of the task reading them
+  int64_t SchemaFieldChunkSize(int i, const std::vector<int>& indices,
+                               int row_group_index);
+
+  Executor* executor() {
+    return executor_ ? executor_.get() : default_executor().get();
+  }
+
+  // Read all rows of the row group if row_selection is null
+  Status ReadRowGroupColumns(int row_group_index, const std::vector<int>& indices,
+                             const RowSelection* row_selection,
+                             std::shared_ptr<::arrow::Table>* out);
+
   MemoryPool* pool_;
   std::unique_ptr<ParquetFileReader> reader_;
 
   int num_threads_;
+  std::shared_ptr<Executor> executor_;
+  bool parallel_page_decoding_;
 };
 
 class ColumnReader::ColumnReaderImpl {
  public:
   virtual ~ColumnReaderImpl() {}
   virtual Status NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) = 0;
+  // Read the selected records, relative to the current position, and skip
+  // the others
+  virtual Status NextBatch(const RowSelection& selection,
+                           std::shared_ptr<Array>* out) = 0;
   virtual Status GetDefLevels(const int16_t** data, size_t* length) = 0;
   virtual Status GetRepLevels(const int16_t** data, size_t* length) = 0;
   virtual const std::shared_ptr<Field> field() = 0;
@@ -275,6 +366,7 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::ColumnReaderImpl {
   }
 
   Status NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) override;
+  Status NextBatch(const RowSelection& selection, std::shared_ptr<Array>* out) override;
 
   template <typename ParquetType>
   Status WrapIntoListArray(std::shared_ptr<Array>* array);
@@ -287,6 +379,14 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::ColumnReaderImpl {
  private:
   void NextRowGroup();
 
+  // Read or skip records into the record reader, advancing through the row
+  // groups as needed. Return the number of records read or skipped
+  int64_t ReadRecords(int64_t num_records);
+  int64_t SkipRecords(int64_t num_records);
+
+  // Convert the records accumulated in the record reader to an Array
+  Status TransferBatch(std::shared_ptr<Array>* out);
+
   MemoryPool* pool_;
   std::unique_ptr<FileColumnIterator> input_;
   const ColumnDescriptor* descr_;
@@ -309,11 +409,15 @@ class PARQUET_NO_EXPORT StructImpl : public ColumnReader::ColumnReaderImpl {
   }
 
   Status NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) override;
+  Status NextBatch(const RowSelection& selection, std::shared_ptr<Array>* out) override;
   Status GetDefLevels(const int16_t** data, size_t* length) override;
   Status GetRepLevels(const int16_t** data, size_t* length) override;
   const std::shared_ptr<Field> field() override { return field_; }
 
  private:
+  Status AssembleBatch(const std::vector<std::shared_ptr<Array>>& children_arrays,
+                       std::shared_ptr<Array>* out);
+
   std::vector<std::shared_ptr<ColumnReaderImpl>> children_;
   int16_t struct_def_level_;
   MemoryPool* pool_;
@@ -331,7 +435,13 @@ FileReader::FileReader(MemoryPool* pool, std::unique_ptr<ParquetFileReader> read
 FileReader::~FileReader() {}
 
 Status FileReader::Impl::GetColumn(int i, std::unique_ptr<ColumnReader>* out) {
-  std::unique_ptr<FileColumnIterator> input(new AllRowGroupsIterator(i, reader_.get()));
+  return GetColumn(i, MakeAllRowGroupsIterator, out);
+}
+
+Status FileReader::Impl::GetColumn(int i,
+                                   const FileColumnIteratorFactory& iterator_factory,
+                                   std::unique_ptr<ColumnReader>* out) {
+  std::unique_ptr<FileColumnIterator> input(iterator_factory(i, reader_.get()));
 
   std::unique_ptr<ColumnReader::ColumnReaderImpl> impl(
       new PrimitiveImpl(pool_, std::move(input)));
@@ -341,6 +451,7 @@ Status FileReader::Impl::GetColumn(int i, std::unique_ptr<ColumnReader>* out) {
 
 Status FileReader::Impl::GetReaderForNode(
     int index, const Node* node, const std::vector<int>& indices, int16_t def_level,
+    const FileColumnIteratorFactory& iterator_factory,
     std::unique_ptr<ColumnReader::ColumnReaderImpl>* out) {
   *out = nullptr;
 
@@ -353,7 +464,8 @@ Status FileReader::Impl::GetReaderForNode(
       // are supported. This currently just signals the lower level reader resolution
       // to abort
       RETURN_NOT_OK(GetReaderForNode(index, group->field(i).get(), indices,
-                                     static_cast<int16_t>(def_level + 1), &child_reader));
+                                     static_cast<int16_t>(def_level + 1),
+                                     iterator_factory, &child_reader));
       if (child_reader != nullptr) {
         children.push_back(std::move(child_reader));
       }
@@ -381,7 +493,7 @@ Status FileReader::Impl::GetReaderForNode(
     // Otherwise *out keeps the nullptr value.
     if (std::find(indices.begin(), indices.end(), column_index) != indices.end()) {
       std::unique_ptr<ColumnReader> reader;
-      RETURN_NOT_OK(GetColumn(column_index, &reader));
+      RETURN_NOT_OK(GetColumn(column_index, iterator_factory, &reader));
       *out = std::move(reader->impl_);
     }
   }
@@ -406,7 +518,8 @@ Status FileReader::Impl::ReadSchemaField(int i, const std::vector<int>& indices,
   auto node = parquet_schema->group_node()->field(i).get();
   std::unique_ptr<ColumnReader::ColumnReaderImpl> reader_impl;
 
-  RETURN_NOT_OK(GetReaderForNode(i, node, indices, 1, &reader_impl));
+  RETURN_NOT_OK(
+      GetReaderForNode(i, node, indices, 1, MakeAllRowGroupsIterator, &reader_impl));
   if (reader_impl == nullptr) {
     *out = nullptr;
     return Status::OK();
@@ -426,6 +539,44 @@ Status FileReader::Impl::ReadSchemaField(int i, const std::vector<int>& indices,
   return reader->NextBatch(records_to_read, out);
 }
 
+Status FileReader::Impl::ReadSchemaFieldChunk(int i, const std::vector<int>& indices,
+                                              int row_group_index,
+                                              std::shared_ptr<Array>* out) {
+  auto parquet_schema = reader_->metadata()->schema();
+
+  auto node = parquet_schema->group_node()->field(i).get();
+  std::unique_ptr<ColumnReader::ColumnReaderImpl> reader_impl;
+
+  auto iterator_factory = [row_group_index](int column_index,
+                                            ParquetFileReader* reader) {
+    return new SingleRowGroupIterator(column_index, row_group_index, reader);
+  };
+  RETURN_NOT_OK(GetReaderForNode(i, node, indices, 1, iterator_factory, &reader_impl));
+  if (reader_impl == nullptr) {
+    *out = nullptr;
+    return Status::OK();
+  }
+
+  ColumnReader reader(std::move(reader_impl));
+  return reader.NextBatch(reader_->metadata()->RowGroup(row_group_index)->num_rows(),
+                          out);
+}
+
+int64_t FileReader::Impl::SchemaFieldChunkSize(int i, const std::vector<int>& indices,
+                                               int row_group_index) {
+  const SchemaDescriptor* parquet_schema = reader_->metadata()->schema();
+  auto rg_metadata = reader_->metadata()->RowGroup(row_group_index);
+  const Node* field = parquet_schema->group_node()->field(i).get();
+
+  int64_t size = 0;
+  for (int column_index : indices) {
+    if (parquet_schema->GetColumnRoot(column_index) == field) {
+      size += rg_metadata->ColumnChunk(column_index)->total_compressed_size();
+    }
+  }
+  return size;
+}
+
 Status FileReader::Impl::ReadColumn(int i, std::shared_ptr<Array>* out) {
   std::unique_ptr<ColumnReader> flat_column_reader;
   RETURN_NOT_OK(GetColumn(i, &flat_column_reader));
@@ -447,6 +598,13 @@ Status FileReader::Impl::GetSchema(const std::vector<int>& indices,
 
 Status FileReader::Impl::ReadColumnChunk(int column_index, int row_group_index,
                                          std::shared_ptr<Array>* out) {
+  if (parallel_page_decoding_ && num_threads_ > 1) {
+    RETURN_NOT_OK(ReadColumnChunkPages(column_index, row_group_index, out));
+    if (*out != nullptr) {
+      return Status::OK();
+    }
+  }
+
   auto rg_metadata = reader_->metadata()->RowGroup(row_group_index);
   int64_t records_to_read = rg_metadata->ColumnChunk(column_index)->num_values();
 
@@ -463,25 +621,221 @@ Status FileReader::Impl::ReadColumnChunk(int column_index, int row_group_index,
   return Status::OK();
 }
 
+Status FileReader::Impl::ReadColumnChunk(int column_index, int row_group_index,
+                                         const RowSelection& row_selection,
+                                         std::shared_ptr<Array>* out) {
+  std::unique_ptr<FileColumnIterator> input(
+      new SingleRowGroupIterator(column_index, row_group_index, reader_.get()));
+
+  PrimitiveImpl impl(pool_, std::move(input));
+  return impl.NextBatch(row_selection, out);
+}
+
+Status FileReader::Impl::ReadColumnChunkPages(int column_index, int row_group_index,
+                                              std::shared_ptr<Array>* out) {
+  *out = nullptr;
+
+  // Without repetition, each value is a row and the ranges hold whole records
+  const ColumnDescriptor* descr = reader_->metadata()->schema()->Column(column_index);
+  if (descr->max_repetition_level() > 0) {
+    return Status::OK();
+  }
+
+  // The ranges decode their values in place into the output, so only values
+  // that the array holds as decoded are supported: fixed-width physical types
+  // whose Arrow type has the same width, as for the zero-copy TransferFunctor
+  std::shared_ptr<Field> field;
+  RETURN_NOT_OK(NodeToField(*descr->schema_node(), &field));
+  int64_t byte_width = 0;
+  switch (descr->physical_type()) {
+    case ::parquet::Type::INT32:
+    case ::parquet::Type::INT64:
+    case ::parquet::Type::FLOAT:
+    case ::parquet::Type::DOUBLE:
+      byte_width = GetTypeByteSize(descr->physical_type());
+      break;
+    default:
+      return Status::OK();
+  }
+  auto fixed_width_type =
+      dynamic_cast<const ::arrow::FixedWidthType*>(field->type().get());
+  if (fixed_width_type == nullptr || fixed_width_type->bit_width() != byte_width * 8) {
+    return Status::OK();
+  }
+
+  std::shared_ptr<::parquet::RowGroupReader> row_group =
+      reader_->RowGroup(row_group_index);
+  const int64_t num_rows = row_group->metadata()->num_rows();
+  const std::vector<PageLocation> pages = row_group->GetColumnPageLocations(column_index);
+  const int num_pages = static_cast<int>(pages.size());
+  if (num_pages < 2) {
+    return Status::OK();
+  }
+
+  // Split the pages into ranges of about the same number of rows
+  const int max_ranges = std::min(num_threads_, num_pages);
+  std::vector<int> range_begins = {0};
+  for (int page = 1; page < num_pages; ++page) {
+    const int range = static_cast<int>(range_begins.size());
+    if (range < max_ranges &&
+        pages[page].first_row_index >= num_rows * range / max_ranges) {
+      range_begins.push_back(page);
+    }
+  }
+  range_begins.push_back(num_pages);
+  const int num_ranges = static_cast<int>(range_begins.size()) - 1;
+
+  auto RangeRowStart = [&pages, &range_begins, num_pages, num_rows](int range) {
+    const int page = range_begins[range];
+    return page == num_pages ? num_rows : pages[page].first_row_index;
+  };
+
+  // The bytes of the validity bitmap that only hold bits of the rows of range
+  // are [begin / 8, end / 8). Neighbouring ranges may share the others
+  auto RangeBitmapBytes = [&RangeRowStart](int range, int64_t* begin, int64_t* end) {
+    const int64_t row_start = RangeRowStart(range);
+    const int64_t row_end = RangeRowStart(range + 1);
+    *begin = std::min((row_start + 7) / 8 * 8, row_end);
+    *end = std::max(row_end / 8 * 8, *begin);
+  };
+
+  // Decode the dictionary page once, the ranges share it read-only
+  std::shared_ptr<RecordReader> dictionary_reader = RecordReader::Make(descr, pool_);
+  dictionary_reader->SetPageReader(
+      row_group->GetColumnDictionaryPageReader(column_index, pages));
+  dictionary_reader->ReadRecords(1);
+
+  std::shared_ptr<Buffer> values;
+  RETURN_NOT_OK(::arrow::AllocateBuffer(pool_, num_rows * byte_width, &values));
+  const bool nullable = dictionary_reader->nullable_values();
+  std::shared_ptr<Buffer> null_bitmap;
+  if (nullable) {
+    RETURN_NOT_OK(::arrow::AllocateBuffer(pool_, BytesForBits(num_rows), &null_bitmap));
+  }
+  std::vector<std::shared_ptr<PoolBuffer>> range_bitmaps(num_ranges);
+  std::vector<int64_t> range_null_counts(num_ranges, 0);
+
+  auto DecodeRangeFunc = [&](int range) {
+    const int64_t row_start = RangeRowStart(range);
+    const int64_t range_rows = RangeRowStart(range + 1) - row_start;
+    try {
+      std::shared_ptr<RecordReader> record_reader = RecordReader::Make(descr, pool_);
+      record_reader->SetPageReader(row_group->GetColumnPageReader(
+          column_index, pages, range_begins[range], range_begins[range + 1]));
+      record_reader->ShareDictionary(*dictionary_reader);
+      // Each range owns a disjoint slice of the values buffer
+      record_reader->SetValuesOutput(values->mutable_data() + row_start * byte_width);
+      record_reader->Reserve(range_rows);
+
+      const int64_t rows_read = record_reader->ReadRecords(range_rows);
+      if (rows_read != range_rows) {
+        std::stringstream ss;
+        ss << "Pages of column " << column_index << " starting at row " << row_start
+           << " hold " << rows_read << " rows, expected " << range_rows;
+        return Status::IOError(ss.str());
+      }
+      range_null_counts[range] = record_reader->null_count();
+
+      // Copy the validity bits of the bytes of the bitmap that the range owns,
+      // the bits in bytes shared with a neighbouring range are left for later
+      if (nullable) {
+        range_bitmaps[range] = record_reader->ReleaseIsValid();
+        int64_t bytes_begin, bytes_end;
+        RangeBitmapBytes(range, &bytes_begin, &bytes_end);
+        ::parquet::internal::CopyBitmap(range_bitmaps[range]->data(),
+                                        bytes_begin - row_start, bytes_end - bytes_begin,
+                                        null_bitmap->mutable_data(), bytes_begin);
+      }
+    } catch (const ::parquet::ParquetException& e) {
+      return Status::IOError(e.what());
+    }
+    return Status::OK();
+  };
+
+  std::vector<int64_t> range_sizes(num_ranges, 0);
+  for (int range = 0; range < num_ranges; ++range) {
+    for (int page = range_begins[range]; page < range_begins[range + 1]; ++page) {
+      range_sizes[range] += pages[page].compressed_page_size;
+    }
+  }
+  RETURN_NOT_OK(
+      executor()->ParallelFor(num_ranges, num_ranges, DecodeRangeFunc, range_sizes));
+
+  // At most 7 bits on each side of each range remain, in bytes that
+  // neighbouring ranges share
+  int64_t null_count = 0;
+  for (int range = 0; range < num_ranges; ++range) {
+    null_count += range_null_counts[range];
+    if (nullable) {
+      const int64_t row_start = RangeRowStart(range);
+      const int64_t row_end = RangeRowStart(range + 1);
+      int64_t bytes_begin, bytes_end;
+      RangeBitmapBytes(range, &bytes_begin, &bytes_end);
+      const uint8_t* range_bitmap = range_bitmaps[range]->data();
+      ::parquet::internal::CopyBitmap(range_bitmap, 0, bytes_begin - row_start,
+                                      null_bitmap->mutable_data(), row_start);
+      ::parquet::internal::CopyBitmap(range_bitmap, bytes_end - row_start,
+                                      row_end - bytes_end, null_bitmap->mutable_data(),
+                                      bytes_end);
+    }
+  }
+  if (null_count == 0) {
+    null_bitmap.reset();
+  }
+
+  *out = ::arrow::MakeArray(::arrow::ArrayData::Make(
+      field->type(), num_rows, {null_bitmap, values}, null_count));
+  return Status::OK();
+}
+
 Status FileReader::Impl::ReadRowGroup(int row_group_index,
                                       const std::vector<int>& indices,
                                       std::shared_ptr<::arrow::Table>* out) {
+  return ReadRowGroupColumns(row_group_index, indices, nullptr, out);
+}
+
+Status FileReader::Impl::ReadRowGroup(int row_group_index,
+                                      const std::vector<int>& indices,
+                                      const RowSelection& row_selection,
+                                      std::shared_ptr<::arrow::Table>* out) {
+  const int64_t num_rows = reader_->metadata()->RowGroup(row_group_index)->num_rows();
+  if (row_selection.end() > num_rows) {
+    std::stringstream ss;
+    ss << "Row selection ends at row " << row_selection.end() << " but row group "
+       << row_group_index << " only has " << num_rows << " rows";
+    return Status::Invalid(ss.str());
+  }
+  return ReadRowGroupColumns(row_group_index, indices, &row_selection, out);
+}
+
+Status FileReader::Impl::ReadRowGroupColumns(int row_group_index,
+                                             const std::vector<int>& indices,
+                                             const RowSelection* row_selection,
+                                             std::shared_ptr<::arrow::Table>* out) {
   std::shared_ptr<::arrow::Schema> schema;
   RETURN_NOT_OK(GetSchema(indices, &schema));
 
   auto rg_metadata = reader_->metadata()->RowGroup(row_group_index);
 
   int num_columns = static_cast<int>(indices.size());
+  // With parallel page decoding, the pages of each column chunk are decoded by
+  // tasks nested in those of the columns, on the same executor
   int nthreads = std::min<int>(num_threads_, num_columns);
   std::vector<std::shared_ptr<Column>> columns(num_columns);
 
   // TODO(wesm): Refactor to share more code with ReadTable
 
-  auto ReadColumnFunc = [&indices, &row_group_index, &schema, &columns, this](int i) {
+  auto ReadColumnFunc = [&indices, &row_group_index, &row_selection, &schema, &columns,
+                         this](int i) {
     int column_index = indices[i];
 
     std::shared_ptr<Array> array;
-    RETURN_NOT_OK(ReadColumnChunk(column_index, row_group_index, &array));
+    if (row_selection == nullptr) {
+      RETURN_NOT_OK(ReadColumnChunk(column_index, row_group_index, &array));
+    } else {
+      RETURN_NOT_OK(
+          ReadColumnChunk(column_index, row_group_index, *row_selection, &array));
+    }
     columns[i] = std::make_shared<Column>(schema->field(i), array);
     return Status::OK();
   };
@@ -491,7 +845,12 @@ Status FileReader::Impl::ReadRowGroup(int row_group_index,
       RETURN_NOT_OK(ReadColumnFunc(i));
     }
   } else {
-    RETURN_NOT_OK(ParallelFor(nthreads, num_columns, ReadColumnFunc));
+    std::vector<int64_t> column_sizes(num_columns);
+    for (int i = 0; i < num_columns; i++) {
+      column_sizes[i] = rg_metadata->ColumnChunk(indices[i])->total_compressed_size();
+    }
+    RETURN_NOT_OK(
+        executor()->ParallelFor(nthreads, num_columns, ReadColumnFunc, column_sizes));
   }
 
   *out = Table::Make(schema, columns);
@@ -512,6 +871,42 @@ Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
   }
 
   std::vector<std::shared_ptr<Column>> columns(field_indices.size());
+  int num_fields = static_cast<int>(field_indices.size());
+
+  // With several row groups, every (field, row group) pair is read by a task of
+  // its own, so that narrow projections also use all threads. Each row group
+  // then becomes one chunk of the columns
+  const int num_rg = num_row_groups();
+  if (num_threads_ > 1 && num_rg > 1 && num_fields > 0) {
+    const int num_tasks = num_fields * num_rg;
+    std::vector<::arrow::ArrayVector> chunks(num_fields, ::arrow::ArrayVector(num_rg));
+
+    // Tasks are numbered row group by row group, so that the concurrently read
+    // column chunks are close to each other in the file
+    auto ReadChunkFunc = [&indices, &field_indices, &chunks, num_fields,
+                          this](int task) {
+      const int i = task % num_fields;
+      const int row_group_index = task / num_fields;
+      return ReadSchemaFieldChunk(field_indices[i], indices, row_group_index,
+                                  &chunks[i][row_group_index]);
+    };
+    std::vector<int64_t> chunk_sizes(num_tasks);
+    for (int task = 0; task < num_tasks; ++task) {
+      chunk_sizes[task] = SchemaFieldChunkSize(field_indices[task % num_fields], indices,
+                                               task / num_fields);
+    }
+    RETURN_NOT_OK(executor()->ParallelFor(std::min(num_threads_, num_tasks), num_tasks,
+                                          ReadChunkFunc, chunk_sizes));
+
+    for (int i = 0; i < num_fields; i++) {
+      columns[i] = std::make_shared<Column>(schema->field(i), chunks[i]);
+    }
+    std::shared_ptr<Table> table = Table::Make(schema, columns);
+    RETURN_NOT_OK(table->Validate());
+    *out = table;
+    return Status::OK();
+  }
+
   auto ReadColumnFunc = [&indices, &field_indices, &schema, &columns, this](int i) {
     std::shared_ptr<Array> array;
     RETURN_NOT_OK(ReadSchemaField(field_indices[i], indices, &array));
@@ -519,14 +914,20 @@ Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
     return Status::OK();
   };
 
-  int num_fields = static_cast<int>(field_indices.size());
   int nthreads = std::min<int>(num_threads_, num_fields);
   if (nthreads == 1) {
     for (int i = 0; i < num_fields; i++) {
       RETURN_NOT_OK(ReadColumnFunc(i));
     }
   } else {
-    RETURN_NOT_OK(ParallelFor(nthreads, num_fields, ReadColumnFunc));
+    std::vector<int64_t> field_sizes(num_fields, 0);
+    for (int i = 0; i < num_fields; i++) {
+      for (int j = 0; j < num_rg; j++) {
+        field_sizes[i] += SchemaFieldChunkSize(field_indices[i], indices, j);
+      }
+    }
+    RETURN_NOT_OK(
+        executor()->ParallelFor(nthreads, num_fields, ReadColumnFunc, field_sizes));
   }
 
   std::shared_ptr<Table> table = Table::Make(schema, columns);
@@ -535,6 +936,51 @@ Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
   return Status::OK();
 }
 
+Status FileReader::Impl::EvaluateFilter(int row_group_index, const RowFilter& filter,
+                                        RowSelection* out) {
+  if (row_group_index < 0 || row_group_index >= num_row_groups()) {
+    std::stringstream ss;
+    ss << "Row group index " << row_group_index << " is out of bounds, the file has "
+       << num_row_groups() << " row groups";
+    return Status::Invalid(ss.str());
+  }
+  std::shared_ptr<::parquet::RowGroupReader> row_group =
+      reader_->RowGroup(row_group_index);
+  *out = filter.Evaluate(row_group.get());
+  return Status::OK();
+}
+
+Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
+                                   const RowFilter& filter, std::shared_ptr<Table>* out) {
+  // Evaluate the predicates of each row group before decoding any of the other
+  // columns, so that these are only decoded for the selected rows
+  std::vector<std::shared_ptr<Table>> tables;
+  for (int i = 0; i < num_row_groups(); ++i) {
+    RowSelection selection;
+    RETURN_NOT_OK(EvaluateFilter(i, filter, &selection));
+    if (selection.empty()) {
+      continue;
+    }
+    std::shared_ptr<Table> table;
+    RETURN_NOT_OK(ReadRowGroup(i, indices, selection, &table));
+    tables.push_back(table);
+  }
+
+  if (tables.empty()) {
+    // No row satisfies the filter: return an empty table with the right schema
+    if (num_row_groups() == 0) {
+      return ReadTable(indices, out);
+    }
+    return ReadRowGroup(0, indices, RowSelection(), out);
+  }
+  if (tables.size() == 1) {
+    *out = tables[0];
+    return Status::OK();
+  }
+  // The row groups become chunks of the columns, without copying them
+  return ::arrow::ConcatenateTables(tables, out);
+}
+
 Status FileReader::Impl::ReadTable(std::shared_ptr<Table>* table) {
   std::vector<int> indices(reader_->metadata()->num_columns());
 
@@ -597,6 +1043,32 @@ Status FileReader::ReadSchemaField(int i, std::shared_ptr<Array>* out) {
   }
 }
 
+static Status MakeRecordBatchReader(FileReader* reader,
+                                    const std::vector<int>& row_group_indices,
+                                    const std::vector<int>& column_indices,
+                                    const std::vector<RowSelection>& row_selections,
+                                    const RowFilter& filter,
+                                    std::shared_ptr<RecordBatchReader>* out) {
+  // column indicies check
+  std::shared_ptr<::arrow::Schema> schema;
+  RETURN_NOT_OK(reader->GetSchema(column_indices, &schema));
+
+  // row group indices check
+  int max_num = reader->num_row_groups();
+  for (auto row_group_index : row_group_indices) {
+    if (row_group_index < 0 || row_group_index >= max_num) {
+      std::ostringstream ss;
+      ss << "Some index in row_group_indices is " << row_group_index
+         << ", which is either < 0 or >= num_row_groups(" << max_num << ")";
+      return Status::Invalid(ss.str());
+    }
+  }
+
+  *out = std::make_shared<RowGroupRecordBatchReader>(
+      row_group_indices, column_indices, row_selections, filter, schema, reader);
+  return Status::OK();
+}
+
 Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indices,
                                         std::shared_ptr<RecordBatchReader>* out) {
   std::vector<int> indices(impl_->num_columns());
@@ -611,24 +1083,30 @@ Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indice
 Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indices,
                                         const std::vector<int>& column_indices,
                                         std::shared_ptr<RecordBatchReader>* out) {
-  // column indicies check
-  std::shared_ptr<::arrow::Schema> schema;
-  RETURN_NOT_OK(GetSchema(column_indices, &schema));
+  return GetRecordBatchReader(row_group_indices, column_indices, {}, out);
+}
 
-  // row group indices check
-  int max_num = num_row_groups();
-  for (auto row_group_index : row_group_indices) {
-    if (row_group_index < 0 || row_group_index >= max_num) {
-      std::ostringstream ss;
-      ss << "Some index in row_group_indices is " << row_group_index
-         << ", which is either < 0 or >= num_row_groups(" << max_num << ")";
-      return Status::Invalid(ss.str());
-    }
+Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indices,
+                                        const std::vector<int>& column_indices,
+                                        const std::vector<RowSelection>& row_selections,
+                                        std::shared_ptr<RecordBatchReader>* out) {
+  if (!row_selections.empty() && row_selections.size() != row_group_indices.size()) {
+    std::ostringstream ss;
+    ss << "Got " << row_selections.size() << " row selections for "
+       << row_group_indices.size() << " row groups";
+    return Status::Invalid(ss.str());
   }
 
-  *out = std::make_shared<RowGroupRecordBatchReader>(row_group_indices, column_indices,
-                                                     schema, this);
-  return Status::OK();
+  return MakeRecordBatchReader(this, row_group_indices, column_indices, row_selections,
+                               RowFilter(), out);
+}
+
+Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indices,
+                                        const std::vector<int>& column_indices,
+                                        const RowFilter& filter,
+                                        std::shared_ptr<RecordBatchReader>* out) {
+  return MakeRecordBatchReader(this, row_group_indices, column_indices, {}, filter,
+                               out);
 }
 
 Status FileReader::ReadTable(std::shared_ptr<Table>* out) {
@@ -648,6 +1126,23 @@ Status FileReader::ReadTable(const std::vector<int>& indices,
   }
 }
 
+Status FileReader::ReadTable(const std::vector<int>& indices, const RowFilter& filter,
+                             std::shared_ptr<Table>* out) {
+  try {
+    return impl_->ReadTable(indices, filter, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
+Status FileReader::EvaluateFilter(int i, const RowFilter& filter, RowSelection* out) {
+  try {
+    return impl_->EvaluateFilter(i, filter, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
 Status FileReader::ReadRowGroup(int i, std::shared_ptr<Table>* out) {
   try {
     return impl_->ReadRowGroup(i, out);
@@ -665,6 +1160,16 @@ Status FileReader::ReadRowGroup(int i, const std::vector<int>& indices,
   }
 }
 
+Status FileReader::ReadRowGroup(int i, const std::vector<int>& indices,
+                                const RowSelection& row_selection,
+                                std::shared_ptr<Table>* out) {
+  try {
+    return impl_->ReadRowGroup(i, indices, row_selection, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
 std::shared_ptr<RowGroupReader> FileReader::RowGroup(int row_group_index) {
   return std::shared_ptr<RowGroupReader>(
       new RowGroupReader(impl_.get(), row_group_index));
@@ -674,6 +1179,14 @@ int FileReader::num_row_groups() const { return impl_->num_row_groups(); }
 
 void FileReader::set_num_threads(int num_threads) { impl_->set_num_threads(num_threads); }
 
+void FileReader::set_executor(const std::shared_ptr<Executor>& executor) {
+  impl_->set_executor(executor);
+}
+
+void FileReader::set_parallel_page_decoding(bool parallel_page_decoding) {
+  impl_->set_parallel_page_decoding(parallel_page_decoding);
+}
+
 Status FileReader::ScanContents(std::vector<int> columns, const int32_t column_batch_size,
                                 int64_t* num_rows) {
   try {
@@ -703,8 +1216,6 @@ Status PrimitiveImpl::WrapIntoListArray(std::shared_ptr<Array>* array) {
   if (descr_->max_repetition_level() > 0) {
     // Walk downwards to extract nullability
     std::vector<bool> nullable;
-    std::vector<std::shared_ptr<::arrow::Int32Builder>> offset_builders;
-    std::vector<std::shared_ptr<::arrow::BooleanBuilder>> valid_bits_builders;
     nullable.push_back(current_field->nullable());
     while (current_field->type()->num_children() > 0) {
       if (current_field->type()->num_children() > 1) {
@@ -717,14 +1228,10 @@ Status PrimitiveImpl::WrapIntoListArray(std::shared_ptr<Array>* array) {
         }
         current_field = current_field->type()->child(0);
       }
-      offset_builders.emplace_back(
-          std::make_shared<::arrow::Int32Builder>(::arrow::int32(), pool_));
-      valid_bits_builders.emplace_back(
-          std::make_shared<::arrow::BooleanBuilder>(::arrow::boolean(), pool_));
       nullable.push_back(current_field->nullable());
     }
 
-    int64_t list_depth = offset_builders.size();
+    const int64_t list_depth = static_cast<int64_t>(nullable.size()) - 1;
     // This describes the minimal definition that describes a level that
     // reflects a value in the primitive values array.
     int16_t values_def_level = descr_->max_definition_level();
@@ -734,73 +1241,29 @@ Status PrimitiveImpl::WrapIntoListArray(std::shared_ptr<Array>* array) {
 
     // The definition levels that are needed so that a list is declared
     // as empty and not null.
-    std::vector<int16_t> empty_def_level(list_depth);
+    std::vector<ListLevel> list_levels(list_depth);
     int def_level = 0;
     for (int i = 0; i < list_depth; i++) {
       if (nullable[i]) {
         def_level++;
       }
-      empty_def_level[i] = static_cast<int16_t>(def_level);
+      list_levels[i].nullable = nullable[i];
+      list_levels[i].empty_def_level = static_cast<int16_t>(def_level);
       def_level++;
     }
 
-    int32_t values_offset = 0;
-    std::vector<int64_t> null_counts(list_depth, 0);
-    for (int64_t i = 0; i < total_levels_read; i++) {
-      int16_t rep_level = rep_levels[i];
-      if (rep_level < descr_->max_repetition_level()) {
-        for (int64_t j = rep_level; j < list_depth; j++) {
-          if (j == (list_depth - 1)) {
-            RETURN_NOT_OK(offset_builders[j]->Append(values_offset));
-          } else {
-            RETURN_NOT_OK(offset_builders[j]->Append(
-                static_cast<int32_t>(offset_builders[j + 1]->length())));
-          }
-
-          if (((empty_def_level[j] - 1) == def_levels[i]) && (nullable[j])) {
-            RETURN_NOT_OK(valid_bits_builders[j]->Append(false));
-            null_counts[j]++;
-            break;
-          } else {
-            RETURN_NOT_OK(valid_bits_builders[j]->Append(true));
-            if (empty_def_level[j] == def_levels[i]) {
-              break;
-            }
-          }
-        }
-      }
-      if (def_levels[i] >= values_def_level) {
-        values_offset++;
-      }
-    }
-    // Add the final offset to all lists
-    for (int64_t j = 0; j < list_depth; j++) {
-      if (j == (list_depth - 1)) {
-        RETURN_NOT_OK(offset_builders[j]->Append(values_offset));
-      } else {
-        RETURN_NOT_OK(offset_builders[j]->Append(
-            static_cast<int32_t>(offset_builders[j + 1]->length())));
-      }
-    }
-
-    std::vector<std::shared_ptr<Buffer>> offsets;
-    std::vector<std::shared_ptr<Buffer>> valid_bits;
-    std::vector<int64_t> list_lengths;
-    for (int64_t j = 0; j < list_depth; j++) {
-      list_lengths.push_back(offset_builders[j]->length() - 1);
-      std::shared_ptr<Array> array;
-      RETURN_NOT_OK(offset_builders[j]->Finish(&array));
-      offsets.emplace_back(std::static_pointer_cast<Int32Array>(array)->values());
-      RETURN_NOT_OK(valid_bits_builders[j]->Finish(&array));
-      valid_bits.emplace_back(std::static_pointer_cast<BooleanArray>(array)->values());
-    }
+    RETURN_NOT_OK(::parquet::internal::LevelsToListOffsets(
+        def_levels, rep_levels, total_levels_read, values_def_level, pool_,
+        &list_levels));
 
     std::shared_ptr<Array> output(*array);
     for (int64_t j = list_depth - 1; j >= 0; j--) {
       auto list_type =
           ::arrow::list(::arrow::field("item", output->type(), nullable[j + 1]));
-      output = std::make_shared<::arrow::ListArray>(
-          list_type, list_lengths[j], offsets[j], output, valid_bits[j], null_counts[j]);
+      const ListLevel& level = list_levels[j];
+      output = std::make_shared<::arrow::ListArray>(list_type, level.length,
+                                                    level.offsets, output,
+                                                    level.valid_bits, level.null_count);
     }
     *array = output;
   }
@@ -1234,26 +1697,71 @@ struct TransferFunctor<::arrow::Decimal128Type, Int64Type> {
     TRANSFER_DATA(ArrowType, ParquetType);          \
   } break;
 
+int64_t PrimitiveImpl::ReadRecords(int64_t num_records) {
+  int64_t records_read = 0;
+  while (records_read < num_records) {
+    if (!record_reader_->HasMoreData()) {
+      break;
+    }
+    int64_t batch_read = record_reader_->ReadRecords(num_records - records_read);
+    records_read += batch_read;
+    if (batch_read == 0) {
+      NextRowGroup();
+    }
+  }
+  return records_read;
+}
+
+int64_t PrimitiveImpl::SkipRecords(int64_t num_records) {
+  int64_t records_skipped = 0;
+  while (records_skipped < num_records) {
+    if (!record_reader_->HasMoreData()) {
+      break;
+    }
+    int64_t batch_skipped = record_reader_->SkipRecords(num_records - records_skipped);
+    records_skipped += batch_skipped;
+    if (batch_skipped == 0) {
+      NextRowGroup();
+    }
+  }
+  return records_skipped;
+}
+
 Status PrimitiveImpl::NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) {
   try {
     // Pre-allocation gives much better performance for flat columns
     record_reader_->Reserve(records_to_read);
 
     record_reader_->Reset();
-    while (records_to_read > 0) {
-      if (!record_reader_->HasMoreData()) {
-        break;
-      }
-      int64_t records_read = record_reader_->ReadRecords(records_to_read);
-      records_to_read -= records_read;
-      if (records_read == 0) {
-        NextRowGroup();
+    ReadRecords(records_to_read);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+  return TransferBatch(out);
+}
+
+Status PrimitiveImpl::NextBatch(const RowSelection& selection,
+                                std::shared_ptr<Array>* out) {
+  try {
+    record_reader_->Reserve(selection.num_rows_selected());
+
+    record_reader_->Reset();
+    int64_t position = 0;
+    for (const RowSelection::Range& range : selection.ranges()) {
+      // The unselected records are skipped inside the record reader, so they
+      // are never decoded into the output
+      if (range.offset > position) {
+        position += SkipRecords(range.offset - position);
       }
+      position += ReadRecords(range.length);
     }
   } catch (const ::parquet::ParquetException& e) {
     return ::arrow::Status::IOError(e.what());
   }
+  return TransferBatch(out);
+}
 
+Status PrimitiveImpl::TransferBatch(std::shared_ptr<Array>* out) {
   switch (field_->type()->id()) {
     TRANSFER_CASE(BOOL, ::arrow::BooleanType, BooleanType)
     TRANSFER_CASE(UINT8, ::arrow::UInt8Type, Int32Type)
@@ -1325,13 +1833,15 @@ void PrimitiveImpl::NextRowGroup() {
 
 Status PrimitiveImpl::GetDefLevels(const int16_t** data, size_t* length) {
   *data = record_reader_->def_levels();
-  *length = record_reader_->levels_written();
+  // Levels past levels_position() belong to records that are not part of the
+  // current batch
+  *length = record_reader_->levels_position();
   return Status::OK();
 }
 
 Status PrimitiveImpl::GetRepLevels(const int16_t** data, size_t* length) {
   *data = record_reader_->rep_levels();
-  *length = record_reader_->levels_written();
+  *length = record_reader_->levels_position();
   return Status::OK();
 }
 
@@ -1430,8 +1940,6 @@ Status StructImpl::GetRepLevels(const int16_t** data, size_t* length) {
 
 Status StructImpl::NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) {
   std::vector<std::shared_ptr<Array>> children_arrays;
-  std::shared_ptr<Buffer> null_bitmap;
-  int64_t null_count;
 
   // Gather children arrays and def levels
   for (auto& child : children_) {
@@ -1440,6 +1948,26 @@ Status StructImpl::NextBatch(int64_t records_to_read, std::shared_ptr<Array>* ou
     RETURN_NOT_OK(child->NextBatch(records_to_read, &child_array));
     children_arrays.push_back(child_array);
   }
+  return AssembleBatch(children_arrays, out);
+}
+
+Status StructImpl::NextBatch(const RowSelection& selection, std::shared_ptr<Array>* out) {
+  std::vector<std::shared_ptr<Array>> children_arrays;
+
+  for (auto& child : children_) {
+    std::shared_ptr<Array> child_array;
+
+    RETURN_NOT_OK(child->NextBatch(selection, &child_array));
+    children_arrays.push_back(child_array);
+  }
+  return AssembleBatch(children_arrays, out);
+}
+
+Status StructImpl::AssembleBatch(
+    const std::vector<std::shared_ptr<Array>>& children_arrays,
+    std::shared_ptr<Array>* out) {
+  std::shared_ptr<Buffer> null_bitmap;
+  int64_t null_count;
 
   RETURN_NOT_OK(DefLevelsToNullArray(&null_bitmap, &null_count));
 
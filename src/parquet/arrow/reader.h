@@ -23,6 +23,7 @@
 
 #include "parquet/api/reader.h"
 #include "parquet/api/schema.h"
+#include "parquet/util/executor.h"
 
 #include "arrow/io/interfaces.h"
 
@@ -169,19 +170,73 @@ class PARQUET_EXPORT FileReader {
                                        const std::vector<int>& column_indices,
                                        std::shared_ptr<::arrow::RecordBatchReader>* out);
 
-  // Read a table of columns into a Table
+  /// \brief Return a RecordBatchReader of row groups selected from row_group_indices,
+  ///     whose columns are selected by column_indices, yielding only the rows of
+  ///     each row group selected by the corresponding entry of row_selections.
+  ///     Unselected rows are skipped without being decoded and row groups with an
+  ///     empty selection are not read. An empty row_selections reads all rows
+  /// \returns error Status if either row_group_indices or column_indices contains invalid
+  ///    index, or row_selections does not have one entry per row group
+  ::arrow::Status GetRecordBatchReader(const std::vector<int>& row_group_indices,
+                                       const std::vector<int>& column_indices,
+                                       const std::vector<RowSelection>& row_selections,
+                                       std::shared_ptr<::arrow::RecordBatchReader>* out);
+
+  /// \brief Return a RecordBatchReader of row groups selected from row_group_indices,
+  ///     whose columns are selected by column_indices, yielding only the rows that
+  ///     satisfy the filter. Before a row group is read, its predicate columns are
+  ///     evaluated into a RowSelection as in EvaluateFilter
+  /// \returns error Status if either row_group_indices or column_indices contains invalid
+  ///    index
+  ::arrow::Status GetRecordBatchReader(const std::vector<int>& row_group_indices,
+                                       const std::vector<int>& column_indices,
+                                       const RowFilter& filter,
+                                       std::shared_ptr<::arrow::RecordBatchReader>* out);
+
+  // Read a table of columns into a Table.
+  //
+  // The chunk layout of the columns depends on the number of threads (see
+  // set_num_threads): with 1 thread, or if the file has a single row group,
+  // each column is one chunk. With more threads and several row groups, each
+  // column has one chunk per row group, so that the row groups are read
+  // concurrently and not copied. The values are the same either way
   ::arrow::Status ReadTable(std::shared_ptr<::arrow::Table>* out);
 
   // Read a table of columns into a Table. Read only the indicated column
-  // indices (relative to the schema)
+  // indices (relative to the schema). Chunked as the above
+  ::arrow::Status ReadTable(const std::vector<int>& column_indices,
+                            std::shared_ptr<::arrow::Table>* out);
+
+  /// \brief Read only the rows that satisfy the filter, in two phases (late
+  ///     materialization). For each row group, the predicate columns are read
+  ///     first and evaluated into a RowSelection; then the indicated columns are
+  ///     decoded for the selected rows only. Pages without any selected row are
+  ///     skipped and row groups without any are not read at all. The columns
+  ///     have one chunk per row group with selected rows, whatever the number
+  ///     of threads
   ::arrow::Status ReadTable(const std::vector<int>& column_indices,
+                            const RowFilter& filter,
                             std::shared_ptr<::arrow::Table>* out);
 
+  /// \brief Evaluate the filter on row group i, reading only its predicate
+  ///     columns. The result can be passed to ReadRowGroup or
+  ///     GetRecordBatchReader
+  ::arrow::Status EvaluateFilter(int i, const RowFilter& filter, RowSelection* out);
+
   ::arrow::Status ReadRowGroup(int i, const std::vector<int>& column_indices,
                                std::shared_ptr<::arrow::Table>* out);
 
   ::arrow::Status ReadRowGroup(int i, std::shared_ptr<::arrow::Table>* out);
 
+  /// \brief Read only the rows of row group i selected by row_selection. The
+  ///     unselected rows are skipped inside the column readers, using the
+  ///     repetition / definition levels and the value decoders, rather than
+  ///     being read and filtered afterwards
+  /// \returns error Status if the selection extends past the end of the row group
+  ::arrow::Status ReadRowGroup(int i, const std::vector<int>& column_indices,
+                               const RowSelection& row_selection,
+                               std::shared_ptr<::arrow::Table>* out);
+
   /// \brief Scan file contents with one thread, return number of rows
   ::arrow::Status ScanContents(std::vector<int> columns, const int32_t column_batch_size,
                                int64_t* num_rows);
@@ -195,9 +250,30 @@ class PARQUET_EXPORT FileReader {
   const ParquetFileReader* parquet_reader() const;
 
   /// Set the number of threads to use during reads of multiple columns. By
-  /// default only 1 thread is used
+  /// default only 1 thread is used. With more than 1 thread, ReadTable reads
+  /// the column chunks of all row groups concurrently and returns one chunk per
+  /// row group in each column, rather than one chunk per column
   void set_num_threads(int num_threads);
 
+  /// Run the reads of set_num_threads on the threads of executor instead of
+  /// default_executor(). The number of threads then caps the column chunks
+  /// read at once by this reader, while the executor bounds the threads
+  /// shared by all the readers and writers using it
+  void set_executor(const std::shared_ptr<Executor>& executor);
+
+  /// Decode the data pages of a column chunk in parallel when reading a single
+  /// column chunk or row group with more than 1 thread (see set_num_threads).
+  /// The pages are split into ranges of about the same number of rows, which
+  /// share the decoded dictionary and decode their values in place into one
+  /// array. The ranges of a row group run as tasks nested in those of its
+  /// columns. This helps when a row group has few but large column chunks.
+  ///
+  /// Only non-repeated columns of INT32, INT64, FLOAT and DOUBLE values read as
+  /// Arrow types of the same width are covered. Other columns, including
+  /// dictionary-encoded BYTE_ARRAY ones, are still decoded by one task per
+  /// column chunk. Disabled by default
+  void set_parallel_page_decoding(bool parallel_page_decoding);
+
   virtual ~FileReader();
 
  private:
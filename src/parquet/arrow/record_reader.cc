@@ -22,6 +22,10 @@
 #include <memory>
 #include <sstream>
 
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
 #include <arrow/buffer.h>
 #include <arrow/memory_pool.h>
 #include <arrow/status.h>
@@ -59,15 +63,22 @@ class RecordReader::RecordReaderImpl {
         num_decoded_values_(0),
         max_def_level_(descr->max_definition_level()),
         max_rep_level_(descr->max_repetition_level()),
-        at_record_start_(false),
+        at_record_start_(true),
         records_read_(0),
         values_written_(0),
         values_capacity_(0),
         null_count_(0),
+        values_output_(nullptr),
         levels_written_(0),
         levels_position_(0),
-        levels_capacity_(0) {
+        levels_capacity_(0),
+        buffered_levels_all_max_(true) {
     nullable_values_ = internal::HasSpacedValues(descr);
+    // The definition levels of a top-level column are not needed to assemble
+    // nested arrays, only its validity bitmap
+    const schema::Node* parent = descr->schema_node()->parent();
+    decode_levels_to_bitmap_ = max_rep_level_ == 0 && max_def_level_ > 0 &&
+                               (parent == nullptr || parent->parent() == nullptr);
     values_ = std::make_shared<PoolBuffer>(pool);
     valid_bits_ = std::make_shared<PoolBuffer>(pool);
     def_levels_ = std::make_shared<PoolBuffer>(pool);
@@ -87,11 +98,17 @@ class RecordReader::RecordReaderImpl {
 
   virtual int64_t ReadRecords(int64_t num_records) = 0;
 
+  virtual int64_t SkipRecords(int64_t num_records) = 0;
+
   // Dictionary decoders must be reset when advancing row groups
   virtual void ResetDecoders() = 0;
 
+  virtual void ShareDictionary(const RecordReaderImpl& other) = 0;
+
   void SetPageReader(std::unique_ptr<PageReader> reader) {
     pager_ = std::move(reader);
+    // A column chunk always starts at a record boundary
+    at_record_start_ = true;
     ResetDecoders();
   }
 
@@ -105,7 +122,18 @@ class RecordReader::RecordReaderImpl {
     return reinterpret_cast<int16_t*>(rep_levels_->mutable_data());
   }
 
-  uint8_t* values() const { return values_->mutable_data(); }
+  uint8_t* values() const {
+    return values_output_ != nullptr ? values_output_ : values_->mutable_data();
+  }
+
+  void SetValuesOutput(uint8_t* out) {
+    if (descr_->physical_type() == Type::BYTE_ARRAY ||
+        descr_->physical_type() == Type::FIXED_LEN_BYTE_ARRAY) {
+      throw ParquetException("Binary values cannot be decoded into an output buffer");
+    }
+    ResetValues();
+    values_output_ = out;
+  }
 
   /// \brief Number of values written including nulls (if any)
   int64_t values_written() const { return values_written_; }
@@ -172,14 +200,20 @@ class RecordReader::RecordReaderImpl {
     return records_read;
   }
 
-  // Read multiple definition levels into preallocated memory
+  // Read multiple definition levels into the level buffer after the levels
+  // already written, keeping track of whether all buffered levels are at the
+  // maximum definition level, i.e. non-null
   //
   // Returns the number of decoded definition levels
-  int64_t ReadDefinitionLevels(int64_t batch_size, int16_t* levels) {
-    if (descr_->max_definition_level() == 0) {
-      return 0;
+  int64_t ReadBufferedDefinitionLevels(int64_t batch_size) {
+    int64_t num_max_levels = 0;
+    const int64_t levels_read = definition_level_decoder_.Decode(
+        static_cast<int>(batch_size), def_levels() + levels_written_, &num_max_levels);
+    if (levels_position_ == levels_written_) {
+      buffered_levels_all_max_ = true;
     }
-    return definition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
+    buffered_levels_all_max_ = buffered_levels_all_max_ && num_max_levels == levels_read;
+    return levels_read;
   }
 
   int64_t ReadRepetitionLevels(int64_t batch_size, int16_t* levels) {
@@ -205,7 +239,7 @@ class RecordReader::RecordReaderImpl {
   }
 
   void ReserveLevels(int64_t capacity) {
-    if (descr_->max_definition_level() > 0 &&
+    if (descr_->max_definition_level() > 0 && !decode_levels_to_bitmap_ &&
         (levels_written_ + capacity > levels_capacity_)) {
       int64_t new_levels_capacity = BitUtil::NextPower2(levels_capacity_ + 1);
       while (levels_written_ + capacity > new_levels_capacity) {
@@ -228,8 +262,11 @@ class RecordReader::RecordReaderImpl {
         new_values_capacity = BitUtil::NextPower2(new_values_capacity + 1);
       }
 
-      int type_size = GetTypeByteSize(descr_->physical_type());
-      PARQUET_THROW_NOT_OK(values_->Resize(new_values_capacity * type_size, false));
+      // An output buffer set by SetValuesOutput is sized by the caller
+      if (values_output_ == nullptr) {
+        int type_size = GetTypeByteSize(descr_->physical_type());
+        PARQUET_THROW_NOT_OK(values_->Resize(new_values_capacity * type_size, false));
+      }
       values_capacity_ = new_values_capacity;
     }
     if (nullable_values_) {
@@ -314,6 +351,10 @@ class RecordReader::RecordReaderImpl {
 
   bool nullable_values_;
 
+  // True for flat optional columns, whose definition levels are decoded
+  // straight into the validity bitmap instead of the level buffer
+  bool decode_levels_to_bitmap_;
+
   bool at_record_start_;
   int64_t records_read_;
 
@@ -321,10 +362,17 @@ class RecordReader::RecordReaderImpl {
   int64_t values_capacity_;
   int64_t null_count_;
 
+  // Decode the values here instead of values_, see SetValuesOutput
+  uint8_t* values_output_;
+
   int64_t levels_written_;
   int64_t levels_position_;
   int64_t levels_capacity_;
 
+  // True if no definition level in [levels_position_, levels_written_) is below
+  // the maximum, in which case the values read from them have no nulls
+  bool buffered_levels_all_max_;
+
   // TODO(wesm): ByteArray / FixedLenByteArray types
   std::unique_ptr<::arrow::ArrayBuilder> builder_;
 
@@ -332,7 +380,7 @@ class RecordReader::RecordReaderImpl {
 
   template <typename T>
   T* ValuesHead() {
-    return reinterpret_cast<T*>(values_->mutable_data()) + values_written_;
+    return reinterpret_cast<T*>(values()) + values_written_;
   }
 
   std::shared_ptr<::arrow::PoolBuffer> valid_bits_;
@@ -354,6 +402,21 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
 
   void ResetDecoders() override { decoders_.clear(); }
 
+  void ShareDictionary(const RecordReader::RecordReaderImpl& other) override {
+    const auto& typed_other = static_cast<const TypedRecordReader<DType>&>(other);
+    auto it = typed_other.decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+    if (it == typed_other.decoders_.end()) {
+      return;
+    }
+    if (decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY)) != decoders_.end()) {
+      throw ParquetException("Column cannot have more than one dictionary.");
+    }
+    auto decoder = std::make_shared<DictionaryDecoder<DType>>(descr_, pool_);
+    decoder->ShareDict(static_cast<const DictionaryDecoder<DType>&>(*it->second));
+    decoders_[static_cast<int>(Encoding::RLE_DICTIONARY)] = decoder;
+    current_decoder_ = decoder.get();
+  }
+
   inline void ReadValuesSpaced(int64_t values_with_nulls, int64_t null_count) {
     uint8_t* valid_bits = valid_bits_->mutable_data();
     const int64_t valid_bits_offset = values_written_;
@@ -395,7 +458,15 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
     }
 
     int64_t null_count = 0;
-    if (nullable_values_) {
+    if (nullable_values_ && buffered_levels_all_max_) {
+      // Every level is a non-null value, so the validity bitmap is set as a
+      // whole and the values are read without spacing
+      values_to_read = levels_position_ - start_levels_position;
+      internal::SetBitmapRange(valid_bits_->mutable_data(), values_written_,
+                               values_to_read, true);
+      ReadValuesDense(values_to_read);
+      ConsumeBufferedValues(values_to_read);
+    } else if (nullable_values_) {
       int64_t values_with_nulls = 0;
       internal::DefinitionLevelsToBitmap(
           def_levels() + start_levels_position, levels_position_ - start_levels_position,
@@ -444,8 +515,10 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
 
     // If we are in the middle of a record, we continue until reaching the
     // desired number of records or the end of the current record if we've found
-    // enough records
-    while (!at_record_start_ || records_read < num_records) {
+    // enough records. The end of a record is only known once the first level of
+    // the next record has been seen
+    while (!at_record_start_ || records_read < num_records ||
+           (max_rep_level_ > 0 && levels_position_ == levels_written_)) {
       // Is there more data to read in this row group?
       if (!HasNext()) {
         break;
@@ -460,21 +533,24 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
         break;
       }
 
-      if (max_def_level_ > 0) {
+      if (decode_levels_to_bitmap_) {
+        const int64_t levels_read =
+            ReadFlatOptionalRecords(std::min(num_records - records_read, batch_size));
+        // Exhausted column chunk
+        if (levels_read == 0) {
+          break;
+        }
+        records_read += levels_read;
+      } else if (max_def_level_ > 0) {
         ReserveLevels(batch_size);
 
-        int16_t* def_levels = this->def_levels() + levels_written_;
         int16_t* rep_levels = this->rep_levels() + levels_written_;
 
         // Not present for non-repeated fields
-        int64_t levels_read = 0;
-        if (max_rep_level_ > 0) {
-          levels_read = ReadDefinitionLevels(batch_size, def_levels);
-          if (ReadRepetitionLevels(batch_size, rep_levels) != levels_read) {
-            throw ParquetException("Number of decoded rep / def levels did not match");
-          }
-        } else if (max_def_level_ > 0) {
-          levels_read = ReadDefinitionLevels(batch_size, def_levels);
+        int64_t levels_read = ReadBufferedDefinitionLevels(batch_size);
+        if (max_rep_level_ > 0 &&
+            ReadRepetitionLevels(batch_size, rep_levels) != levels_read) {
+          throw ParquetException("Number of decoded rep / def levels did not match");
         }
 
         // Exhausted column chunk
@@ -494,9 +570,147 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
     return records_read;
   }
 
+  int64_t SkipRecords(int64_t num_records) override {
+    int64_t records_skipped = 0;
+
+    if (levels_position_ < levels_written_) {
+      records_skipped += SkipBufferedRecords(num_records);
+    }
+
+    // As in ReadRecords, a repeated column is only positioned at a record
+    // boundary once the first level of the next record has been seen
+    while (records_skipped < num_records ||
+           (max_rep_level_ > 0 && levels_position_ == levels_written_)) {
+      if (max_rep_level_ == 0 && available_values_current_page() == 0) {
+        // Every level of a flat column is a record, so data pages that are
+        // skipped as a whole are not even decompressed
+        records_skipped += pager_->SkipDataPages(num_records - records_skipped);
+        if (records_skipped == num_records) {
+          break;
+        }
+      }
+      if (!HasNext()) {
+        break;
+      }
+
+      const int64_t available = available_values_current_page();
+      if (max_rep_level_ > 0) {
+        // Records may span level batches and pages, so the repetition levels
+        // must be decoded to find the record boundaries
+        const int64_t batch_size = std::min(kMinLevelBatchSize, available);
+        ReserveLevels(batch_size);
+
+        int16_t* rep_levels = this->rep_levels() + levels_written_;
+        const int64_t levels_read = ReadBufferedDefinitionLevels(batch_size);
+        if (ReadRepetitionLevels(batch_size, rep_levels) != levels_read) {
+          throw ParquetException("Number of decoded rep / def levels did not match");
+        }
+        if (levels_read == 0) {
+          break;
+        }
+        levels_written_ += levels_read;
+        records_skipped += SkipBufferedRecords(num_records - records_skipped);
+        continue;
+      }
+
+      // Flat column: every level is a record
+      const int64_t batch_size = std::min(num_records - records_skipped, available);
+      if (batch_size == available) {
+        // Drop the remainder of the page without looking at it. The decoders
+        // are reset when the next page is loaded
+        ConsumeBufferedValues(batch_size);
+        records_skipped += batch_size;
+        continue;
+      }
+
+      int64_t values_to_skip = batch_size;
+      if (max_def_level_ > 0) {
+        values_to_skip = 0;
+        if (definition_level_decoder_.Skip(static_cast<int>(batch_size),
+                                           &values_to_skip) != batch_size) {
+          throw ParquetException("Unexpected end of definition levels");
+        }
+      }
+      SkipValues(values_to_skip);
+      ConsumeBufferedValues(batch_size);
+      records_skipped += batch_size;
+    }
+
+    return records_skipped;
+  }
+
  private:
   typedef Decoder<DType> DecoderType;
 
+  // Read up to num_records records of a flat optional column from the current
+  // data page, decoding their definition levels straight into the validity
+  // bitmap. Each level is a record
+  //
+  // Returns the number of records read
+  int64_t ReadFlatOptionalRecords(int64_t num_records) {
+    ReserveValues(num_records);
+    int64_t null_count = 0;
+    const int64_t levels_read = definition_level_decoder_.DecodeToBitmap(
+        static_cast<int>(num_records), valid_bits_->mutable_data(), values_written_,
+        &null_count);
+    if (null_count == 0) {
+      ReadValuesDense(levels_read);
+    } else {
+      ReadValuesSpaced(levels_read, null_count);
+    }
+    ConsumeBufferedValues(levels_read);
+    values_written_ += levels_read;
+    null_count_ += null_count;
+    return levels_read;
+  }
+
+  void SkipValues(int64_t num_values) {
+    if (num_values > 0 &&
+        current_decoder_->Skip(static_cast<int>(num_values)) != num_values) {
+      throw ParquetException("Unexpected end of data page");
+    }
+  }
+
+  // Skip up to num_records records whose levels have already been decoded.
+  // The skipped levels are removed from the level buffers, so the levels of
+  // the records read so far and those still to be read stay contiguous
+  int64_t SkipBufferedRecords(int64_t num_records) {
+    const int64_t start_levels_position = levels_position_;
+
+    int64_t values_to_skip = 0;
+    int64_t records_skipped = 0;
+    if (max_rep_level_ > 0) {
+      records_skipped = DelimitRecords(num_records, &values_to_skip);
+    } else {
+      records_skipped = std::min(levels_written_ - levels_position_, num_records);
+      if (buffered_levels_all_max_) {
+        values_to_skip = records_skipped;
+      } else {
+        const int16_t* def_levels = this->def_levels() + levels_position_;
+        values_to_skip =
+            std::count(def_levels, def_levels + records_skipped, max_def_level_);
+      }
+      levels_position_ += records_skipped;
+    }
+    SkipValues(values_to_skip);
+
+    const int64_t levels_skipped = levels_position_ - start_levels_position;
+    ConsumeBufferedValues(levels_skipped);
+
+    int16_t* def_data = def_levels();
+    std::copy(def_data + levels_position_, def_data + levels_written_,
+              def_data + start_levels_position);
+    if (max_rep_level_ > 0) {
+      int16_t* rep_data = rep_levels();
+      std::copy(rep_data + levels_position_, rep_data + levels_written_,
+                rep_data + start_levels_position);
+    }
+    levels_written_ -= levels_skipped;
+    levels_position_ = start_levels_position;
+
+    return records_skipped;
+  }
+
   // Map of encoding type to the respective decoder object. For example, a
   // column chunk's data pages may include both dictionary-encoded and
   // plain-encoded data.
@@ -754,6 +968,107 @@ std::shared_ptr<RecordReader> RecordReader::Make(const ColumnDescriptor* descr,
   return nullptr;
 }
 
+// ----------------------------------------------------------------------
+// Assembly of list offsets
+
+namespace {
+
+// Advance over the levels from position i on that only extend the innermost
+// list, i.e. whose repetition level is max_rep_level, adding the number of them
+// with a value slot to *values_offset. Returns the position of the first level
+// that starts a list
+int64_t SkipListContinuations(const int16_t* def_levels, const int16_t* rep_levels,
+                              int64_t i, int64_t num_levels, int16_t max_rep_level,
+                              int16_t values_def_level, int32_t* values_offset) {
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+  const __m128i max_reps = _mm_set1_epi16(max_rep_level);
+  const __m128i min_defs = _mm_set1_epi16(static_cast<int16_t>(values_def_level - 1));
+  for (; i + 8 <= num_levels; i += 8) {
+    const __m128i reps =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(rep_levels + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(reps, max_reps)) != 0xFFFF) {
+      break;
+    }
+    const __m128i defs =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(def_levels + i));
+    // Two mask bits per level
+    *values_offset +=
+        _mm_popcnt_u32(_mm_movemask_epi8(_mm_cmpgt_epi16(defs, min_defs))) / 2;
+  }
+#endif
+  for (; i < num_levels && rep_levels[i] == max_rep_level; ++i) {
+    *values_offset += def_levels[i] >= values_def_level;
+  }
+  return i;
+}
+
+}  // namespace
+
+::arrow::Status LevelsToListOffsets(const int16_t* def_levels, const int16_t* rep_levels,
+                                    int64_t num_levels, int16_t values_def_level,
+                                    ::arrow::MemoryPool* pool,
+                                    std::vector<ListLevel>* list_levels) {
+  const int list_depth = static_cast<int>(list_levels->size());
+  const int16_t max_rep_level = static_cast<int16_t>(list_depth);
+
+  // There are at most as many lists at each level as there are levels
+  std::vector<int32_t*> offsets(list_depth);
+  std::vector<uint8_t*> valid_bits(list_depth);
+  for (int j = 0; j < list_depth; ++j) {
+    ListLevel& level = (*list_levels)[j];
+    RETURN_NOT_OK(::arrow::AllocateBuffer(
+        pool, (num_levels + 1) * sizeof(int32_t), &level.offsets));
+    RETURN_NOT_OK(::arrow::AllocateBuffer(pool, BitUtil::BytesForBits(num_levels),
+                                          &level.valid_bits));
+    offsets[j] = reinterpret_cast<int32_t*>(level.offsets->mutable_data());
+    valid_bits[j] = level.valid_bits->mutable_data();
+    memset(valid_bits[j], 0, static_cast<size_t>(level.valid_bits->size()));
+    level.length = 0;
+    level.null_count = 0;
+  }
+
+  int32_t values_offset = 0;
+  int64_t i = 0;
+  while (i < num_levels) {
+    const int16_t rep_level = rep_levels[i];
+    if (rep_level == max_rep_level) {
+      i = SkipListContinuations(def_levels, rep_levels, i, num_levels, max_rep_level,
+                                values_def_level, &values_offset);
+      continue;
+    }
+    // A new list starts at every level from rep_level on, down to the first one
+    // that is null or empty
+    const int16_t def_level = def_levels[i];
+    for (int j = rep_level; j < list_depth; ++j) {
+      ListLevel& level = (*list_levels)[j];
+      offsets[j][level.length] = j == list_depth - 1
+                                     ? values_offset
+                                     : static_cast<int32_t>((*list_levels)[j + 1].length);
+      if (level.nullable && def_level == level.empty_def_level - 1) {
+        ++level.null_count;
+        ++level.length;
+        break;
+      }
+      BitUtil::SetBit(valid_bits[j], level.length);
+      ++level.length;
+      if (def_level == level.empty_def_level) {
+        break;
+      }
+    }
+    values_offset += def_level >= values_def_level;
+    ++i;
+  }
+
+  // Close the last list of each level
+  for (int j = 0; j < list_depth; ++j) {
+    ListLevel& level = (*list_levels)[j];
+    offsets[j][level.length] = j == list_depth - 1
+                                   ? values_offset
+                                   : static_cast<int32_t>((*list_levels)[j + 1].length);
+  }
+  return ::arrow::Status::OK();
+}
+
 // ----------------------------------------------------------------------
 // Implement public API
 
@@ -765,10 +1080,16 @@ int64_t RecordReader::ReadRecords(int64_t num_records) {
   return impl_->ReadRecords(num_records);
 }
 
+int64_t RecordReader::SkipRecords(int64_t num_records) {
+  return impl_->SkipRecords(num_records);
+}
+
 void RecordReader::Reset() { return impl_->Reset(); }
 
 void RecordReader::Reserve(int64_t num_values) { impl_->Reserve(num_values); }
 
+void RecordReader::SetValuesOutput(uint8_t* out) { impl_->SetValuesOutput(out); }
+
 const int16_t* RecordReader::def_levels() const { return impl_->def_levels(); }
 
 const int16_t* RecordReader::rep_levels() const { return impl_->rep_levels(); }
@@ -801,5 +1122,9 @@ void RecordReader::SetPageReader(std::unique_ptr<PageReader> reader) {
   impl_->SetPageReader(std::move(reader));
 }
 
+void RecordReader::ShareDictionary(const RecordReader& other) {
+  impl_->ShareDictionary(*other.impl_);
+}
+
 }  // namespace internal
 }  // namespace parquet
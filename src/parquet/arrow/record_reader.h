@@ -53,7 +53,9 @@ class RecordReader {
 
   virtual ~RecordReader();
 
-  /// \brief Decoded definition levels
+  /// \brief Decoded definition levels. The levels of flat optional columns at
+  /// the top level of the schema are decoded straight into the validity bitmap
+  /// and not kept
   const int16_t* def_levels() const;
 
   /// \brief Decoded repetition levels
@@ -66,9 +68,23 @@ class RecordReader {
   /// \return number of records read
   int64_t ReadRecords(int64_t num_records);
 
+  /// \brief Attempt to skip indicated number of records from column chunk
+  /// without materializing them. Values and levels of records read before
+  /// are left untouched, so reads and skips can be interleaved to read a
+  /// selection of the records into one batch
+  /// \return number of records skipped
+  int64_t SkipRecords(int64_t num_records);
+
   /// \brief Pre-allocate space for data. Results in better flat read performance
   void Reserve(int64_t num_values);
 
+  /// \brief Decode values into out instead of a buffer of the reader, e.g. a
+  /// slice of the values of a larger array. out must have room for all the
+  /// values read, including nulls, until the next Reset. values() then
+  /// returns out and ReleaseValues returns no values. Not supported for
+  /// BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY columns, whose values go to builder()
+  void SetValuesOutput(uint8_t* out);
+
   /// \brief Clear consumed values and repetition/definition levels as the
   /// result of calling ReadRecords
   void Reset();
@@ -102,11 +118,48 @@ class RecordReader {
   /// \param[in] reader obtained from RowGroupReader::GetColumnPageReader
   void SetPageReader(std::unique_ptr<PageReader> reader);
 
+  /// \brief Decode dictionary-encoded pages with the dictionary already
+  /// decoded by other, a reader of the same column chunk. The dictionary is
+  /// shared read-only, so both readers can be used from different threads.
+  /// Must be called after SetPageReader; does nothing if other has not seen
+  /// a dictionary page
+  void ShareDictionary(const RecordReader& other);
+
  private:
   std::unique_ptr<RecordReaderImpl> impl_;
   explicit RecordReader(RecordReaderImpl* impl);
 };
 
+/// \brief The lists at one nesting level of a repeated leaf column, outermost
+/// first
+struct PARQUET_EXPORT ListLevel {
+  /// Whether the lists at this level can be null
+  bool nullable;
+  /// Definition level of an empty list at this level. One less is a null list
+  /// if the lists are nullable
+  int16_t empty_def_level;
+
+  /// Output of LevelsToListOffsets: length + 1 int32 offsets into the next
+  /// level, or into the values for the innermost level
+  std::shared_ptr<::arrow::Buffer> offsets;
+  /// Output of LevelsToListOffsets: validity bitmap of the lists
+  std::shared_ptr<::arrow::Buffer> valid_bits;
+  int64_t length;
+  int64_t null_count;
+};
+
+/// \brief Assemble the offsets and validity bitmaps of the nested lists of a
+/// repeated leaf column from its decoded levels, one ListLevel per repetition
+/// level. Levels with definition level values_def_level or higher have a slot
+/// in the values. Runs of levels that only extend the innermost list are
+/// consumed in bulk
+::arrow::Status PARQUET_EXPORT LevelsToListOffsets(const int16_t* def_levels,
+                                                   const int16_t* rep_levels,
+                                                   int64_t num_levels,
+                                                   int16_t values_def_level,
+                                                   ::arrow::MemoryPool* pool,
+                                                   std::vector<ListLevel>* list_levels);
+
 }  // namespace internal
 }  // namespace parquet
 
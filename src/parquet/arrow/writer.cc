@@ -300,6 +300,21 @@ Status GetLeafType(const ::arrow::DataType& type, ::arrow::Type::type* leaf_type
   }
 }
 
+// Bytes held by the buffers of data and its children, including sliced off
+// parts; the cost hint of the task encoding it
+int64_t ArrayDataSize(const ::arrow::ArrayData& data) {
+  int64_t size = 0;
+  for (const std::shared_ptr<Buffer>& buffer : data.buffers) {
+    if (buffer != nullptr) {
+      size += buffer->size();
+    }
+  }
+  for (const std::shared_ptr<::arrow::ArrayData>& child : data.child_data) {
+    size += ArrayDataSize(*child);
+  }
+  return size;
+}
+
 class ArrowColumnWriter {
  public:
   ArrowColumnWriter(ColumnWriterContext* ctx, ColumnWriter* column_writer,
@@ -957,6 +972,56 @@ class FileWriter::Impl {
 
   Status WriteColumnChunk(const std::shared_ptr<ChunkedArray>& data, int64_t offset,
                           const int64_t size) {
+    ColumnWriter* column_writer;
+    PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->NextColumn());
+
+    int current_column_idx = row_group_writer_->current_column();
+    return WriteColumn(&column_write_context_, column_writer, current_column_idx - 1,
+                       data, offset, size);
+  }
+
+  // Encode the columns of table into a buffered row group with num_threads
+  // tasks on the executor. The column chunks are written to the sink in schema
+  // order when the row group is closed
+  Status WriteRowGroup(const Table& table, int64_t offset, int64_t size,
+                       int num_threads) {
+    if (row_group_writer_ != nullptr) {
+      PARQUET_CATCH_NOT_OK(row_group_writer_->Close());
+    }
+    PARQUET_CATCH_NOT_OK(row_group_writer_ = writer_->AppendBufferedRowGroup());
+
+    auto WriteColumnFunc = [&table, offset, size, this](int i) {
+      // The scratch buffers of a context cannot be shared between threads
+      ColumnWriterContext column_write_context(memory_pool(), arrow_properties_.get());
+      ColumnWriter* column_writer;
+      PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->column(i));
+      return WriteColumn(&column_write_context, column_writer, i,
+                         table.column(i)->data(), offset, size);
+    };
+    // The tasks of the largest columns are started first
+    std::vector<int64_t> column_sizes(table.num_columns(), 0);
+    for (int i = 0; i < table.num_columns(); i++) {
+      for (const std::shared_ptr<Array>& chunk : table.column(i)->data()->chunks()) {
+        column_sizes[i] += ArrayDataSize(*chunk->data());
+      }
+    }
+    return arrow_properties_->executor()->ParallelFor(
+        num_threads, table.num_columns(), WriteColumnFunc, column_sizes);
+  }
+
+  const WriterProperties& properties() const { return *writer_->properties(); }
+
+  ::arrow::MemoryPool* memory_pool() const { return column_write_context_.memory_pool; }
+
+  virtual ~Impl() {}
+
+ private:
+  friend class FileWriter;
+
+  Status WriteColumn(ColumnWriterContext* column_write_context,
+                     ColumnWriter* column_writer, int column_index,
+                     const std::shared_ptr<ChunkedArray>& data, int64_t offset,
+                     const int64_t size) {
     // DictionaryArrays are not yet handled with a fast path. To still support
     // writing them as a workaround, we convert them back to their non-dictionary
     // representation.
@@ -967,8 +1032,11 @@ class FileWriter::Impl {
       // TODO(ARROW-1648): Remove this special handling once we require an Arrow
       // version that has this fixed.
       if (dict_type.dictionary()->type()->id() == ::arrow::Type::NA) {
-        auto null_array = std::make_shared<::arrow::NullArray>(data->length());
-        return WriteColumnChunk(*null_array);
+        ::arrow::ArrayVector chunks = {
+            std::make_shared<::arrow::NullArray>(data->length())};
+        auto null_array = std::make_shared<::arrow::ChunkedArray>(chunks);
+        return WriteColumn(column_write_context, column_writer, column_index, null_array,
+                           0, data->length());
       }
 
       FunctionContext ctx(this->memory_pool());
@@ -976,35 +1044,23 @@ class FileWriter::Impl {
       ::arrow::compute::Datum cast_output;
       RETURN_NOT_OK(Cast(&ctx, cast_input, dict_type.dictionary()->type(), CastOptions(),
                          &cast_output));
-      return WriteColumnChunk(cast_output.chunked_array(), offset, size);
+      return WriteColumn(column_write_context, column_writer, column_index,
+                         cast_output.chunked_array(), offset, size);
     }
 
-    ColumnWriter* column_writer;
-    PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->NextColumn());
-
     // TODO(wesm): This trick to construct a schema for one Parquet root node
     // will not work for arbitrary nested data
-    int current_column_idx = row_group_writer_->current_column();
     std::shared_ptr<::arrow::Schema> arrow_schema;
-    RETURN_NOT_OK(FromParquetSchema(writer_->schema(), {current_column_idx - 1},
+    RETURN_NOT_OK(FromParquetSchema(writer_->schema(), {column_index},
                                     writer_->key_value_metadata(), &arrow_schema));
 
-    ArrowColumnWriter arrow_writer(&column_write_context_, column_writer,
+    ArrowColumnWriter arrow_writer(column_write_context, column_writer,
                                    arrow_schema->field(0));
 
     RETURN_NOT_OK(arrow_writer.Write(*data, offset, size));
     return arrow_writer.Close();
   }
 
-  const WriterProperties& properties() const { return *writer_->properties(); }
-
-  ::arrow::MemoryPool* memory_pool() const { return column_write_context_.memory_pool; }
-
-  virtual ~Impl() {}
-
- private:
-  friend class FileWriter;
-
   std::unique_ptr<ParquetFileWriter> writer_;
   RowGroupWriter* row_group_writer_;
   ColumnWriterContext column_write_context_;
@@ -1090,10 +1146,19 @@ Status FileWriter::WriteTable(const Table& table, int64_t chunk_size) {
     chunk_size = impl_->properties().max_row_group_length();
   }
 
+  const int num_threads =
+      std::min(impl_->arrow_properties_->num_threads(), table.num_columns());
+
   for (int chunk = 0; chunk * chunk_size < table.num_rows(); chunk++) {
     int64_t offset = chunk * chunk_size;
     int64_t size = std::min(chunk_size, table.num_rows() - offset);
 
+    if (num_threads > 1) {
+      RETURN_NOT_OK_ELSE(impl_->WriteRowGroup(table, offset, size, num_threads),
+                         PARQUET_IGNORE_NOT_OK(Close()));
+      continue;
+    }
+
     RETURN_NOT_OK_ELSE(NewRowGroup(size), PARQUET_IGNORE_NOT_OK(Close()));
     for (int i = 0; i < table.num_columns(); i++) {
       auto chunked_data = table.column(i)->data();
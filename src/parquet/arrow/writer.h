@@ -22,6 +22,7 @@
 
 #include "parquet/api/schema.h"
 #include "parquet/api/writer.h"
+#include "parquet/util/executor.h"
 
 #include "arrow/io/interfaces.h"
 #include "arrow/type.h"
@@ -44,7 +45,10 @@ class PARQUET_EXPORT ArrowWriterProperties {
  public:
   class Builder {
    public:
-    Builder() : write_nanos_as_int96_(false), coerce_timestamps_enabled_(false) {}
+    Builder()
+        : write_nanos_as_int96_(false),
+          coerce_timestamps_enabled_(false),
+          num_threads_(1) {}
     virtual ~Builder() {}
 
     Builder* disable_deprecated_int96_timestamps() {
@@ -63,9 +67,26 @@ class PARQUET_EXPORT ArrowWriterProperties {
       return this;
     }
 
+    /// Number of threads FileWriter::WriteTable uses to encode and compress the
+    /// columns of a row group concurrently. The column chunks are buffered in
+    /// memory until the whole row group is encoded. By default only 1 thread is
+    /// used and the columns are written directly to the sink
+    Builder* set_num_threads(int num_threads) {
+      num_threads_ = num_threads;
+      return this;
+    }
+
+    /// Run the column encoding tasks of set_num_threads on the threads of
+    /// executor instead of default_executor()
+    Builder* set_executor(const std::shared_ptr<Executor>& executor) {
+      executor_ = executor;
+      return this;
+    }
+
     std::shared_ptr<ArrowWriterProperties> build() {
       return std::shared_ptr<ArrowWriterProperties>(new ArrowWriterProperties(
-          write_nanos_as_int96_, coerce_timestamps_enabled_, coerce_timestamps_unit_));
+          write_nanos_as_int96_, coerce_timestamps_enabled_, coerce_timestamps_unit_,
+          num_threads_, executor_));
     }
 
    private:
@@ -73,6 +94,9 @@ class PARQUET_EXPORT ArrowWriterProperties {
 
     bool coerce_timestamps_enabled_;
     ::arrow::TimeUnit::type coerce_timestamps_unit_;
+
+    int num_threads_;
+    std::shared_ptr<Executor> executor_;
   };
 
   bool support_deprecated_int96_timestamps() const { return write_nanos_as_int96_; }
@@ -82,17 +106,29 @@ class PARQUET_EXPORT ArrowWriterProperties {
     return coerce_timestamps_unit_;
   }
 
+  int num_threads() const { return num_threads_; }
+
+  std::shared_ptr<Executor> executor() const {
+    return executor_ ? executor_ : default_executor();
+  }
+
  private:
   explicit ArrowWriterProperties(bool write_nanos_as_int96,
                                  bool coerce_timestamps_enabled,
-                                 ::arrow::TimeUnit::type coerce_timestamps_unit)
+                                 ::arrow::TimeUnit::type coerce_timestamps_unit,
+                                 int num_threads,
+                                 const std::shared_ptr<Executor>& executor)
       : write_nanos_as_int96_(write_nanos_as_int96),
         coerce_timestamps_enabled_(coerce_timestamps_enabled),
-        coerce_timestamps_unit_(coerce_timestamps_unit) {}
+        coerce_timestamps_unit_(coerce_timestamps_unit),
+        num_threads_(num_threads),
+        executor_(executor) {}
 
   const bool write_nanos_as_int96_;
   const bool coerce_timestamps_enabled_;
   const ::arrow::TimeUnit::type coerce_timestamps_unit_;
+  const int num_threads_;
+  const std::shared_ptr<Executor> executor_;
 };
 
 std::shared_ptr<ArrowWriterProperties> PARQUET_EXPORT default_arrow_writer_properties();
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <string>
@@ -170,6 +171,118 @@ class TestPrimitiveReader : public ::testing::Test {
     ASSERT_EQ(0, null_count);
   }
 
+  // Skip num_skip levels and then read num_read levels (which must not cross a
+  // page boundary), checking the result against the expected data
+  void SkipThenRead(int num_skip, int num_read, int* levels_position) {
+    Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+    ASSERT_EQ(num_skip, reader->Skip(num_skip));
+    *levels_position += num_skip;
+
+    vector<int32_t> vresult(num_read, -1);
+    vector<int16_t> dresult(num_read, -1);
+    vector<int16_t> rresult(num_read, -1);
+    int64_t values_read = 0;
+    int64_t levels_read = reader->ReadBatch(num_read, dresult.data(), rresult.data(),
+                                            vresult.data(), &values_read);
+    ASSERT_EQ(num_read, levels_read);
+
+    int values_position = *levels_position;
+    if (max_def_level_ > 0) {
+      values_position = static_cast<int>(
+          std::count(def_levels_.begin(), def_levels_.begin() + *levels_position,
+                     max_def_level_));
+      vector<int16_t> sub_levels(def_levels_.begin() + *levels_position,
+                                 def_levels_.begin() + *levels_position + num_read);
+      ASSERT_TRUE(vector_equal(sub_levels, dresult));
+    }
+    if (max_rep_level_ > 0) {
+      vector<int16_t> sub_levels(rep_levels_.begin() + *levels_position,
+                                 rep_levels_.begin() + *levels_position + num_read);
+      ASSERT_TRUE(vector_equal(sub_levels, rresult));
+    }
+    vresult.resize(values_read);
+    vector<int32_t> sub_values(values_.begin() + values_position,
+                               values_.begin() + values_position + values_read);
+    ASSERT_TRUE(vector_equal(sub_values, vresult));
+    *levels_position += num_read;
+  }
+
+  void ExecuteSkip(int num_pages, int levels_per_page, const ColumnDescriptor* d,
+                   Encoding::type encoding) {
+    num_values_ =
+        MakePages<Int32Type>(d, num_pages, levels_per_page, def_levels_, rep_levels_,
+                             values_, data_buffer_, pages_, encoding);
+    num_levels_ = num_pages * levels_per_page;
+    InitReader(d);
+    int levels_position = 0;
+    // Skip within a page
+    ASSERT_NO_FATAL_FAILURE(SkipThenRead(30, 40, &levels_position));
+    // Skip the rest of the page and all of the next one
+    ASSERT_NO_FATAL_FAILURE(SkipThenRead(levels_per_page + 30, 50, &levels_position));
+    // Skip into the middle of the next page
+    ASSERT_NO_FATAL_FAILURE(SkipThenRead(75, 25, &levels_position));
+    Clear();
+  }
+
+  // Evaluate the predicate with ReadFilter in batches that straddle page
+  // boundaries and compare against evaluating it on the decoded values
+  void CheckFilter(const std::function<bool(int32_t)>& predicate,
+                   bool dictionary_may_match) {
+    Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+    reader->SetPredicate(predicate);
+    ASSERT_EQ(dictionary_may_match, reader->DictionaryMayMatch());
+
+    vector<uint8_t> expected(num_levels_, 0);
+    int64_t expected_selected = 0;
+    int value_index = 0;
+    for (int i = 0; i < num_levels_; ++i) {
+      if (max_def_level_ == 0 || def_levels_[i] == max_def_level_) {
+        if (predicate(values_[value_index++])) {
+          expected[i] = 1;
+          ++expected_selected;
+        }
+      }
+    }
+
+    // Offset by 3 bits and pre-fill with ones to check that bits are cleared
+    const int64_t offset = 3;
+    vector<uint8_t> selection(BitUtil::BytesForBits(num_levels_ + offset), 0xFF);
+    int64_t rows_read = 0;
+    int64_t total_selected = 0;
+    int64_t batch = 0;
+    do {
+      int64_t num_selected = 0;
+      batch = reader->ReadFilter(37, selection.data(), offset + rows_read,
+                                 &num_selected);
+      rows_read += batch;
+      total_selected += num_selected;
+    } while (batch > 0);
+
+    ASSERT_EQ(num_levels_, rows_read);
+    ASSERT_EQ(expected_selected, total_selected);
+    for (int i = 0; i < num_levels_; ++i) {
+      ASSERT_EQ(expected[i] != 0, BitUtil::GetBit(selection.data(), offset + i))
+          << "row " << i;
+    }
+  }
+
+  void ExecuteFilter(int num_pages, int levels_per_page, const ColumnDescriptor* d,
+                     Encoding::type encoding) {
+    const bool is_dictionary = encoding == Encoding::RLE_DICTIONARY;
+    const std::vector<std::function<bool(int32_t)>> predicates = {
+        [](int32_t value) { return value % 3 == 0; },
+        [](int32_t value) { return false; }};
+    for (size_t i = 0; i < predicates.size(); ++i) {
+      num_values_ = MakePages<Int32Type>(d, num_pages, levels_per_page, def_levels_,
+                                         rep_levels_, values_, data_buffer_, pages_,
+                                         encoding);
+      num_levels_ = num_pages * levels_per_page;
+      InitReader(d);
+      ASSERT_NO_FATAL_FAILURE(CheckFilter(predicates[i], !is_dictionary || i == 0));
+      Clear();
+    }
+  }
+
   void Clear() {
     values_.clear();
     def_levels_.clear();
@@ -249,6 +362,77 @@ TEST_F(TestPrimitiveReader, TestInt32FlatOptional) {
   ASSERT_NO_FATAL_FAILURE(ExecuteDict(num_pages, levels_per_page, &descr));
 }
 
+TEST_F(TestPrimitiveReader, TestInt32FlatOptionalRuns) {
+  // A page without nulls, a page of nulls only and a page of runs of either,
+  // which the reader handles without looking at the individual levels
+  const int levels_per_page = 100;
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+
+  auto make_pages = [&]() {
+    def_levels_.assign(levels_per_page, 1);
+    def_levels_.resize(2 * levels_per_page, 0);
+    for (int i = 0; i < levels_per_page; ++i) {
+      def_levels_.push_back((i < 40 || (i >= 70 && i % 3 == 0)) ? 1 : 0);
+    }
+    vector<int> values_per_page;
+    for (int p = 0; p < 3; ++p) {
+      auto begin = def_levels_.begin() + p * levels_per_page;
+      values_per_page.push_back(
+          static_cast<int>(std::count(begin, begin + levels_per_page, 1)));
+    }
+    num_levels_ = static_cast<int>(def_levels_.size());
+    num_values_ = static_cast<int>(std::count(def_levels_.begin(), def_levels_.end(), 1));
+    values_.resize(num_values_);
+    for (int i = 0; i < num_values_; ++i) {
+      values_[i] = i * 7;
+    }
+    PaginatePlain<Int32Type>(&descr, values_, def_levels_, max_def_level_, rep_levels_,
+                             max_rep_level_, levels_per_page, values_per_page, pages_);
+    InitReader(&descr);
+  };
+
+  make_pages();
+  ASSERT_NO_FATAL_FAILURE(CheckResults());
+  Clear();
+  make_pages();
+  ASSERT_NO_FATAL_FAILURE(CheckResultsSpaced());
+  Clear();
+  make_pages();
+  ASSERT_NO_FATAL_FAILURE(
+      CheckFilter([](int32_t value) { return value % 2 == 0; }, true));
+  Clear();
+}
+
+TEST_F(TestPrimitiveReader, TestInt32FlatOptionalInvalidLevel) {
+  // The levels are bit-packed with the width of max_def_level_, which leaves
+  // room for a larger level in a corrupt page
+  max_def_level_ = 2;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  def_levels_ = {2, 1, 0, 2, 2, 3, 2, 1, 2, 2};
+  num_levels_ = static_cast<int>(def_levels_.size());
+  num_values_ = 6;
+  values_ = {1, 2, 3, 4, 5, 6};
+  vector<int> values_per_page = {num_values_};
+  PaginatePlain<Int32Type>(&descr, values_, def_levels_, max_def_level_, rep_levels_,
+                           max_rep_level_, num_levels_, values_per_page, pages_);
+  InitReader(&descr);
+
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  vector<int32_t> values(num_levels_);
+  vector<int16_t> def_levels(num_levels_);
+  vector<uint8_t> valid_bits(2);
+  int64_t levels_read, values_read, null_count;
+  ASSERT_THROW(reader->ReadBatchSpaced(num_levels_, def_levels.data(), nullptr,
+                                       values.data(), valid_bits.data(), 0, &levels_read,
+                                       &values_read, &null_count),
+               ParquetException);
+}
+
 TEST_F(TestPrimitiveReader, TestInt32FlatRepeated) {
   int levels_per_page = 100;
   int num_pages = 50;
@@ -323,6 +507,69 @@ TEST_F(TestPrimitiveReader, TestInt32FlatRequiredSkip) {
   reader_.reset();
 }
 
+TEST_F(TestPrimitiveReader, TestInt32SkipWithinPages) {
+  int levels_per_page = 100;
+  int num_pages = 5;
+  for (auto encoding : {Encoding::PLAIN, Encoding::RLE_DICTIONARY}) {
+    max_def_level_ = 0;
+    max_rep_level_ = 0;
+    NodePtr required = schema::Int32("a", Repetition::REQUIRED);
+    const ColumnDescriptor required_descr(required, max_def_level_, max_rep_level_);
+    ASSERT_NO_FATAL_FAILURE(
+        ExecuteSkip(num_pages, levels_per_page, &required_descr, encoding));
+
+    max_def_level_ = 4;
+    max_rep_level_ = 0;
+    NodePtr optional = schema::Int32("b", Repetition::OPTIONAL);
+    const ColumnDescriptor optional_descr(optional, max_def_level_, max_rep_level_);
+    ASSERT_NO_FATAL_FAILURE(
+        ExecuteSkip(num_pages, levels_per_page, &optional_descr, encoding));
+
+    max_def_level_ = 4;
+    max_rep_level_ = 2;
+    NodePtr repeated = schema::Int32("c", Repetition::REPEATED);
+    const ColumnDescriptor repeated_descr(repeated, max_def_level_, max_rep_level_);
+    ASSERT_NO_FATAL_FAILURE(
+        ExecuteSkip(num_pages, levels_per_page, &repeated_descr, encoding));
+  }
+}
+
+TEST_F(TestPrimitiveReader, TestInt32ReadFilter) {
+  int levels_per_page = 100;
+  int num_pages = 5;
+  for (auto encoding : {Encoding::PLAIN, Encoding::RLE_DICTIONARY}) {
+    max_def_level_ = 0;
+    max_rep_level_ = 0;
+    NodePtr required = schema::Int32("a", Repetition::REQUIRED);
+    const ColumnDescriptor required_descr(required, max_def_level_, max_rep_level_);
+    ASSERT_NO_FATAL_FAILURE(
+        ExecuteFilter(num_pages, levels_per_page, &required_descr, encoding));
+
+    max_def_level_ = 4;
+    max_rep_level_ = 0;
+    NodePtr optional = schema::Int32("b", Repetition::OPTIONAL);
+    const ColumnDescriptor optional_descr(optional, max_def_level_, max_rep_level_);
+    ASSERT_NO_FATAL_FAILURE(
+        ExecuteFilter(num_pages, levels_per_page, &optional_descr, encoding));
+  }
+
+  // Repeated columns and a missing predicate are rejected
+  max_def_level_ = 4;
+  max_rep_level_ = 2;
+  NodePtr repeated = schema::Int32("c", Repetition::REPEATED);
+  const ColumnDescriptor repeated_descr(repeated, max_def_level_, max_rep_level_);
+  MakePages<Int32Type>(&repeated_descr, num_pages, levels_per_page, def_levels_,
+                       rep_levels_, values_, data_buffer_, pages_);
+  InitReader(&repeated_descr);
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+  uint8_t selection[2];
+  int64_t num_selected = 0;
+  ASSERT_THROW(reader->ReadFilter(10, selection, 0, &num_selected), ParquetException);
+  reader->SetPredicate([](int32_t value) { return true; });
+  ASSERT_THROW(reader->ReadFilter(10, selection, 0, &num_selected), ParquetException);
+  Clear();
+}
+
 TEST_F(TestPrimitiveReader, TestDictionaryEncodedPages) {
   max_def_level_ = 0;
   max_rep_level_ = 0;
@@ -386,5 +633,32 @@ TEST_F(TestPrimitiveReader, TestDictionaryEncodedPages) {
   pages_.clear();
 }
 
+TEST(TestBitmap, CopyBitmap) {
+  const int num_bits = 64;
+  vector<uint8_t> data;
+  random_bytes(num_bits / 8, 0, &data);
+
+  // Every alignment of the source and destination, and lengths that do and do
+  // not span whole bytes
+  for (int offset = 0; offset < 9; ++offset) {
+    for (int dest_offset = 0; dest_offset < 9; ++dest_offset) {
+      for (int length = 0; length < num_bits - 8; length += 3) {
+        vector<uint8_t> dest(data.size() + 2, 0xA5);
+        const vector<uint8_t> original = dest;
+        internal::CopyBitmap(data.data(), offset, length, dest.data(), dest_offset);
+        for (int i = 0; i < static_cast<int>(dest.size()) * 8; ++i) {
+          bool expected = BitUtil::GetBit(original.data(), i);
+          if (i >= dest_offset && i < dest_offset + length) {
+            expected = BitUtil::GetBit(data.data(), offset + i - dest_offset);
+          }
+          ASSERT_EQ(expected, BitUtil::GetBit(dest.data(), i))
+              << "offset " << offset << ", dest_offset " << dest_offset << ", length "
+              << length << ", bit " << i;
+        }
+      }
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace parquet
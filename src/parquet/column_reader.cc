@@ -21,23 +21,104 @@
 #include <cstdint>
 #include <memory>
 
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
 #include <arrow/buffer.h>
 #include <arrow/memory_pool.h>
 #include <arrow/util/bit-util.h>
 #include <arrow/util/compression.h>
-#include <arrow/util/rle-encoding.h>
+#include <arrow/util/bit-stream-utils.h>
 
 #include "parquet/column_page.h"
 #include "parquet/encoding-internal.h"
 #include "parquet/parquet_types.h"
 #include "parquet/properties.h"
 #include "parquet/thrift.h"
+#include "parquet/util/bitmap-internal.h"
+#include "parquet/util/rle-internal.h"
 
 using arrow::MemoryPool;
 
 namespace parquet {
 
-LevelDecoder::LevelDecoder() : num_values_remaining_(0) {}
+namespace {
+
+// Bit i of the result is set if levels[i] == max_level, for i < 8
+inline uint8_t EqualityMask8(const int16_t* levels, int16_t max_level) {
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+  const __m128i equal =
+      _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(levels)),
+                      _mm_set1_epi16(max_level));
+  return static_cast<uint8_t>(
+      _mm_movemask_epi8(_mm_packs_epi16(equal, _mm_setzero_si128())));
+#else
+  uint8_t mask = 0;
+  for (int i = 0; i < 8; ++i) {
+    mask = static_cast<uint8_t>(mask | (levels[i] == max_level) << i);
+  }
+  return mask;
+#endif
+}
+
+// Write the 8 bits of mask to bitmap starting at bit offset, leaving the
+// surrounding bits untouched
+inline void WriteBits8(uint8_t* bitmap, int64_t offset, uint8_t mask) {
+  uint8_t* byte = bitmap + offset / 8;
+  const int shift = static_cast<int>(offset % 8);
+  if (shift == 0) {
+    *byte = mask;
+  } else {
+    const uint8_t low_bits = static_cast<uint8_t>((1 << shift) - 1);
+    byte[0] = static_cast<uint8_t>((byte[0] & low_bits) | (mask << shift));
+    byte[1] = static_cast<uint8_t>((byte[1] & ~low_bits) | (mask >> (8 - shift)));
+  }
+}
+
+// Set bit (offset + i) of bitmap if levels[i] == max_level and clear it
+// otherwise, eight levels at a time. Returns the number of bits set
+int64_t LevelsToBitmap(const int16_t* levels, int num_levels, int16_t max_level,
+                       uint8_t* bitmap, int64_t offset) {
+  int64_t num_set = 0;
+  int i = 0;
+  for (; i + 8 <= num_levels; i += 8) {
+    const uint8_t mask = EqualityMask8(levels + i, max_level);
+    WriteBits8(bitmap, offset + i, mask);
+    num_set += internal::PopCount8(mask);
+  }
+  for (; i < num_levels; ++i) {
+    const bool is_set = levels[i] == max_level;
+    ::arrow::BitUtil::SetBitTo(bitmap, offset + i, is_set);
+    num_set += is_set;
+  }
+  return num_set;
+}
+
+}  // namespace
+
+namespace internal {
+
+int64_t FlatDefinitionLevelsToBitmap(const int16_t* def_levels, int64_t num_def_levels,
+                                     int16_t max_definition_level, uint8_t* valid_bits,
+                                     int64_t valid_bits_offset) {
+  // A branch-free maximum, which the compiler vectorizes
+  int16_t max_level = 0;
+  for (int64_t i = 0; i < num_def_levels; ++i) {
+    max_level = std::max(max_level, def_levels[i]);
+  }
+  if (max_level > max_definition_level) {
+    throw ParquetException("definition level exceeds maximum");
+  }
+  const int64_t num_defined =
+      LevelsToBitmap(def_levels, static_cast<int>(num_def_levels), max_definition_level,
+                     valid_bits, valid_bits_offset);
+  return num_def_levels - num_defined;
+}
+
+}  // namespace internal
+
+LevelDecoder::LevelDecoder() : max_level_(0), num_values_remaining_(0) {}
 
 LevelDecoder::~LevelDecoder() {}
 
@@ -45,6 +126,7 @@ int LevelDecoder::SetData(Encoding::type encoding, int16_t max_level,
                           int num_buffered_values, const uint8_t* data) {
   int32_t num_bytes = 0;
   encoding_ = encoding;
+  max_level_ = max_level;
   num_values_remaining_ = num_buffered_values;
   bit_width_ = BitUtil::Log2(max_level + 1);
   switch (encoding) {
@@ -52,7 +134,7 @@ int LevelDecoder::SetData(Encoding::type encoding, int16_t max_level,
       num_bytes = *reinterpret_cast<const int32_t*>(data);
       const uint8_t* decoder_data = data + sizeof(int32_t);
       if (!rle_decoder_) {
-        rle_decoder_.reset(new ::arrow::RleDecoder(decoder_data, num_bytes, bit_width_));
+        rle_decoder_.reset(new RleRunDecoder(decoder_data, num_bytes, bit_width_));
       } else {
         rle_decoder_->Reset(decoder_data, num_bytes, bit_width_);
       }
@@ -87,6 +169,113 @@ int LevelDecoder::Decode(int batch_size, int16_t* levels) {
   return num_decoded;
 }
 
+int LevelDecoder::Decode(int batch_size, int16_t* levels, int64_t* num_max_levels) {
+  int num_decoded = 0;
+
+  int num_values = std::min(num_values_remaining_, batch_size);
+  if (encoding_ == Encoding::RLE) {
+    while (num_decoded < num_values && rle_decoder_->NextRun()) {
+      const bool is_repeated = rle_decoder_->is_repeated();
+      int num_run_values =
+          std::min(num_values - num_decoded, rle_decoder_->run_remaining());
+      num_run_values = rle_decoder_->GetBatch(levels + num_decoded, num_run_values);
+      if (num_run_values == 0) break;
+      if (is_repeated) {
+        if (levels[num_decoded] == max_level_) {
+          *num_max_levels += num_run_values;
+        }
+      } else {
+        *num_max_levels += std::count(levels + num_decoded,
+                                      levels + num_decoded + num_run_values, max_level_);
+      }
+      num_decoded += num_run_values;
+    }
+  } else {
+    num_decoded = bit_packed_decoder_->GetBatch(bit_width_, levels, num_values);
+    *num_max_levels += std::count(levels, levels + num_decoded, max_level_);
+  }
+  num_values_remaining_ -= num_decoded;
+  return num_decoded;
+}
+
+int LevelDecoder::DecodeToBitmap(int batch_size, uint8_t* valid_bits,
+                                 int64_t valid_bits_offset, int64_t* null_count) {
+  int16_t levels[kRleBatchBufferSize];
+  int num_decoded = 0;
+
+  int num_values = std::min(num_values_remaining_, batch_size);
+  while (num_decoded < num_values) {
+    int num_run_values = num_values - num_decoded;
+    if (encoding_ == Encoding::RLE) {
+      if (!rle_decoder_->NextRun()) break;
+      num_run_values = std::min(num_run_values, rle_decoder_->run_remaining());
+      if (rle_decoder_->is_repeated()) {
+        // Repeated runs are filled in bulk, however long they are
+        const bool is_valid =
+            rle_decoder_->repeated_value() == static_cast<uint64_t>(max_level_);
+        num_run_values = rle_decoder_->Skip(num_run_values);
+        internal::SetBitmapRange(valid_bits, valid_bits_offset + num_decoded,
+                                 num_run_values, is_valid);
+        if (!is_valid) {
+          *null_count += num_run_values;
+        }
+        num_decoded += num_run_values;
+        continue;
+      }
+      num_run_values =
+          rle_decoder_->GetBatch(levels, std::min(num_run_values, kRleBatchBufferSize));
+    } else {
+      num_run_values = bit_packed_decoder_->GetBatch(
+          bit_width_, levels, std::min(num_run_values, kRleBatchBufferSize));
+    }
+    if (num_run_values == 0) break;
+    *null_count += num_run_values - LevelsToBitmap(levels, num_run_values, max_level_,
+                                                   valid_bits,
+                                                   valid_bits_offset + num_decoded);
+    num_decoded += num_run_values;
+  }
+  num_values_remaining_ -= num_decoded;
+  return num_decoded;
+}
+
+int LevelDecoder::MaxLevelRunLength(int batch_size) {
+  if (encoding_ != Encoding::RLE || num_values_remaining_ == 0 ||
+      !rle_decoder_->NextRun() || !rle_decoder_->is_repeated() ||
+      rle_decoder_->repeated_value() != static_cast<uint64_t>(max_level_)) {
+    return 0;
+  }
+  return std::min(std::min(num_values_remaining_, batch_size),
+                  rle_decoder_->run_remaining());
+}
+
+int LevelDecoder::Skip(int batch_size, int64_t* num_max_levels) {
+  int num_skipped = 0;
+
+  int num_values = std::min(num_values_remaining_, batch_size);
+  if (encoding_ == Encoding::RLE) {
+    if (num_max_levels == nullptr) {
+      num_skipped = rle_decoder_->Skip(num_values);
+    } else {
+      num_skipped = rle_decoder_->SkipAndCount(num_values, max_level_, num_max_levels);
+    }
+  } else {
+    // BIT_PACKED levels have no runs to take advantage of
+    static constexpr int kSkipBatchSize = 1024;
+    int16_t levels[kSkipBatchSize];
+    while (num_skipped < num_values) {
+      int batch = std::min(num_values - num_skipped, kSkipBatchSize);
+      int num_decoded = bit_packed_decoder_->GetBatch(bit_width_, levels, batch);
+      if (num_max_levels != nullptr) {
+        *num_max_levels += std::count(levels, levels + num_decoded, max_level_);
+      }
+      num_skipped += num_decoded;
+      if (num_decoded < batch) break;
+    }
+  }
+  num_values_remaining_ -= num_skipped;
+  return num_skipped;
+}
+
 ReaderProperties default_reader_properties() {
   static ReaderProperties default_reader_properties;
   return default_reader_properties;
@@ -104,6 +293,8 @@ class SerializedPageReader : public PageReader {
   SerializedPageReader(std::unique_ptr<InputStream> stream, int64_t total_num_rows,
                        Compression::type codec, ::arrow::MemoryPool* pool)
       : stream_(std::move(stream)),
+        current_page_header_size_(0),
+        has_pending_header_(false),
         decompression_buffer_(AllocateBuffer(pool, 0)),
         seen_num_rows_(0),
         total_num_rows_(total_num_rows) {
@@ -114,12 +305,29 @@ class SerializedPageReader : public PageReader {
   // Implement the PageReader interface
   std::shared_ptr<Page> NextPage() override;
 
+  int64_t SkipDataPages(int64_t max_values) override;
+
+  bool SkipPage(PageHeaderInfo* info) override;
+
+  bool PeekPage(PageHeaderInfo* info) override;
+
   void set_max_page_header_size(uint32_t size) override { max_page_header_size_ = size; }
 
  private:
+  // Deserialize the next page header into current_page_header_ and advance the
+  // stream past it. Returns false at the end of the stream
+  bool ReadPageHeader();
+
+  // Describe the page of current_page_header_
+  void GetPageHeaderInfo(PageHeaderInfo* info) const;
+
   std::unique_ptr<InputStream> stream_;
 
   format::PageHeader current_page_header_;
+  // Serialized size of current_page_header_
+  uint32_t current_page_header_size_;
+  // True if current_page_header_ has been read but its page has not
+  bool has_pending_header_;
   std::shared_ptr<Page> current_page_;
 
   // Compression codec to use.
@@ -136,43 +344,143 @@ class SerializedPageReader : public PageReader {
   int64_t total_num_rows_;
 };
 
+bool SerializedPageReader::ReadPageHeader() {
+  int64_t bytes_available = 0;
+  uint32_t header_size = 0;
+  const uint8_t* buffer;
+  uint32_t allowed_page_size = kDefaultPageHeaderSize;
+
+  // Page headers can be very large because of page statistics
+  // We try to deserialize a larger buffer progressively
+  // until a maximum allowed header limit
+  while (true) {
+    buffer = stream_->Peek(allowed_page_size, &bytes_available);
+    if (bytes_available == 0) {
+      return false;
+    }
+
+    // This gets used, then set by DeserializeThriftMsg
+    header_size = static_cast<uint32_t>(bytes_available);
+    try {
+      DeserializeThriftMsg(buffer, &header_size, &current_page_header_);
+      break;
+    } catch (std::exception& e) {
+      // Failed to deserialize. Double the allowed page header size and try again
+      std::stringstream ss;
+      ss << e.what();
+      allowed_page_size *= 2;
+      if (allowed_page_size > max_page_header_size_) {
+        ss << "Deserializing page header failed.\n";
+        throw ParquetException(ss.str());
+      }
+    }
+  }
+  // Advance the stream offset
+  stream_->Advance(header_size);
+  current_page_header_size_ = header_size;
+  return true;
+}
+
+void SerializedPageReader::GetPageHeaderInfo(PageHeaderInfo* info) const {
+  info->encoding = Encoding::PLAIN;
+  info->size = current_page_header_size_ + current_page_header_.compressed_page_size;
+  info->num_values = 0;
+  info->num_rows = -1;
+  switch (current_page_header_.type) {
+    case format::PageType::DATA_PAGE:
+      info->type = PageType::DATA_PAGE;
+      info->encoding = FromThrift(current_page_header_.data_page_header.encoding);
+      info->num_values = current_page_header_.data_page_header.num_values;
+      break;
+    case format::PageType::DATA_PAGE_V2:
+      info->type = PageType::DATA_PAGE_V2;
+      info->encoding = FromThrift(current_page_header_.data_page_header_v2.encoding);
+      info->num_values = current_page_header_.data_page_header_v2.num_values;
+      info->num_rows = current_page_header_.data_page_header_v2.num_rows;
+      break;
+    case format::PageType::DICTIONARY_PAGE:
+      info->type = PageType::DICTIONARY_PAGE;
+      info->encoding = FromThrift(current_page_header_.dictionary_page_header.encoding);
+      break;
+    default:
+      info->type = PageType::INDEX_PAGE;
+      break;
+  }
+}
+
+bool SerializedPageReader::SkipPage(PageHeaderInfo* info) {
+  if (seen_num_rows_ >= total_num_rows_) {
+    return false;
+  }
+  if (!has_pending_header_ && !ReadPageHeader()) {
+    return false;
+  }
+  has_pending_header_ = false;
+
+  GetPageHeaderInfo(info);
+  stream_->Advance(current_page_header_.compressed_page_size);
+  seen_num_rows_ += info->num_values;
+  return true;
+}
+
+bool SerializedPageReader::PeekPage(PageHeaderInfo* info) {
+  if (seen_num_rows_ >= total_num_rows_) {
+    return false;
+  }
+  if (!has_pending_header_) {
+    if (!ReadPageHeader()) {
+      return false;
+    }
+    has_pending_header_ = true;
+  }
+  GetPageHeaderInfo(info);
+  return true;
+}
+
+int64_t SerializedPageReader::SkipDataPages(int64_t max_values) {
+  int64_t values_skipped = 0;
+  while (seen_num_rows_ < total_num_rows_) {
+    if (!has_pending_header_) {
+      if (!ReadPageHeader()) {
+        break;
+      }
+      has_pending_header_ = true;
+    }
+
+    int64_t num_values = 0;
+    if (current_page_header_.type == format::PageType::DATA_PAGE) {
+      num_values = current_page_header_.data_page_header.num_values;
+    } else if (current_page_header_.type == format::PageType::DATA_PAGE_V2) {
+      num_values = current_page_header_.data_page_header_v2.num_values;
+    } else {
+      // Dictionary and unknown pages are left to NextPage
+      break;
+    }
+    if (values_skipped + num_values > max_values) {
+      break;
+    }
+
+    stream_->Advance(current_page_header_.compressed_page_size);
+    has_pending_header_ = false;
+    seen_num_rows_ += num_values;
+    values_skipped += num_values;
+  }
+  return values_skipped;
+}
+
 std::shared_ptr<Page> SerializedPageReader::NextPage() {
   // Loop here because there may be unhandled page types that we skip until
   // finding a page that we do know what to do with
   while (seen_num_rows_ < total_num_rows_) {
     int64_t bytes_read = 0;
-    int64_t bytes_available = 0;
-    uint32_t header_size = 0;
     const uint8_t* buffer;
-    uint32_t allowed_page_size = kDefaultPageHeaderSize;
-
-    // Page headers can be very large because of page statistics
-    // We try to deserialize a larger buffer progressively
-    // until a maximum allowed header limit
-    while (true) {
-      buffer = stream_->Peek(allowed_page_size, &bytes_available);
-      if (bytes_available == 0) {
-        return std::shared_ptr<Page>(nullptr);
-      }
 
-      // This gets used, then set by DeserializeThriftMsg
-      header_size = static_cast<uint32_t>(bytes_available);
-      try {
-        DeserializeThriftMsg(buffer, &header_size, &current_page_header_);
-        break;
-      } catch (std::exception& e) {
-        // Failed to deserialize. Double the allowed page header size and try again
-        std::stringstream ss;
-        ss << e.what();
-        allowed_page_size *= 2;
-        if (allowed_page_size > max_page_header_size_) {
-          ss << "Deserializing page header failed.\n";
-          throw ParquetException(ss.str());
-        }
-      }
+    // The header of the next page may already have been read by SkipDataPages
+    // or PeekPage
+    if (!has_pending_header_ && !ReadPageHeader()) {
+      return std::shared_ptr<Page>(nullptr);
     }
-    // Advance the stream offset
-    stream_->Advance(header_size);
+    has_pending_header_ = false;
 
     int compressed_len = current_page_header_.compressed_page_size;
     int uncompressed_len = current_page_header_.uncompressed_page_size;
@@ -254,6 +562,11 @@ std::shared_ptr<Page> SerializedPageReader::NextPage() {
   return std::shared_ptr<Page>(nullptr);
 }
 
+bool PageReader::SkipPage(PageHeaderInfo* info) {
+  ParquetException::NYI("SkipPage is not supported by this page reader");
+  return false;
+}
+
 std::unique_ptr<PageReader> PageReader::Open(std::unique_ptr<InputStream> stream,
                                              int64_t total_num_rows,
                                              Compression::type codec,
@@ -306,6 +619,27 @@ void TypedColumnReader<DType>::ConfigureDictionary(const DictionaryPage* page) {
   }
 
   current_decoder_ = decoders_[encoding].get();
+  EvaluateDictionaryPredicate();
+}
+
+template <typename DType>
+void TypedColumnReader<DType>::EvaluateDictionaryPredicate() {
+  dictionary_may_match_ = true;
+  auto it = decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+  if (!predicate_ || it == decoders_.end()) {
+    return;
+  }
+  auto decoder = static_cast<DictionaryDecoder<DType>*>(it->second.get());
+  const T* dictionary = decoder->dictionary();
+  const int dictionary_length = decoder->dictionary_length();
+
+  dictionary_matches_.resize(dictionary_length);
+  dictionary_may_match_ = false;
+  for (int i = 0; i < dictionary_length; ++i) {
+    const bool match = predicate_(dictionary[i]);
+    dictionary_matches_[i] = match ? 1 : 0;
+    dictionary_may_match_ = dictionary_may_match_ || match;
+  }
 }
 
 // PLAIN_DICTIONARY is deprecated but used to be used as a dictionary index
@@ -413,6 +747,183 @@ bool TypedColumnReader<DType>::ReadNewPage() {
   return true;
 }
 
+// ----------------------------------------------------------------------
+// Filtered scan
+
+// Number of rows of a data page evaluated at a time by ReadFilter
+static constexpr int64_t kFilterBatchSize = 1024;
+
+template <typename DType>
+void TypedColumnReader<DType>::SetPredicate(const Predicate& predicate) {
+  predicate_ = predicate;
+  EvaluateDictionaryPredicate();
+}
+
+template <typename DType>
+bool TypedColumnReader<DType>::DictionaryMayMatch() {
+  // The dictionary page precedes the first data page
+  HasNext();
+  return dictionary_may_match_;
+}
+
+// Clear length bits of selection from bit offset
+static void ClearSelection(uint8_t* selection, int64_t offset, int64_t length) {
+  ::arrow::internal::BitmapWriter selection_writer(selection, offset, length);
+  for (int64_t i = 0; i < length; ++i) {
+    selection_writer.Clear();
+    selection_writer.Next();
+  }
+  selection_writer.Finish();
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::SkipUnmatchedPage(int64_t max_rows) {
+  if (available_values_current_page() > 0 ||
+      (current_page_ != nullptr && dictionary_may_match_)) {
+    return 0;
+  }
+  PageHeaderInfo info;
+  if (!pager_->PeekPage(&info)) {
+    return 0;
+  }
+  if (current_page_ == nullptr && info.type == PageType::DICTIONARY_PAGE) {
+    // Whether the data pages can be skipped depends on the dictionary
+    current_page_ = pager_->NextPage();
+    ConfigureDictionary(static_cast<const DictionaryPage*>(current_page_.get()));
+    if (dictionary_may_match_ || !pager_->PeekPage(&info)) {
+      return 0;
+    }
+  }
+  // Fallback pages and pages that do not fit in the batch are left to
+  // ReadFilterPage
+  if (dictionary_may_match_ || info.num_values > max_rows ||
+      (info.type != PageType::DATA_PAGE && info.type != PageType::DATA_PAGE_V2) ||
+      !IsDictionaryIndexEncoding(info.encoding)) {
+    return 0;
+  }
+  pager_->SkipPage(&info);
+  return info.num_values;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadFilter(int64_t batch_size, uint8_t* selection,
+                                           int64_t selection_offset,
+                                           int64_t* num_selected) {
+  if (!predicate_) {
+    throw ParquetException("ReadFilter requires a predicate");
+  }
+  if (descr_->max_repetition_level() > 0) {
+    throw ParquetException("ReadFilter is only supported for non-repeated columns");
+  }
+
+  *num_selected = 0;
+  int64_t rows_read = 0;
+  while (rows_read < batch_size) {
+    const int64_t rows_skipped = SkipUnmatchedPage(batch_size - rows_read);
+    if (rows_skipped > 0) {
+      ClearSelection(selection, selection_offset + rows_read, rows_skipped);
+      rows_read += rows_skipped;
+      continue;
+    }
+    if (!HasNext()) {
+      break;
+    }
+    const int64_t batch_rows =
+        std::min(batch_size - rows_read, available_values_current_page());
+    *num_selected +=
+        ReadFilterPage(batch_rows, selection, selection_offset + rows_read);
+    rows_read += batch_rows;
+  }
+  return rows_read;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadFilterPage(int64_t batch_size, uint8_t* selection,
+                                                 int64_t selection_offset) {
+  const int16_t max_definition_level = descr_->max_definition_level();
+  DictionaryDecoder<DType>* dictionary_decoder = nullptr;
+  if (current_decoder_->encoding() == Encoding::RLE_DICTIONARY) {
+    dictionary_decoder = static_cast<DictionaryDecoder<DType>*>(current_decoder_);
+  }
+
+  if (dictionary_decoder != nullptr && !dictionary_may_match_) {
+    // No value of this page can match. Unless the rest of the page is dropped,
+    // the decoders still have to be advanced past the rows
+    if (batch_size < available_values_current_page()) {
+      int64_t values_to_skip = batch_size;
+      if (max_definition_level > 0) {
+        values_to_skip = 0;
+        SkipDefinitionLevels(batch_size, &values_to_skip);
+      }
+      dictionary_decoder->Skip(static_cast<int>(values_to_skip));
+    }
+    ConsumeBufferedValues(batch_size);
+    ClearSelection(selection, selection_offset, batch_size);
+    return 0;
+  }
+
+  ::arrow::internal::BitmapWriter selection_writer(selection, selection_offset,
+                                                   batch_size);
+
+  int16_t def_levels[kFilterBatchSize];
+  uint8_t matches[kFilterBatchSize];
+  T values[kFilterBatchSize];
+
+  int64_t num_selected = 0;
+  int64_t rows_read = 0;
+  while (rows_read < batch_size) {
+    const int64_t batch_rows = std::min(batch_size - rows_read, kFilterBatchSize);
+
+    int64_t num_values = batch_rows;
+    bool all_defined = true;
+    if (max_definition_level > 0) {
+      // Rows within a run of non-null values need no levels at all
+      if (definition_level_decoder_.MaxLevelRunLength(static_cast<int>(batch_rows)) ==
+          batch_rows) {
+        definition_level_decoder_.Skip(static_cast<int>(batch_rows));
+      } else {
+        num_values = 0;
+        ReadDefinitionLevels(batch_rows, def_levels, &num_values);
+        all_defined = num_values == batch_rows;
+      }
+    }
+
+    int values_decoded;
+    if (dictionary_decoder != nullptr) {
+      values_decoded = dictionary_decoder->DecodeMatches(
+          dictionary_matches_.data(), matches, static_cast<int>(num_values));
+    } else {
+      values_decoded = current_decoder_->Decode(values, static_cast<int>(num_values));
+      for (int i = 0; i < values_decoded; ++i) {
+        matches[i] = predicate_(values[i]) ? 1 : 0;
+      }
+    }
+    if (values_decoded != num_values) {
+      ParquetException::EofException();
+    }
+
+    int64_t value_index = 0;
+    for (int64_t i = 0; i < batch_rows; ++i) {
+      if (all_defined || def_levels[i] == max_definition_level) {
+        if (matches[value_index++]) {
+          selection_writer.Set();
+          ++num_selected;
+        } else {
+          selection_writer.Clear();
+        }
+      } else {
+        selection_writer.Clear();
+      }
+      selection_writer.Next();
+    }
+
+    ConsumeBufferedValues(batch_rows);
+    rows_read += batch_rows;
+  }
+  selection_writer.Finish();
+  return num_selected;
+}
+
 // ----------------------------------------------------------------------
 // Batch read APIs
 
@@ -423,6 +934,15 @@ int64_t ColumnReader::ReadDefinitionLevels(int64_t batch_size, int16_t* levels)
   return definition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
 }
 
+int64_t ColumnReader::ReadDefinitionLevels(int64_t batch_size, int16_t* levels,
+                                           int64_t* values_to_read) {
+  if (descr_->max_definition_level() == 0) {
+    return 0;
+  }
+  return definition_level_decoder_.Decode(static_cast<int>(batch_size), levels,
+                                          values_to_read);
+}
+
 int64_t ColumnReader::ReadRepetitionLevels(int64_t batch_size, int16_t* levels) {
   if (descr_->max_repetition_level() == 0) {
     return 0;
@@ -430,6 +950,20 @@ int64_t ColumnReader::ReadRepetitionLevels(int64_t batch_size, int16_t* levels)
   return repetition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
 }
 
+int64_t ColumnReader::SkipDefinitionLevels(int64_t batch_size, int64_t* values_to_skip) {
+  if (descr_->max_definition_level() == 0) {
+    return 0;
+  }
+  return definition_level_decoder_.Skip(static_cast<int>(batch_size), values_to_skip);
+}
+
+int64_t ColumnReader::SkipRepetitionLevels(int64_t batch_size) {
+  if (descr_->max_repetition_level() == 0) {
+    return 0;
+  }
+  return repetition_level_decoder_.Skip(static_cast<int>(batch_size));
+}
+
 // ----------------------------------------------------------------------
 // Dynamic column reader constructor
 
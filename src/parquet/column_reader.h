@@ -22,6 +22,7 @@
 #include <climits>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <unordered_map>
@@ -43,12 +44,13 @@
 namespace arrow {
 
 class BitReader;
-class RleDecoder;
 
 }  // namespace arrow
 
 namespace parquet {
 
+class RleRunDecoder;
+
 // 16 MB is the default maximum page header size
 static constexpr uint32_t kDefaultMaxPageHeaderSize = 16 * 1024 * 1024;
 
@@ -70,14 +72,55 @@ class PARQUET_EXPORT LevelDecoder {
   // Decodes a batch of levels into an array and returns the number of levels decoded
   int Decode(int batch_size, int16_t* levels);
 
+  // Like Decode, but also adds the number of decoded levels equal to max_level
+  // (for definition levels, the number of non-null values) to *num_max_levels.
+  // RLE repeated runs are counted as a whole instead of scanning the levels
+  int Decode(int batch_size, int16_t* levels, int64_t* num_max_levels);
+
+  // Decodes a batch of definition levels of a non-repeated column, where each
+  // level is a value slot, straight into a validity bitmap: bit
+  // (valid_bits_offset + i) is set if level i equals max_level and cleared
+  // otherwise. Adds the number of cleared bits to *null_count and returns the
+  // number of levels decoded
+  int DecodeToBitmap(int batch_size, uint8_t* valid_bits, int64_t valid_bits_offset,
+                     int64_t* null_count);
+
+  // Returns the number of levels, up to batch_size, that follow in a single RLE
+  // repeated run of max_level, i.e. that are known to be non-null without
+  // decoding them. Returns 0 if the next level is not in such a run, and always
+  // for BIT_PACKED levels. Does not advance the decoder
+  int MaxLevelRunLength(int batch_size);
+
+  // Advances over a batch of levels without materializing them and returns the
+  // number of levels skipped. If num_max_levels is not null, the number of
+  // skipped levels equal to max_level (for definition levels, the number of
+  // non-null values) is added to it.
+  int Skip(int batch_size, int64_t* num_max_levels = nullptr);
+
  private:
   int bit_width_;
+  int16_t max_level_;
   int num_values_remaining_;
   Encoding::type encoding_;
-  std::unique_ptr<::arrow::RleDecoder> rle_decoder_;
+  std::unique_ptr<RleRunDecoder> rle_decoder_;
   std::unique_ptr<::arrow::BitReader> bit_packed_decoder_;
 };
 
+// Type and size of a page, as read from its header
+struct PARQUET_EXPORT PageHeaderInfo {
+  PageType::type type;
+  // Encoding of the values of a data page or of the entries of a dictionary
+  // page, PLAIN for other pages
+  Encoding::type encoding;
+  // Size of the page header and the compressed page in bytes
+  int64_t size;
+  // Number of values (levels) of a data page, 0 for other pages
+  int64_t num_values;
+  // Number of rows of a data page if its header records it (DATA_PAGE_V2),
+  // -1 otherwise
+  int64_t num_rows;
+};
+
 // Abstract page iterator interface. This way, we can feed column pages to the
 // ColumnReader through whatever mechanism we choose
 class PARQUET_EXPORT PageReader {
@@ -93,6 +136,26 @@ class PARQUET_EXPORT PageReader {
   // containing new Page otherwise
   virtual std::shared_ptr<Page> NextPage() = 0;
 
+  // Skip the data pages that follow without decompressing them, as long as
+  // they hold no more than max_values values (levels) in total. Stops at the
+  // first dictionary page. The default implementation does not skip anything
+  //
+  // @returns: the number of values skipped
+  virtual int64_t SkipDataPages(int64_t max_values) { return 0; }
+
+  // Skip the next page, whatever its type, without decompressing it and
+  // describe it in *info. Not supported by the default implementation
+  //
+  // @returns: false on EOS
+  virtual bool SkipPage(PageHeaderInfo* info);
+
+  // Read the header of the next page and describe the page in *info, leaving
+  // it to the following call to NextPage or SkipPage. The default
+  // implementation cannot look ahead
+  //
+  // @returns: false on EOS or if the page reader cannot look ahead
+  virtual bool PeekPage(PageHeaderInfo* info) { return false; }
+
   virtual void set_max_page_header_size(uint32_t size) = 0;
 };
 
@@ -130,10 +193,26 @@ class PARQUET_EXPORT ColumnReader {
   // Returns the number of decoded definition levels
   int64_t ReadDefinitionLevels(int64_t batch_size, int16_t* levels);
 
+  // Read multiple definition levels into preallocated memory, adding the number
+  // of non-null values among them to *values_to_read
+  //
+  // Returns the number of decoded definition levels
+  int64_t ReadDefinitionLevels(int64_t batch_size, int16_t* levels,
+                               int64_t* values_to_read);
+
   // Read multiple repetition levels into preallocated memory
   // Returns the number of decoded repetition levels
   int64_t ReadRepetitionLevels(int64_t batch_size, int16_t* levels);
 
+  // Skip multiple definition levels, adding the number of non-null values among
+  // them to *values_to_skip
+  // Returns the number of skipped definition levels
+  int64_t SkipDefinitionLevels(int64_t batch_size, int64_t* values_to_skip);
+
+  // Skip multiple repetition levels
+  // Returns the number of skipped repetition levels
+  int64_t SkipRepetitionLevels(int64_t batch_size);
+
   int64_t available_values_current_page() const {
     return num_buffered_values_ - num_decoded_values_;
   }
@@ -168,6 +247,55 @@ class PARQUET_EXPORT ColumnReader {
 
 namespace internal {
 
+// Set or clear the length bits of bitmap starting at bit offset, whole bytes
+// at a time where possible
+static inline void SetBitmapRange(uint8_t* bitmap, int64_t offset, int64_t length,
+                                  bool value) {
+  int64_t i = offset;
+  const int64_t end = offset + length;
+  for (; i < end && i % 8 != 0; ++i) {
+    ::arrow::BitUtil::SetBitTo(bitmap, i, value);
+  }
+  const int64_t num_bytes = (end - i) / 8;
+  if (num_bytes > 0) {
+    memset(bitmap + i / 8, value ? 0xFF : 0, static_cast<size_t>(num_bytes));
+    i += num_bytes * 8;
+  }
+  for (; i < end; ++i) {
+    ::arrow::BitUtil::SetBitTo(bitmap, i, value);
+  }
+}
+
+// Copy the length bits of data starting at bit offset to dest starting at bit
+// dest_offset, whole bytes of dest at a time where possible. Only the bytes of
+// dest holding bits of the range are written, so ranges of dest that share no
+// byte can be written concurrently
+static inline void CopyBitmap(const uint8_t* data, int64_t offset, int64_t length,
+                              uint8_t* dest, int64_t dest_offset) {
+  for (; length > 0 && dest_offset % 8 != 0; --length) {
+    ::arrow::BitUtil::SetBitTo(dest, dest_offset++,
+                               ::arrow::BitUtil::GetBit(data, offset++));
+  }
+  const int64_t num_bytes = length / 8;
+  const uint8_t* in = data + offset / 8;
+  uint8_t* out = dest + dest_offset / 8;
+  const int shift = static_cast<int>(offset % 8);
+  if (shift == 0) {
+    memcpy(out, in, static_cast<size_t>(num_bytes));
+  } else {
+    for (int64_t i = 0; i < num_bytes; ++i) {
+      out[i] = static_cast<uint8_t>((in[i] >> shift) | (in[i + 1] << (8 - shift)));
+    }
+  }
+  offset += num_bytes * 8;
+  dest_offset += num_bytes * 8;
+  length -= num_bytes * 8;
+  for (; length > 0; --length) {
+    ::arrow::BitUtil::SetBitTo(dest, dest_offset++,
+                               ::arrow::BitUtil::GetBit(data, offset++));
+  }
+}
+
 static inline void DefinitionLevelsToBitmap(
     const int16_t* def_levels, int64_t num_def_levels, const int16_t max_definition_level,
     const int16_t max_repetition_level, int64_t* values_read, int64_t* null_count,
@@ -205,6 +333,43 @@ static inline void DefinitionLevelsToBitmap(
   *values_read = valid_bits_writer.position();
 }
 
+// DefinitionLevelsToBitmap for non-repeated columns, where each level is a
+// value slot, eight levels at a time. Returns the number of nulls
+int64_t PARQUET_EXPORT FlatDefinitionLevelsToBitmap(const int16_t* def_levels,
+                                                    int64_t num_def_levels,
+                                                    int16_t max_definition_level,
+                                                    uint8_t* valid_bits,
+                                                    int64_t valid_bits_offset);
+
+// TODO(itaiin): another code path split to merge when the general case is done
+static inline bool HasSpacedValues(const ColumnDescriptor* descr) {
+  if (descr->max_repetition_level() > 0) {
+    // repeated+flat case
+    return !descr->schema_node()->is_required();
+  } else {
+    // non-repeated+nested case
+    // Find if a node forces nulls in the lowest level along the hierarchy
+    const schema::Node* node = descr->schema_node().get();
+    while (node) {
+      if (node->is_optional()) {
+        return true;
+      }
+      node = node->parent();
+    }
+    return false;
+  }
+}
+
+// Repetition of the column as a whole, which determines the levels it has:
+// REQUIRED columns have none, OPTIONAL ones only definition levels and
+// REPEATED ones both
+static inline Repetition::type ColumnRepetition(const ColumnDescriptor* descr) {
+  if (descr->max_repetition_level() > 0) {
+    return Repetition::REPEATED;
+  }
+  return descr->max_definition_level() > 0 ? Repetition::OPTIONAL : Repetition::REQUIRED;
+}
+
 }  // namespace internal
 
 // API to read values from a single column. This is a main client facing API.
@@ -215,7 +380,11 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
 
   TypedColumnReader(const ColumnDescriptor* schema, std::unique_ptr<PageReader> pager,
                     ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
-      : ColumnReader(schema, std::move(pager), pool), current_decoder_(nullptr) {}
+      : ColumnReader(schema, std::move(pager), pool),
+        column_repetition_(internal::ColumnRepetition(schema)),
+        has_spaced_values_(internal::HasSpacedValues(schema)),
+        current_decoder_(nullptr),
+        dictionary_may_match_(true) {}
 
   // Read a batch of repetition levels, definition levels, and values from the
   // column.
@@ -280,12 +449,80 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
   // Returns the number of levels skipped
   int64_t Skip(int64_t num_rows_to_skip);
 
+  // Predicate on a single non-null value, see SetPredicate
+  typedef std::function<bool(const T&)> Predicate;
+
+  /// \brief Set the predicate evaluated by ReadFilter.
+  ///
+  /// For dictionary-encoded column chunks the predicate is evaluated once per
+  /// dictionary entry when the dictionary page is read. Dictionary-encoded data
+  /// pages are then filtered by testing their indices, without looking up or
+  /// materializing any value.
+  void SetPredicate(const Predicate& predicate);
+
+  /// \brief Return false if the column chunk has a dictionary of which no entry
+  /// satisfies the predicate, in which case no dictionary-encoded data page of
+  /// the chunk can contain a matching value. Reads the dictionary page if no
+  /// page has been read yet.
+  ///
+  /// Pages written with a fallback encoding after the dictionary grew too large
+  /// are not covered, so a column chunk can only be skipped as a whole if the
+  /// caller knows that it is entirely dictionary-encoded.
+  bool DictionaryMayMatch();
+
+  /// \brief Evaluate the predicate on the next batch_size rows of a
+  /// non-repeated column and set bit (selection_offset + i) of selection if
+  /// row i is non-null and satisfies the predicate, and clear it otherwise.
+  ///
+  /// Unlike ReadBatch this continues across data pages. Dictionary-encoded
+  /// pages of a chunk whose dictionary has no matching entry are dropped as a
+  /// whole without decoding their levels or values. If the page reader can
+  /// look ahead at page headers (see PageReader::PeekPage), those that fit in
+  /// the batch are skipped from their header, without being decompressed.
+  ///
+  /// @param batch_size the number of rows to evaluate
+  /// @param[out] selection bitmap with space for batch_size bits after
+  ///   selection_offset
+  /// @param selection_offset the offset in bits of the first row
+  /// @param[out] num_selected the number of rows that satisfy the predicate
+  /// @returns: the number of rows evaluated, less than batch_size only at the
+  ///   end of the column chunk
+  int64_t ReadFilter(int64_t batch_size, uint8_t* selection, int64_t selection_offset,
+                     int64_t* num_selected);
+
  private:
   typedef Decoder<DType> DecoderType;
 
+  // Evaluate the predicate on each entry of the dictionary, if both are set
+  void EvaluateDictionaryPredicate();
+
+  // If the current data page is exhausted and no dictionary entry matches the
+  // predicate, skip the next data page without decompressing it, provided it
+  // is dictionary-encoded and has at most max_rows rows. Reads the dictionary
+  // page first if no page has been read yet
+  //
+  // @returns: the number of rows skipped, 0 if the page was not skipped
+  int64_t SkipUnmatchedPage(int64_t max_rows);
+
+  // Evaluate the predicate on the next batch_size rows of the current data page
+  int64_t ReadFilterPage(int64_t batch_size, uint8_t* selection,
+                         int64_t selection_offset);
+
   // Advance to the next data page
   bool ReadNewPage() override;
 
+  // ReadBatch and ReadBatchSpaced for a column_repetition_ known at compile
+  // time, so that the checks of the levels the column has fold away
+  template <Repetition::type repetition>
+  int64_t ReadBatchInternal(int64_t batch_size, int16_t* def_levels, int16_t* rep_levels,
+                            T* values, int64_t* values_read);
+
+  template <Repetition::type repetition>
+  int64_t ReadBatchSpacedInternal(int64_t batch_size, int16_t* def_levels,
+                                  int16_t* rep_levels, T* values, uint8_t* valid_bits,
+                                  int64_t valid_bits_offset, int64_t* levels_read,
+                                  int64_t* values_read, int64_t* null_count);
+
   // Read up to batch_size values from the current data page into the
   // pre-allocated memory T*
   //
@@ -307,7 +544,18 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
 
   void ConfigureDictionary(const DictionaryPage* page);
 
+  // The read paths are dispatched once per call on these, see
+  // internal::ColumnRepetition and internal::HasSpacedValues
+  const Repetition::type column_repetition_;
+  const bool has_spaced_values_;
+
   DecoderType* current_decoder_;
+
+  Predicate predicate_;
+
+  // For each dictionary entry, 1 if it satisfies the predicate, 0 otherwise
+  std::vector<uint8_t> dictionary_matches_;
+  bool dictionary_may_match_;
 };
 
 // ----------------------------------------------------------------------
@@ -334,6 +582,25 @@ inline int64_t TypedColumnReader<DType>::ReadBatch(int64_t batch_size,
                                                    int16_t* def_levels,
                                                    int16_t* rep_levels, T* values,
                                                    int64_t* values_read) {
+  switch (column_repetition_) {
+    case Repetition::REQUIRED:
+      return ReadBatchInternal<Repetition::REQUIRED>(batch_size, def_levels, rep_levels,
+                                                     values, values_read);
+    case Repetition::OPTIONAL:
+      return ReadBatchInternal<Repetition::OPTIONAL>(batch_size, def_levels, rep_levels,
+                                                     values, values_read);
+    default:
+      return ReadBatchInternal<Repetition::REPEATED>(batch_size, def_levels, rep_levels,
+                                                     values, values_read);
+  }
+}
+
+template <typename DType>
+template <Repetition::type repetition>
+inline int64_t TypedColumnReader<DType>::ReadBatchInternal(int64_t batch_size,
+                                                           int16_t* def_levels,
+                                                           int16_t* rep_levels, T* values,
+                                                           int64_t* values_read) {
   // HasNext invokes ReadNewPage
   if (!HasNext()) {
     *values_read = 0;
@@ -350,22 +617,15 @@ inline int64_t TypedColumnReader<DType>::ReadBatch(int64_t batch_size,
   int64_t values_to_read = 0;
 
   // If the field is required and non-repeated, there are no definition levels
-  if (descr_->max_definition_level() > 0 && def_levels) {
-    num_def_levels = ReadDefinitionLevels(batch_size, def_levels);
-    // TODO(wesm): this tallying of values-to-decode can be performed with better
-    // cache-efficiency if fused with the level decoding.
-    for (int64_t i = 0; i < num_def_levels; ++i) {
-      if (def_levels[i] == descr_->max_definition_level()) {
-        ++values_to_read;
-      }
-    }
+  if (repetition != Repetition::REQUIRED && def_levels) {
+    num_def_levels = ReadDefinitionLevels(batch_size, def_levels, &values_to_read);
   } else {
     // Required field, read all values
     values_to_read = batch_size;
   }
 
   // Not present for non-repeated fields
-  if (descr_->max_repetition_level() > 0 && rep_levels) {
+  if (repetition == Repetition::REPEATED && rep_levels) {
     num_rep_levels = ReadRepetitionLevels(batch_size, rep_levels);
     if (def_levels && num_def_levels != num_rep_levels) {
       throw ParquetException("Number of decoded rep / def levels did not match");
@@ -379,31 +639,30 @@ inline int64_t TypedColumnReader<DType>::ReadBatch(int64_t batch_size,
   return total_values;
 }
 
-namespace internal {
-
-// TODO(itaiin): another code path split to merge when the general case is done
-static inline bool HasSpacedValues(const ColumnDescriptor* descr) {
-  if (descr->max_repetition_level() > 0) {
-    // repeated+flat case
-    return !descr->schema_node()->is_required();
-  } else {
-    // non-repeated+nested case
-    // Find if a node forces nulls in the lowest level along the hierarchy
-    const schema::Node* node = descr->schema_node().get();
-    while (node) {
-      if (node->is_optional()) {
-        return true;
-      }
-      node = node->parent();
-    }
-    return false;
+template <typename DType>
+inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
+    int64_t batch_size, int16_t* def_levels, int16_t* rep_levels, T* values,
+    uint8_t* valid_bits, int64_t valid_bits_offset, int64_t* levels_read,
+    int64_t* values_read, int64_t* null_count_out) {
+  switch (column_repetition_) {
+    case Repetition::REQUIRED:
+      return ReadBatchSpacedInternal<Repetition::REQUIRED>(
+          batch_size, def_levels, rep_levels, values, valid_bits, valid_bits_offset,
+          levels_read, values_read, null_count_out);
+    case Repetition::OPTIONAL:
+      return ReadBatchSpacedInternal<Repetition::OPTIONAL>(
+          batch_size, def_levels, rep_levels, values, valid_bits, valid_bits_offset,
+          levels_read, values_read, null_count_out);
+    default:
+      return ReadBatchSpacedInternal<Repetition::REPEATED>(
+          batch_size, def_levels, rep_levels, values, valid_bits, valid_bits_offset,
+          levels_read, values_read, null_count_out);
   }
 }
 
-}  // namespace internal
-
 template <typename DType>
-inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
+template <Repetition::type repetition>
+inline int64_t TypedColumnReader<DType>::ReadBatchSpacedInternal(
     int64_t batch_size, int16_t* def_levels, int16_t* rep_levels, T* values,
     uint8_t* valid_bits, int64_t valid_bits_offset, int64_t* levels_read,
     int64_t* values_read, int64_t* null_count_out) {
@@ -421,38 +680,46 @@ inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
   batch_size = std::min(batch_size, num_buffered_values_ - num_decoded_values_);
 
   // If the field is required and non-repeated, there are no definition levels
-  if (descr_->max_definition_level() > 0) {
-    int64_t num_def_levels = ReadDefinitionLevels(batch_size, def_levels);
+  if (repetition != Repetition::REQUIRED) {
+    int64_t values_to_read = 0;
+    int64_t num_def_levels =
+        ReadDefinitionLevels(batch_size, def_levels, &values_to_read);
 
     // Not present for non-repeated fields
-    if (descr_->max_repetition_level() > 0) {
+    if (repetition == Repetition::REPEATED) {
       int64_t num_rep_levels = ReadRepetitionLevels(batch_size, rep_levels);
       if (num_def_levels != num_rep_levels) {
         throw ParquetException("Number of decoded rep / def levels did not match");
       }
     }
 
-    const bool has_spaced_values = internal::HasSpacedValues(descr_);
-
     int64_t null_count = 0;
-    if (!has_spaced_values) {
-      int values_to_read = 0;
-      for (int64_t i = 0; i < num_def_levels; ++i) {
-        if (def_levels[i] == descr_->max_definition_level()) {
-          ++values_to_read;
-        }
-      }
+    if (!has_spaced_values_ || values_to_read == num_def_levels) {
+      // No nulls on the lowest level, so the values need no spacing and the
+      // validity bitmap does not depend on the levels
       total_values = ReadValues(values_to_read, values);
-      for (int64_t i = 0; i < total_values; i++) {
-        ::arrow::BitUtil::SetBit(valid_bits, valid_bits_offset + i);
-      }
+      internal::SetBitmapRange(valid_bits, valid_bits_offset, total_values, true);
       *values_read = total_values;
+    } else if (repetition == Repetition::OPTIONAL) {
+      // Each level of a non-repeated column is a value slot
+      if (values_to_read == 0) {
+        internal::SetBitmapRange(valid_bits, valid_bits_offset, num_def_levels, false);
+        std::fill(values, values + num_def_levels, T());
+        null_count = num_def_levels;
+        total_values = num_def_levels;
+      } else {
+        null_count = internal::FlatDefinitionLevelsToBitmap(
+            def_levels, num_def_levels, descr_->max_definition_level(), valid_bits,
+            valid_bits_offset);
+        total_values = ReadValuesSpaced(num_def_levels, values, null_count, valid_bits,
+                                        valid_bits_offset);
+      }
+      *values_read = num_def_levels;
     } else {
-      int16_t max_definition_level = descr_->max_definition_level();
-      int16_t max_repetition_level = descr_->max_repetition_level();
-      internal::DefinitionLevelsToBitmap(def_levels, num_def_levels, max_definition_level,
-                                         max_repetition_level, values_read, &null_count,
-                                         valid_bits, valid_bits_offset);
+      internal::DefinitionLevelsToBitmap(def_levels, num_def_levels,
+                                         descr_->max_definition_level(),
+                                         descr_->max_repetition_level(), values_read,
+                                         &null_count, valid_bits, valid_bits_offset);
       total_values = ReadValuesSpaced(*values_read, values, static_cast<int>(null_count),
                                       valid_bits, valid_bits_offset);
     }
@@ -462,9 +729,7 @@ inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
   } else {
     // Required field, read all values
     total_values = ReadValues(batch_size, values);
-    for (int64_t i = 0; i < total_values; i++) {
-      ::arrow::BitUtil::SetBit(valid_bits, valid_bits_offset + i);
-    }
+    internal::SetBitmapRange(valid_bits, valid_bits_offset, total_values, true);
     *null_count_out = 0;
     *levels_read = total_values;
   }
@@ -476,34 +741,42 @@ inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
 template <typename DType>
 int64_t TypedColumnReader<DType>::Skip(int64_t num_rows_to_skip) {
   int64_t rows_to_skip = num_rows_to_skip;
-  while (HasNext() && rows_to_skip > 0) {
+  while (rows_to_skip > 0) {
+    if (available_values_current_page() == 0) {
+      // Data pages that are skipped as a whole are not even decompressed
+      rows_to_skip -= pager_->SkipDataPages(rows_to_skip);
+      if (rows_to_skip == 0) break;
+    }
+    if (!HasNext()) break;
     // If the number of rows to skip is more than the number of undecoded values, skip the
     // Page.
     if (rows_to_skip > (num_buffered_values_ - num_decoded_values_)) {
       rows_to_skip -= num_buffered_values_ - num_decoded_values_;
       num_decoded_values_ = num_buffered_values_;
     } else {
-      // We need to read this Page
-      // Jump to the right offset in the Page
-      int64_t batch_size = 1024;  // ReadBatch with a smaller memory footprint
-      int64_t values_read = 0;
-
-      std::shared_ptr<PoolBuffer> vals = AllocateBuffer(
-          this->pool_, batch_size * type_traits<DType::type_num>::value_byte_size);
-      std::shared_ptr<PoolBuffer> def_levels =
-          AllocateBuffer(this->pool_, batch_size * sizeof(int16_t));
-
-      std::shared_ptr<PoolBuffer> rep_levels =
-          AllocateBuffer(this->pool_, batch_size * sizeof(int16_t));
-
-      do {
-        batch_size = std::min(batch_size, rows_to_skip);
-        values_read = ReadBatch(static_cast<int>(batch_size),
-                                reinterpret_cast<int16_t*>(def_levels->mutable_data()),
-                                reinterpret_cast<int16_t*>(rep_levels->mutable_data()),
-                                reinterpret_cast<T*>(vals->mutable_data()), &values_read);
-        rows_to_skip -= values_read;
-      } while (values_read > 0 && rows_to_skip > 0);
+      // Skip inside the page without materializing levels or values: only the
+      // number of non-null values is needed to advance the value decoder
+      int64_t values_to_skip = 0;
+      int64_t num_def_levels = 0;
+      if (descr_->max_definition_level() > 0) {
+        num_def_levels = SkipDefinitionLevels(rows_to_skip, &values_to_skip);
+      } else {
+        values_to_skip = rows_to_skip;
+      }
+      if (descr_->max_repetition_level() > 0) {
+        int64_t num_rep_levels = SkipRepetitionLevels(rows_to_skip);
+        if (descr_->max_definition_level() > 0 && num_def_levels != num_rep_levels) {
+          throw ParquetException("Number of decoded rep / def levels did not match");
+        }
+      }
+      int64_t values_skipped = current_decoder_->Skip(static_cast<int>(values_to_skip));
+      if (values_skipped != values_to_skip) {
+        ParquetException::EofException();
+      }
+      int64_t levels_skipped = std::max(num_def_levels, values_skipped);
+      ConsumeBufferedValues(levels_skipped);
+      rows_to_skip -= levels_skipped;
+      if (levels_skipped == 0) break;
     }
   }
   return num_rows_to_skip - rows_to_skip;
@@ -15,15 +15,20 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "parquet/column_reader.h"
 #include "parquet/column_writer.h"
+#include "parquet/encoding-internal.h"
 #include "parquet/parquet_types.h"
 #include "parquet/test-specialization.h"
 #include "parquet/test-util.h"
 #include "parquet/types.h"
 #include "parquet/util/comparison.h"
+#include "parquet/util/hyperloglog.h"
 #include "parquet/util/memory.h"
 
 namespace parquet {
@@ -58,20 +63,37 @@ class TestPrimitiveWriter : public PrimitiveTypedTest<TestType> {
 
   Type::type type_num() { return TestType::type_num; }
 
-  void BuildReader(int64_t num_rows,
-                   Compression::type compression = Compression::UNCOMPRESSED) {
+  std::unique_ptr<PageReader> BuildPageReader(int64_t num_rows,
+                                              Compression::type compression) {
     auto buffer = sink_->GetBuffer();
     std::unique_ptr<InMemoryInputStream> source(new InMemoryInputStream(buffer));
-    std::unique_ptr<PageReader> page_reader =
-        PageReader::Open(std::move(source), num_rows, compression);
-    reader_.reset(new TypedColumnReader<TestType>(this->descr_, std::move(page_reader)));
+    return PageReader::Open(std::move(source), num_rows, compression);
+  }
+
+  void BuildReader(int64_t num_rows,
+                   Compression::type compression = Compression::UNCOMPRESSED) {
+    reader_.reset(new TypedColumnReader<TestType>(
+        this->descr_, BuildPageReader(num_rows, compression)));
   }
 
   std::shared_ptr<TypedColumnWriter<TestType>> BuildWriter(
       int64_t output_size = SMALL_SIZE,
-      const ColumnProperties& column_properties = ColumnProperties()) {
+      const ColumnProperties& column_properties = ColumnProperties(),
+      int page_compression_threads = 1,
+      int64_t buffered_dictionary_data_limit = DEFAULT_BUFFERED_DICTIONARY_DATA_LIMIT) {
     sink_.reset(new InMemoryOutputStream());
     WriterProperties::Builder wp_builder;
+    if (page_compression_threads > 1) {
+      // Small pages, so that many of them are compressed concurrently
+      wp_builder.page_compression_threads(page_compression_threads)
+          ->max_pages_in_flight(3)
+          ->data_pagesize(1024);
+    }
+    if (buffered_dictionary_data_limit != DEFAULT_BUFFERED_DICTIONARY_DATA_LIMIT) {
+      // Small pages, so that several of them are buffered before the limit
+      wp_builder.buffered_dictionary_data_limit(buffered_dictionary_data_limit)
+          ->data_pagesize(1024);
+    }
     if (column_properties.encoding() == Encoding::PLAIN_DICTIONARY ||
         column_properties.encoding() == Encoding::RLE_DICTIONARY) {
       wp_builder.enable_dictionary();
@@ -80,8 +102,13 @@ class TestPrimitiveWriter : public PrimitiveTypedTest<TestType> {
       wp_builder.encoding(column_properties.encoding());
     }
     wp_builder.max_statistics_size(column_properties.max_statistics_size());
+    if (column_properties.distinct_count_enabled()) {
+      wp_builder.enable_distinct_count();
+    }
     writer_properties_ = wp_builder.build();
 
+    // Nothing of the metadata of a previous writer, e.g. its statistics, is left
+    thrift_metadata_ = format::ColumnChunk();
     metadata_ = ColumnChunkMetaDataBuilder::Make(
         writer_properties_, this->descr_, reinterpret_cast<uint8_t*>(&thrift_metadata_));
     std::unique_ptr<PageWriter> pager =
@@ -185,6 +212,14 @@ class TestPrimitiveWriter : public PrimitiveTypedTest<TestType> {
     return metadata_accessor->is_stats_set();
   }
 
+  int64_t metadata_distinct_count() {
+    const format::ColumnMetaData& meta_data = thrift_metadata_.meta_data;
+    if (!meta_data.__isset.statistics || !meta_data.statistics.__isset.distinct_count) {
+      return -1;
+    }
+    return meta_data.statistics.distinct_count;
+  }
+
   std::vector<Encoding::type> metadata_encodings() {
     // Metadata accessor must be created lazily.
     // This is because the ColumnChunkMetaData semantics dictate the metadata object is
@@ -248,6 +283,34 @@ void TestPrimitiveWriter<Int96Type>::ReadAndCompare(Compression::type compressio
   ASSERT_EQ(this->values_, this->values_out_);
 }
 
+template <>
+void TestPrimitiveWriter<ByteArrayType>::ReadColumnFully(Compression::type compression) {
+  int64_t total_values = static_cast<int64_t>(this->values_out_.size());
+  BuildReader(total_values, compression);
+  this->data_buffer_.clear();
+
+  values_read_ = 0;
+  while (values_read_ < total_values) {
+    int64_t values_read_recently = 0;
+    reader_->ReadBatch(
+        static_cast<int>(this->values_out_.size()) - static_cast<int>(values_read_),
+        definition_levels_out_.data() + values_read_,
+        repetition_levels_out_.data() + values_read_,
+        this->values_out_ptr_ + values_read_, &values_read_recently);
+
+    // Copy contents of the pointers, which only live as long as the page in
+    // the decompression buffer
+    for (int64_t i = 0; i < values_read_recently; i++) {
+      ByteArray& value = this->values_out_[i + values_read_];
+      data_buffer_.emplace_back(value.ptr, value.ptr + value.len);
+      value.ptr = data_buffer_.back().data();
+    }
+
+    values_read_ += values_read_recently;
+  }
+  this->SyncValuesOut();
+}
+
 template <>
 void TestPrimitiveWriter<FLBAType>::ReadColumnFully(Compression::type compression) {
   int64_t total_values = static_cast<int64_t>(this->values_out_.size());
@@ -376,6 +439,19 @@ TYPED_TEST(TestPrimitiveWriter, RequiredPlainWithStatsAndZstdCompression) {
                                  LARGE_SIZE);
 }
 
+TYPED_TEST(TestPrimitiveWriter, RequiredWithParallelCompression) {
+  this->GenerateData(LARGE_SIZE);
+  for (auto encoding : {Encoding::PLAIN, Encoding::PLAIN_DICTIONARY}) {
+    for (auto compression : {Compression::SNAPPY, Compression::GZIP}) {
+      ColumnProperties column_properties(encoding, compression);
+      auto writer = this->BuildWriter(LARGE_SIZE, column_properties, 4);
+      writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+      writer->Close();
+      ASSERT_NO_FATAL_FAILURE(this->ReadAndCompare(compression, LARGE_SIZE));
+    }
+  }
+}
+
 TYPED_TEST(TestPrimitiveWriter, Optional) {
   // Optional and non-repeated, with definition levels
   // but no repetition levels
@@ -494,6 +570,65 @@ TYPED_TEST(TestPrimitiveWriter, RequiredVeryLargeChunk) {
   }
 }
 
+// Test case for dictionary fallback once too many data pages are buffered
+TYPED_TEST(TestPrimitiveWriter, RequiredDictionaryBufferedDataLimit) {
+  const int num_rows = LARGE_SIZE / 10;
+  this->GenerateData(num_rows);
+
+  for (int threads : {1, 4}) {
+    ColumnProperties column_properties(Encoding::PLAIN_DICTIONARY);
+    auto writer = this->BuildWriter(num_rows, column_properties, threads, 4096);
+    writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+    writer->Close();
+
+    ASSERT_NO_FATAL_FAILURE(this->ReadAndCompare(Compression::UNCOMPRESSED, num_rows));
+    std::vector<Encoding::type> encodings = this->metadata_encodings();
+    if (this->type_num() != Type::BOOLEAN) {
+      ASSERT_EQ(Encoding::PLAIN_DICTIONARY, encodings[0]);
+      ASSERT_EQ(Encoding::PLAIN, encodings[1]);
+      ASSERT_EQ(Encoding::RLE, encodings[2]);
+    }
+  }
+}
+
+TYPED_TEST(TestPrimitiveWriter, DistinctCount) {
+  const int num_rows = LARGE_SIZE / 10;
+  this->GenerateData(num_rows);
+
+  // Whichever way the values are encoded, they end up in the same sketch
+  HyperLogLog expected;
+  for (int i = 0; i < num_rows; ++i) {
+    expected.AddHash(
+        DistinctCountHash(this->values_ptr_[i], this->descr_->type_length()));
+  }
+
+  ColumnProperties column_properties;
+  column_properties.set_distinct_count_enabled(true);
+  auto writer = this->BuildWriter(num_rows, column_properties);
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+  ASSERT_EQ(expected.Estimate(), this->metadata_distinct_count());
+
+  // Dictionary encoded, then falling back to PLAIN
+  column_properties.set_encoding(Encoding::PLAIN_DICTIONARY);
+  const std::vector<int64_t> buffered_data_limits = {
+      DEFAULT_BUFFERED_DICTIONARY_DATA_LIMIT, 4096};
+  for (int64_t buffered_data_limit : buffered_data_limits) {
+    writer = this->BuildWriter(num_rows, column_properties, 1, buffered_data_limit);
+    std::vector<uint8_t> valid_bits(BitUtil::RoundUpNumBytes(num_rows) + 1, 255);
+    writer->WriteBatchSpaced(this->values_.size(), nullptr, nullptr, valid_bits.data(),
+                             0, this->values_ptr_);
+    writer->Close();
+    ASSERT_EQ(expected.Estimate(), this->metadata_distinct_count());
+  }
+
+  column_properties.set_distinct_count_enabled(false);
+  writer = this->BuildWriter(num_rows, column_properties);
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+  ASSERT_EQ(-1, this->metadata_distinct_count());
+}
+
 // PARQUET-719
 // Test case for NULL values
 TEST_F(TestNullValuesWriter, OptionalNullValueChunk) {
@@ -515,6 +650,88 @@ TEST_F(TestNullValuesWriter, OptionalNullValueChunk) {
   ASSERT_EQ(0, this->values_read_);
 }
 
+// Page reader counting the pages it returns, which are decompressed, and the
+// pages it skips
+class CountingPageReader : public PageReader {
+ public:
+  explicit CountingPageReader(std::unique_ptr<PageReader> pager)
+      : pager_(std::move(pager)), num_read_pages_(0), num_skipped_pages_(0) {}
+
+  std::shared_ptr<Page> NextPage() override {
+    std::shared_ptr<Page> page = pager_->NextPage();
+    if (page) {
+      ++num_read_pages_;
+    }
+    return page;
+  }
+
+  bool SkipPage(PageHeaderInfo* info) override {
+    const bool skipped = pager_->SkipPage(info);
+    if (skipped) {
+      ++num_skipped_pages_;
+    }
+    return skipped;
+  }
+
+  bool PeekPage(PageHeaderInfo* info) override { return pager_->PeekPage(info); }
+
+  void set_max_page_header_size(uint32_t size) override {
+    pager_->set_max_page_header_size(size);
+  }
+
+  int num_read_pages() const { return num_read_pages_; }
+  int num_skipped_pages() const { return num_skipped_pages_; }
+
+ private:
+  std::unique_ptr<PageReader> pager_;
+  int num_read_pages_;
+  int num_skipped_pages_;
+};
+
+using TestFilterWriter = TestPrimitiveWriter<Int32Type>;
+
+// Dictionary-encoded pages of a compressed chunk whose dictionary has no entry
+// matching the predicate are skipped without being decompressed
+TEST_F(TestFilterWriter, ReadFilterSkipsUnmatchedPages) {
+  const int num_rows = LARGE_SIZE / 10;
+  // Random values under 100, so that the compressed pages stay large enough to
+  // fall back to PLAIN
+  this->GenerateData(num_rows);
+  for (int i = 0; i < num_rows; ++i) {
+    this->values_[i] = static_cast<uint32_t>(this->values_[i]) % 100;
+  }
+
+  // Small pages, with and without falling back to PLAIN after a few of them
+  for (int64_t buffered_data_limit : {1 << 20, 4096}) {
+    ColumnProperties column_properties(Encoding::PLAIN_DICTIONARY, Compression::GZIP);
+    auto writer = this->BuildWriter(num_rows, column_properties, 1, buffered_data_limit);
+    writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+    writer->Close();
+
+    CountingPageReader* pager =
+        new CountingPageReader(this->BuildPageReader(num_rows, Compression::GZIP));
+    TypedColumnReader<Int32Type> reader(this->descr_, std::unique_ptr<PageReader>(pager));
+    reader.SetPredicate([](int32_t value) { return value >= 100; });
+
+    std::vector<uint8_t> selection(::arrow::BitUtil::BytesForBits(num_rows), 0xFF);
+    int64_t num_selected = 0;
+    ASSERT_EQ(num_rows, reader.ReadFilter(num_rows, selection.data(), 0, &num_selected));
+    ASSERT_EQ(0, num_selected);
+    for (int i = 0; i < num_rows; ++i) {
+      ASSERT_FALSE(::arrow::BitUtil::GetBit(selection.data(), i)) << "row " << i;
+    }
+
+    ASSERT_GT(pager->num_skipped_pages(), 1);
+    if (buffered_data_limit == 4096) {
+      // The fallback pages are still decompressed and evaluated
+      ASSERT_GT(pager->num_read_pages(), 1);
+    } else {
+      // Only the dictionary page is decompressed
+      ASSERT_EQ(1, pager->num_read_pages());
+    }
+  }
+}
+
 // PARQUET-764
 // Correct bitpacking for boolean write at non-byte boundaries
 using TestBooleanValuesWriter = TestPrimitiveWriter<BooleanType>;
@@ -739,6 +956,149 @@ TEST(TestLevels, TestLevelsDecodeMultipleSetData) {
   }
 }
 
+// Test counting non-null levels and detecting runs of them
+TEST(TestLevels, TestLevelsDecodeCountAndRuns) {
+  const int16_t max_level = 1;
+  // A repeated run of max levels, a mix of levels and a repeated run of nulls
+  std::vector<int16_t> input_levels(100, max_level);
+  for (int i = 0; i < 64; ++i) {
+    input_levels.push_back(i % 3 == 0 ? 0 : max_level);
+  }
+  input_levels.resize(input_levels.size() + 50, 0);
+  const int num_levels = static_cast<int>(input_levels.size());
+  const int64_t num_max_levels =
+      std::count(input_levels.begin(), input_levels.end(), max_level);
+
+  std::vector<uint8_t> bytes;
+  std::vector<int16_t> output_levels(num_levels);
+  for (Encoding::type encoding : {Encoding::RLE, Encoding::BIT_PACKED}) {
+    ASSERT_NO_FATAL_FAILURE(
+        EncodeLevels(encoding, max_level, num_levels, input_levels.data(), bytes));
+    LevelDecoder decoder;
+    decoder.SetData(encoding, max_level, num_levels, bytes.data());
+
+    const bool is_rle = encoding == Encoding::RLE;
+    ASSERT_EQ(is_rle ? 100 : 0, decoder.MaxLevelRunLength(num_levels));
+    ASSERT_EQ(is_rle ? 30 : 0, decoder.MaxLevelRunLength(30));
+
+    int64_t count = 0;
+    ASSERT_EQ(30, decoder.Decode(30, output_levels.data(), &count));
+    ASSERT_EQ(30, count);
+    ASSERT_EQ(is_rle ? 70 : 0, decoder.MaxLevelRunLength(num_levels));
+    ASSERT_EQ(num_levels - 30,
+              decoder.Decode(num_levels, output_levels.data() + 30, &count));
+    ASSERT_EQ(num_max_levels, count);
+    ASSERT_EQ(input_levels, output_levels);
+    ASSERT_EQ(0, decoder.MaxLevelRunLength(num_levels));
+  }
+}
+
+// Test decoding definition levels straight into a validity bitmap
+TEST(TestLevels, TestLevelsDecodeToBitmap) {
+  const int16_t max_level = 1;
+  // Repeated runs of either level, literal runs and a tail shorter than a group
+  std::vector<int16_t> input_levels(70, max_level);
+  for (int i = 0; i < 2000; ++i) {
+    input_levels.push_back(i % 5 == 0 ? 0 : max_level);
+  }
+  input_levels.resize(input_levels.size() + 1030, 0);
+  input_levels.resize(input_levels.size() + 13, max_level);
+  input_levels.push_back(0);
+  const int num_levels = static_cast<int>(input_levels.size());
+  const int64_t expected_null_count =
+      std::count(input_levels.begin(), input_levels.end(), 0);
+
+  std::vector<uint8_t> bytes;
+  for (Encoding::type encoding : {Encoding::RLE, Encoding::BIT_PACKED}) {
+    ASSERT_NO_FATAL_FAILURE(
+        EncodeLevels(encoding, max_level, num_levels, input_levels.data(), bytes));
+    for (int64_t offset : {0, 3}) {
+      LevelDecoder decoder;
+      decoder.SetData(encoding, max_level, num_levels, bytes.data());
+      // Bits outside of the decoded range must be left alone
+      std::vector<uint8_t> valid_bits(BitUtil::BytesForBits(offset + num_levels + 8),
+                                      0xA5);
+      int64_t null_count = 0;
+      int levels_read = 0;
+      for (int batch_size : {5, 100, 3000, num_levels}) {
+        levels_read += decoder.DecodeToBitmap(batch_size, valid_bits.data(),
+                                              offset + levels_read, &null_count);
+      }
+      ASSERT_EQ(num_levels, levels_read);
+      ASSERT_EQ(expected_null_count, null_count);
+      for (int64_t i = 0; i < offset; ++i) {
+        ASSERT_EQ(((0xA5 >> i) & 1) != 0, BitUtil::GetBit(valid_bits.data(), i));
+      }
+      for (int i = 0; i < num_levels; ++i) {
+        ASSERT_EQ(input_levels[i] == max_level,
+                  BitUtil::GetBit(valid_bits.data(), offset + i))
+            << "level " << i;
+      }
+      const int64_t end = offset + num_levels;
+      for (int64_t i = end; i < (end + 7) / 8 * 8; ++i) {
+        ASSERT_EQ(((0xA5 >> (i % 8)) & 1) != 0, BitUtil::GetBit(valid_bits.data(), i));
+      }
+    }
+  }
+}
+
+// Test encoding levels with runs of every length around the repeated run and
+// literal group boundaries
+TEST(TestLevelEncoder, EncodeRuns) {
+  const int16_t max_level = 3;
+  std::vector<int16_t> input_levels;
+  for (int run_length = 1; run_length <= 20; ++run_length) {
+    for (int16_t level = 0; level <= max_level; ++level) {
+      input_levels.resize(input_levels.size() + run_length, level);
+    }
+  }
+  // Literal runs longer than the largest literal run of the encoder
+  for (int i = 0; i < 1500; ++i) {
+    input_levels.push_back(static_cast<int16_t>(i % 3));
+  }
+  input_levels.resize(input_levels.size() + 100000, max_level);
+  input_levels.push_back(0);
+  const int num_levels = static_cast<int>(input_levels.size());
+
+  std::vector<uint8_t> bytes;
+  ASSERT_NO_FATAL_FAILURE(
+      EncodeLevels(Encoding::RLE, max_level, num_levels, input_levels.data(), bytes));
+  ASSERT_NO_FATAL_FAILURE(
+      VerifyDecodingLevels(Encoding::RLE, max_level, input_levels, bytes));
+
+  // A buffer too small for the levels
+  LevelEncoder encoder;
+  encoder.Init(Encoding::RLE, max_level, num_levels, bytes.data(), 16);
+  ASSERT_GT(num_levels, encoder.Encode(num_levels, input_levels.data()));
+  ASSERT_GE(16, encoder.len());
+}
+
+// Test encoding a run of levels without materializing it
+TEST(TestLevelEncoder, EncodeRepeated) {
+  const int16_t max_level = 2;
+  const int num_levels = 100000;
+  std::vector<int16_t> input_levels(num_levels, max_level);
+  for (Encoding::type encoding : {Encoding::RLE, Encoding::BIT_PACKED}) {
+    std::vector<uint8_t> bytes(
+        LevelEncoder::MaxBufferSize(encoding, max_level, num_levels) + sizeof(int32_t));
+    LevelEncoder encoder;
+    if (encoding == Encoding::RLE) {
+      encoder.Init(encoding, max_level, num_levels, bytes.data() + sizeof(int32_t),
+                   static_cast<int>(bytes.size() - sizeof(int32_t)));
+      ASSERT_EQ(num_levels, encoder.EncodeRepeated(num_levels, max_level));
+      // A single repeated run
+      ASSERT_EQ(4, encoder.len());
+      reinterpret_cast<int32_t*>(bytes.data())[0] = encoder.len();
+    } else {
+      encoder.Init(encoding, max_level, num_levels, bytes.data(),
+                   static_cast<int>(bytes.size()));
+      ASSERT_EQ(num_levels, encoder.EncodeRepeated(num_levels, max_level));
+    }
+    ASSERT_NO_FATAL_FAILURE(
+        VerifyDecodingLevels(encoding, max_level, input_levels, bytes));
+  }
+}
+
 TEST(TestLevelEncoder, MinimumBufferSize) {
   // PARQUET-676, PARQUET-698
   const int kNumToEncode = 1024;
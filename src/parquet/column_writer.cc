@@ -17,8 +17,14 @@
 
 #include "parquet/column_writer.h"
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "arrow/util/bit-util.h"
 #include "arrow/util/compression.h"
@@ -28,8 +34,11 @@
 #include "parquet/properties.h"
 #include "parquet/statistics.h"
 #include "parquet/thrift.h"
+#include "parquet/util/executor.h"
+#include "parquet/util/hyperloglog.h"
 #include "parquet/util/logging.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/rle-internal.h"
 
 namespace parquet {
 
@@ -45,7 +54,7 @@ void LevelEncoder::Init(Encoding::type encoding, int16_t max_level,
   encoding_ = encoding;
   switch (encoding) {
     case Encoding::RLE: {
-      rle_encoder_.reset(new RleEncoder(data, data_size, bit_width_));
+      rle_encoder_.reset(new RleRunEncoder(data, data_size, bit_width_));
       break;
     }
     case Encoding::BIT_PACKED: {
@@ -88,20 +97,38 @@ int LevelEncoder::Encode(int batch_size, const int16_t* levels) {
   }
 
   if (encoding_ == Encoding::RLE) {
+    const int values_written = rle_encoder_->values_written();
+    rle_encoder_->Put(levels, batch_size);
+    rle_length_ = rle_encoder_->Flush();
+    num_encoded = rle_encoder_->values_written() - values_written;
+  } else {
     for (int i = 0; i < batch_size; ++i) {
-      if (!rle_encoder_->Put(*(levels + i))) {
+      if (!bit_packed_encoder_->PutValue(*(levels + i), bit_width_)) {
         break;
       }
       ++num_encoded;
     }
-    rle_encoder_->Flush();
-    rle_length_ = rle_encoder_->len();
+    bit_packed_encoder_->Flush();
+  }
+  return num_encoded;
+}
+
+int LevelEncoder::EncodeRepeated(int batch_size, int16_t level) {
+  if (!rle_encoder_ && !bit_packed_encoder_) {
+    throw ParquetException("Level encoders are not initialized.");
+  }
+
+  int num_encoded = 0;
+  if (encoding_ == Encoding::RLE) {
+    const int values_written = rle_encoder_->values_written();
+    rle_encoder_->PutRun(static_cast<uint16_t>(level), batch_size);
+    rle_length_ = rle_encoder_->Flush();
+    num_encoded = rle_encoder_->values_written() - values_written;
   } else {
-    for (int i = 0; i < batch_size; ++i) {
-      if (!bit_packed_encoder_->PutValue(*(levels + i), bit_width_)) {
+    for (; num_encoded < batch_size; ++num_encoded) {
+      if (!bit_packed_encoder_->PutValue(level, bit_width_)) {
         break;
       }
-      ++num_encoded;
     }
     bit_packed_encoder_->Flush();
   }
@@ -122,6 +149,34 @@ static format::Statistics ToThrift(const EncodedStatistics& row_group_statistics
   return statistics;
 }
 
+// Compress src_buffer into dest_buffer, which is resized to the compressed size
+static void CompressBuffer(::arrow::Codec* codec, const Buffer& src_buffer,
+                           ResizableBuffer* dest_buffer) {
+  int64_t max_compressed_size =
+      codec->MaxCompressedLen(src_buffer.size(), src_buffer.data());
+
+  // Use Arrow::Buffer::shrink_to_fit = false
+  // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
+  PARQUET_THROW_NOT_OK(dest_buffer->Resize(max_compressed_size, false));
+
+  int64_t compressed_size;
+  PARQUET_THROW_NOT_OK(codec->Compress(src_buffer.size(), src_buffer.data(),
+                                       max_compressed_size, dest_buffer->mutable_data(),
+                                       &compressed_size));
+  PARQUET_THROW_NOT_OK(dest_buffer->Resize(compressed_size, false));
+}
+
+// Hand the page in a scratch buffer over to a page that outlives it, and
+// replace the scratch buffer with a new one. The unused capacity is trimmed
+// so that the memory held by the page matches its size
+static std::shared_ptr<Buffer> ReleaseScratchBuffer(
+    ::arrow::MemoryPool* pool, std::shared_ptr<ResizableBuffer>* scratch) {
+  std::shared_ptr<ResizableBuffer> buffer = std::move(*scratch);
+  PARQUET_THROW_NOT_OK(buffer->Resize(buffer->size(), true));
+  *scratch = std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(pool, 0));
+  return buffer;
+}
+
 // This subclass delimits pages appearing in a serialized stream, each preceded
 // by a serialized Thrift format::PageHeader indicating the type of each page
 // and the page metadata.
@@ -133,9 +188,10 @@ class SerializedPageWriter : public PageWriter {
       : sink_(sink),
         metadata_(metadata),
         pool_(pool),
+        codec_(codec),
         num_values_(0),
-        dictionary_page_offset_(0),
-        data_page_offset_(0),
+        dictionary_page_offset_(-1),
+        data_page_offset_(-1),
         total_uncompressed_size_(0),
         total_compressed_size_(0) {
     compressor_ = GetCodecFromArrow(codec);
@@ -166,7 +222,7 @@ class SerializedPageWriter : public PageWriter {
     // TODO(PARQUET-594) crc checksum
 
     int64_t start_pos = sink_->Tell();
-    if (dictionary_page_offset_ == 0) {
+    if (dictionary_page_offset_ < 0) {
       dictionary_page_offset_ = start_pos;
     }
     int64_t header_size =
@@ -180,34 +236,35 @@ class SerializedPageWriter : public PageWriter {
   }
 
   void Close(bool has_dictionary, bool fallback) override {
-    // index_page_offset = 0 since they are not supported
-    metadata_->Finish(num_values_, dictionary_page_offset_, 0, data_page_offset_,
-                      total_compressed_size_, total_uncompressed_size_, has_dictionary,
-                      fallback);
+    Finish(0, has_dictionary, fallback);
 
     // Write metadata at end of column chunk
     metadata_->WriteTo(sink_);
   }
 
+  // Finish the column chunk metadata, with the page offsets shifted by
+  // offset_base if the pages were written to an intermediate sink
+  void Finish(int64_t offset_base, bool has_dictionary, bool fallback) {
+    int64_t dictionary_page_offset =
+        dictionary_page_offset_ < 0 ? 0 : dictionary_page_offset_ + offset_base;
+    int64_t data_page_offset =
+        data_page_offset_ < 0 ? 0 : data_page_offset_ + offset_base;
+    // index_page_offset = 0 since they are not supported
+    metadata_->Finish(num_values_, dictionary_page_offset, 0, data_page_offset,
+                      total_compressed_size_, total_uncompressed_size_, has_dictionary,
+                      fallback);
+  }
+
   /**
    * Compress a buffer.
    */
   void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) override {
     DCHECK(compressor_ != nullptr);
+    CompressBuffer(compressor_.get(), src_buffer, dest_buffer);
+  }
 
-    // Compress the data
-    int64_t max_compressed_size =
-        compressor_->MaxCompressedLen(src_buffer.size(), src_buffer.data());
-
-    // Use Arrow::Buffer::shrink_to_fit = false
-    // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
-    PARQUET_THROW_NOT_OK(dest_buffer->Resize(max_compressed_size, false));
-
-    int64_t compressed_size;
-    PARQUET_THROW_NOT_OK(
-        compressor_->Compress(src_buffer.size(), src_buffer.data(), max_compressed_size,
-                              dest_buffer->mutable_data(), &compressed_size));
-    PARQUET_THROW_NOT_OK(dest_buffer->Resize(compressed_size, false));
+  std::unique_ptr<::arrow::Codec> MakeCompressor() override {
+    return GetCodecFromArrow(codec_);
   }
 
   int64_t WriteDataPage(const CompressedDataPage& page) override {
@@ -231,7 +288,7 @@ class SerializedPageWriter : public PageWriter {
     // TODO(PARQUET-594) crc checksum
 
     int64_t start_pos = sink_->Tell();
-    if (data_page_offset_ == 0) {
+    if (data_page_offset_ < 0) {
       data_page_offset_ = start_pos;
     }
 
@@ -252,6 +309,7 @@ class SerializedPageWriter : public PageWriter {
   OutputStream* sink_;
   ColumnChunkMetaDataBuilder* metadata_;
   ::arrow::MemoryPool* pool_;
+  Compression::type codec_;
   int64_t num_values_;
   int64_t dictionary_page_offset_;
   int64_t data_page_offset_;
@@ -269,6 +327,219 @@ std::unique_ptr<PageWriter> PageWriter::Open(OutputStream* sink, Compression::ty
       new SerializedPageWriter(sink, codec, metadata, pool));
 }
 
+// ----------------------------------------------------------------------
+// BufferedPageWriter
+
+BufferedPageWriter::BufferedPageWriter(Compression::type codec,
+                                       ColumnChunkMetaDataBuilder* metadata,
+                                       ::arrow::MemoryPool* pool)
+    : metadata_(metadata),
+      buffer_sink_(new InMemoryOutputStream(pool)),
+      pager_(new SerializedPageWriter(buffer_sink_.get(), codec, metadata, pool)),
+      has_dictionary_(false),
+      fallback_(false),
+      closed_(false) {}
+
+BufferedPageWriter::~BufferedPageWriter() {}
+
+void BufferedPageWriter::Close(bool has_dictionary, bool fallback) {
+  // The metadata is finished by Flush, once the offsets in the file are known
+  has_dictionary_ = has_dictionary;
+  fallback_ = fallback;
+  closed_ = true;
+}
+
+int64_t BufferedPageWriter::WriteDataPage(const CompressedDataPage& page) {
+  return pager_->WriteDataPage(page);
+}
+
+int64_t BufferedPageWriter::WriteDictionaryPage(const DictionaryPage& page) {
+  return pager_->WriteDictionaryPage(page);
+}
+
+bool BufferedPageWriter::has_compressor() { return pager_->has_compressor(); }
+
+void BufferedPageWriter::Compress(const Buffer& src_buffer,
+                                  ResizableBuffer* dest_buffer) {
+  pager_->Compress(src_buffer, dest_buffer);
+}
+
+std::unique_ptr<::arrow::Codec> BufferedPageWriter::MakeCompressor() {
+  return pager_->MakeCompressor();
+}
+
+int64_t BufferedPageWriter::Flush(OutputStream* sink) {
+  if (!closed_) {
+    throw ParquetException("Column chunk must be closed before it is flushed");
+  }
+  pager_->Finish(sink->Tell(), has_dictionary_, fallback_);
+
+  std::shared_ptr<Buffer> buffer = buffer_sink_->GetBuffer();
+  sink->Write(buffer->data(), buffer->size());
+  buffer_sink_.reset();
+
+  // Write metadata at end of column chunk
+  metadata_->WriteTo(sink);
+  return buffer->size();
+}
+
+// ----------------------------------------------------------------------
+// PageCompressionPool
+
+// Compresses the data pages of a column chunk on the threads of an Executor.
+// Codecs may keep state between calls, so each running compression owns one
+// of the codecs, which bounds the number of pages compressed at once. Tasks
+// are handed back in the order they were submitted, whatever order they
+// complete in
+class PageCompressionPool {
+ public:
+  struct Task {
+    std::shared_ptr<Buffer> uncompressed_data;
+    std::shared_ptr<ResizableBuffer> compressed_data;
+    int32_t num_values;
+    Encoding::type encoding;
+    int64_t uncompressed_size;
+    EncodedStatistics statistics;
+    // Whether the page is kept in memory until the dictionary page is written
+    bool buffered;
+    bool done;
+    std::string error;
+  };
+
+  PageCompressionPool(const std::shared_ptr<Executor>& executor,
+                      std::vector<std::unique_ptr<::arrow::Codec>> codecs)
+      : state_(std::make_shared<State>()) {
+    state_->executor = executor;
+    state_->codecs = std::move(codecs);
+    for (const auto& codec : state_->codecs) {
+      state_->idle_codecs.push_back(codec.get());
+    }
+  }
+
+  ~PageCompressionPool() {
+    // Pages not committed yet are dropped. Compressions still running share
+    // the state, so they are not waited for
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->pending.clear();
+  }
+
+  void Submit(const std::shared_ptr<Task>& task) {
+    ::arrow::Codec* codec;
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      task->done = false;
+      state_->in_flight.push_back(task);
+      state_->pending.push_back(task);
+      if (state_->idle_codecs.empty()) {
+        // Picked up once one of the running compressions completes
+        return;
+      }
+      codec = state_->idle_codecs.back();
+      state_->idle_codecs.pop_back();
+    }
+    ScheduleCompression(state_, codec, task->uncompressed_size);
+  }
+
+  int64_t num_in_flight() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return static_cast<int64_t>(state_->in_flight.size());
+  }
+
+  // Remove the oldest task once it is complete. Return nullptr if there is no
+  // task, or if it is not complete and wait is false
+  std::shared_ptr<Task> Next(bool wait) {
+    std::shared_ptr<Task> task;
+    {
+      std::unique_lock<std::mutex> lock(state_->mutex);
+      if (state_->in_flight.empty()) {
+        return nullptr;
+      }
+      while (!state_->in_flight.front()->done) {
+        if (!wait) {
+          return nullptr;
+        }
+        // The writer may itself run on the executor; compress the pages of
+        // this pool rather than holding one of its threads idle
+        lock.unlock();
+        const bool ran_task = state_->executor->RunPendingTask(state_.get());
+        lock.lock();
+        if (!ran_task && !state_->in_flight.front()->done) {
+          state_->task_done.wait(lock);
+        }
+      }
+      task = state_->in_flight.front();
+      state_->in_flight.pop_front();
+    }
+    if (!task->error.empty()) {
+      throw ParquetException(task->error);
+    }
+    return task;
+  }
+
+ private:
+  struct State {
+    std::shared_ptr<Executor> executor;
+    std::vector<std::unique_ptr<::arrow::Codec>> codecs;
+
+    std::mutex mutex;
+    std::condition_variable task_done;
+    std::vector<::arrow::Codec*> idle_codecs;
+    // Tasks not being compressed yet
+    std::deque<std::shared_ptr<Task>> pending;
+    // Tasks not handed back yet, in submission order
+    std::deque<std::shared_ptr<Task>> in_flight;
+  };
+
+  // Compress the next pending page with codec on the executor. Each page is
+  // an executor task of its own, so that a long column chunk does not hold
+  // on to a thread
+  static void ScheduleCompression(const std::shared_ptr<State>& state,
+                                  ::arrow::Codec* codec, int64_t cost) {
+    state->executor->Submit([state, codec]() { CompressNext(state, codec); }, cost,
+                            state.get());
+  }
+
+  static void CompressNext(const std::shared_ptr<State>& state, ::arrow::Codec* codec) {
+    std::shared_ptr<Task> task;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->pending.empty()) {
+        state->idle_codecs.push_back(codec);
+        return;
+      }
+      task = state->pending.front();
+      state->pending.pop_front();
+    }
+
+    std::string error;
+    try {
+      CompressBuffer(codec, *task->uncompressed_data, task->compressed_data.get());
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+    // The uncompressed page is not needed anymore
+    task->uncompressed_data.reset();
+
+    int64_t next_cost = -1;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      task->error = std::move(error);
+      task->done = true;
+      if (state->pending.empty()) {
+        state->idle_codecs.push_back(codec);
+      } else {
+        next_cost = state->pending.front()->uncompressed_size;
+      }
+    }
+    state->task_done.notify_all();
+    if (next_cost >= 0) {
+      ScheduleCompression(state, codec, next_cost);
+    }
+  }
+
+  std::shared_ptr<State> state_;
+};
+
 // ----------------------------------------------------------------------
 // ColumnWriter
 
@@ -294,21 +565,38 @@ ColumnWriter::ColumnWriter(ColumnChunkMetaDataBuilder* metadata,
       rows_written_(0),
       total_bytes_written_(0),
       closed_(false),
-      fallback_(false) {
+      fallback_(false),
+      data_pages_size_(0) {
   definition_levels_sink_.reset(new InMemoryOutputStream(allocator_));
   repetition_levels_sink_.reset(new InMemoryOutputStream(allocator_));
-  definition_levels_rle_ =
-      std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
-  repetition_levels_rle_ =
-      std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
   uncompressed_data_ =
       std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
   if (pager_->has_compressor()) {
     compressed_data_ =
         std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
   }
+  if (properties->distinct_count_enabled(descr_->path())) {
+    distinct_sketch_.reset(new HyperLogLog());
+  }
+
+  int num_threads = properties->page_compression_threads();
+  if (pager_->has_compressor() && num_threads > 1) {
+    std::vector<std::unique_ptr<::arrow::Codec>> codecs;
+    for (int i = 0; i < num_threads; ++i) {
+      std::unique_ptr<::arrow::Codec> codec = pager_->MakeCompressor();
+      // The pages are compressed by pager_ if it can't provide codecs
+      if (codec == nullptr) break;
+      codecs.push_back(std::move(codec));
+    }
+    if (static_cast<int>(codecs.size()) == num_threads) {
+      compression_pool_.reset(
+          new PageCompressionPool(properties->executor(), std::move(codecs)));
+    }
+  }
 }
 
+ColumnWriter::~ColumnWriter() {}
+
 void ColumnWriter::InitSinks() {
   definition_levels_sink_->Clear();
   repetition_levels_sink_->Clear();
@@ -326,83 +614,132 @@ void ColumnWriter::WriteRepetitionLevels(int64_t num_levels, const int16_t* leve
                                  sizeof(int16_t) * num_levels);
 }
 
-// return the size of the encoded buffer
-int64_t ColumnWriter::RleEncodeLevels(const Buffer& src_buffer,
-                                      ResizableBuffer* dest_buffer, int16_t max_level) {
+int64_t ColumnWriter::RleEncodedLevelsMaxSize(int16_t max_level) {
   // TODO: This only works with due to some RLE specifics
-  int64_t rle_size = LevelEncoder::MaxBufferSize(Encoding::RLE, max_level,
-                                                 static_cast<int>(num_buffered_values_)) +
-                     sizeof(int32_t);
-
-  // Use Arrow::Buffer::shrink_to_fit = false
-  // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
-  PARQUET_THROW_NOT_OK(dest_buffer->Resize(rle_size, false));
+  return LevelEncoder::MaxBufferSize(Encoding::RLE, max_level,
+                                     static_cast<int>(num_buffered_values_)) +
+         sizeof(int32_t);
+}
 
+// return the size of the encoded levels
+int64_t ColumnWriter::RleEncodeLevels(const Buffer& src_buffer, int16_t max_level,
+                                      bool all_max_level, uint8_t* dest) {
   level_encoder_.Init(Encoding::RLE, max_level, static_cast<int>(num_buffered_values_),
-                      dest_buffer->mutable_data() + sizeof(int32_t),
-                      static_cast<int>(dest_buffer->size() - sizeof(int32_t)));
-  int encoded =
-      level_encoder_.Encode(static_cast<int>(num_buffered_values_),
-                            reinterpret_cast<const int16_t*>(src_buffer.data()));
+                      dest + sizeof(int32_t),
+                      static_cast<int>(RleEncodedLevelsMaxSize(max_level) -
+                                       sizeof(int32_t)));
+  int encoded;
+  if (all_max_level) {
+    encoded =
+        level_encoder_.EncodeRepeated(static_cast<int>(num_buffered_values_), max_level);
+  } else {
+    encoded = level_encoder_.Encode(static_cast<int>(num_buffered_values_),
+                                    reinterpret_cast<const int16_t*>(src_buffer.data()));
+  }
   DCHECK_EQ(encoded, num_buffered_values_);
-  reinterpret_cast<int32_t*>(dest_buffer->mutable_data())[0] = level_encoder_.len();
+  reinterpret_cast<int32_t*>(dest)[0] = level_encoder_.len();
   int64_t encoded_size = level_encoder_.len() + sizeof(int32_t);
   return encoded_size;
 }
 
 void ColumnWriter::AddDataPage() {
-  int64_t definition_levels_rle_size = 0;
-  int64_t repetition_levels_rle_size = 0;
+  const int16_t max_definition_level = descr_->max_definition_level();
+  const int16_t max_repetition_level = descr_->max_repetition_level();
 
   std::shared_ptr<Buffer> values = GetValuesBuffer();
 
-  if (descr_->max_definition_level() > 0) {
-    definition_levels_rle_size =
-        RleEncodeLevels(definition_levels_sink_->GetBufferRef(),
-                        definition_levels_rle_.get(), descr_->max_definition_level());
-  }
-
-  if (descr_->max_repetition_level() > 0) {
-    repetition_levels_rle_size =
-        RleEncodeLevels(repetition_levels_sink_->GetBufferRef(),
-                        repetition_levels_rle_.get(), descr_->max_repetition_level());
-  }
+  std::shared_ptr<Buffer> uncompressed_data;
+  if (max_definition_level > 0 || max_repetition_level > 0) {
+    int64_t max_levels_size = 0;
+    if (max_repetition_level > 0) {
+      max_levels_size += RleEncodedLevelsMaxSize(max_repetition_level);
+    }
+    if (max_definition_level > 0) {
+      max_levels_size += RleEncodedLevelsMaxSize(max_definition_level);
+    }
 
-  int64_t uncompressed_size =
-      definition_levels_rle_size + repetition_levels_rle_size + values->size();
+    // Use Arrow::Buffer::shrink_to_fit = false
+    // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
+    PARQUET_THROW_NOT_OK(
+        uncompressed_data_->Resize(max_levels_size + values->size(), false));
 
-  // Use Arrow::Buffer::shrink_to_fit = false
-  // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
-  PARQUET_THROW_NOT_OK(uncompressed_data_->Resize(uncompressed_size, false));
+    // Encode the levels in place, and append the values to them
+    uint8_t* uncompressed_ptr = uncompressed_data_->mutable_data();
+    if (max_repetition_level > 0) {
+      uncompressed_ptr += RleEncodeLevels(repetition_levels_sink_->GetBufferRef(),
+                                          max_repetition_level, false, uncompressed_ptr);
+    }
+    if (max_definition_level > 0) {
+      // Without nulls or empty lists on the page, the definition levels are a
+      // single run of the max level
+      const bool all_defined = num_buffered_encoded_values_ == num_buffered_values_;
+      uncompressed_ptr +=
+          RleEncodeLevels(definition_levels_sink_->GetBufferRef(), max_definition_level,
+                          all_defined, uncompressed_ptr);
+    }
+    memcpy(uncompressed_ptr, values->data(), values->size());
+    uncompressed_ptr += values->size();
 
-  // Concatenate data into a single buffer
-  uint8_t* uncompressed_ptr = uncompressed_data_->mutable_data();
-  memcpy(uncompressed_ptr, repetition_levels_rle_->data(), repetition_levels_rle_size);
-  uncompressed_ptr += repetition_levels_rle_size;
-  memcpy(uncompressed_ptr, definition_levels_rle_->data(), definition_levels_rle_size);
-  uncompressed_ptr += definition_levels_rle_size;
-  memcpy(uncompressed_ptr, values->data(), values->size());
+    PARQUET_THROW_NOT_OK(uncompressed_data_->Resize(
+        uncompressed_ptr - uncompressed_data_->mutable_data(), false));
+    uncompressed_data = uncompressed_data_;
+  } else {
+    // Without levels, the encoded values are the page
+    uncompressed_data = values;
+  }
+  int64_t uncompressed_size = uncompressed_data->size();
 
   EncodedStatistics page_stats = GetPageStatistics();
   ResetPageStatistics();
 
+  if (compression_pool_) {
+    auto task = std::make_shared<PageCompressionPool::Task>();
+    // The task takes the page over; the next one is assembled in a new buffer
+    task->uncompressed_data = uncompressed_data;
+    if (uncompressed_data == uncompressed_data_) {
+      uncompressed_data_ =
+          std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+    }
+    task->compressed_data =
+        std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+    task->num_values = static_cast<int32_t>(num_buffered_values_);
+    task->encoding = encoding_;
+    task->uncompressed_size = uncompressed_size;
+    task->statistics = page_stats;
+    task->buffered = has_dictionary_ && !fallback_;
+    compression_pool_->Submit(task);
+
+    // Write the pages compressed so far, and bound the memory held by the pool
+    CommitCompressedDataPages(properties_->max_pages_in_flight());
+
+    // Re-initialize the sinks for next Page.
+    InitSinks();
+    num_buffered_values_ = 0;
+    num_buffered_encoded_values_ = 0;
+    return;
+  }
+
   std::shared_ptr<Buffer> compressed_data;
   if (pager_->has_compressor()) {
-    pager_->Compress(*(uncompressed_data_.get()), compressed_data_.get());
+    pager_->Compress(*uncompressed_data, compressed_data_.get());
     compressed_data = compressed_data_;
   } else {
-    compressed_data = uncompressed_data_;
+    compressed_data = uncompressed_data;
   }
 
   // Write the page to OutputStream eagerly if there is no dictionary or
   // if dictionary encoding has fallen back to PLAIN
   if (has_dictionary_ && !fallback_) {  // Save pages until end of dictionary encoding
-    std::shared_ptr<Buffer> compressed_data_copy;
-    PARQUET_THROW_NOT_OK(compressed_data->Copy(0, compressed_data->size(), allocator_,
-                                               &compressed_data_copy));
-    CompressedDataPage page(compressed_data_copy,
-                            static_cast<int32_t>(num_buffered_values_), encoding_,
-                            Encoding::RLE, Encoding::RLE, uncompressed_size, page_stats);
+    // The page keeps its buffer, unless it is one of the scratch buffers
+    if (compressed_data == compressed_data_) {
+      compressed_data = ReleaseScratchBuffer(allocator_, &compressed_data_);
+    } else if (compressed_data == uncompressed_data_) {
+      compressed_data = ReleaseScratchBuffer(allocator_, &uncompressed_data_);
+    }
+    CompressedDataPage page(compressed_data, static_cast<int32_t>(num_buffered_values_),
+                            encoding_, Encoding::RLE, Encoding::RLE, uncompressed_size,
+                            page_stats);
+    data_pages_size_ += compressed_data->size();
     data_pages_.push_back(std::move(page));
   } else {  // Eagerly write pages
     CompressedDataPage page(compressed_data, static_cast<int32_t>(num_buffered_values_),
@@ -421,6 +758,28 @@ void ColumnWriter::WriteDataPage(const CompressedDataPage& page) {
   total_bytes_written_ += pager_->WriteDataPage(page);
 }
 
+void ColumnWriter::CommitCompressedDataPages(int64_t max_pages_in_flight) {
+  while (true) {
+    bool wait = compression_pool_->num_in_flight() > max_pages_in_flight;
+    std::shared_ptr<PageCompressionPool::Task> task = compression_pool_->Next(wait);
+    if (task == nullptr) {
+      break;
+    }
+    CompressedDataPage page(task->compressed_data, task->num_values, task->encoding,
+                            Encoding::RLE, Encoding::RLE, task->uncompressed_size,
+                            task->statistics);
+    if (task->buffered) {
+      // Trim the capacity left over from the compression bound
+      PARQUET_THROW_NOT_OK(
+          task->compressed_data->Resize(task->compressed_data->size(), true));
+      data_pages_size_ += task->compressed_data->size();
+      data_pages_.push_back(std::move(page));
+    } else {
+      WriteDataPage(page);
+    }
+  }
+}
+
 int64_t ColumnWriter::Close() {
   if (!closed_) {
     closed_ = true;
@@ -429,18 +788,37 @@ int64_t ColumnWriter::Close() {
     }
 
     FlushBufferedDataPages();
+    // Stop the compression workers, all the pages have been committed
+    compression_pool_.reset();
 
     EncodedStatistics chunk_statistics = GetChunkStatistics();
+    if (distinct_sketch_) {
+      chunk_statistics.set_distinct_count(distinct_sketch_->Estimate());
+      metadata_->SetDistinctSketch(*distinct_sketch_);
+    }
     // From parquet-mr
     // Don't write stats larger than the max size rather than truncating. The
     // rationale is that some engines may use the minimum value in the page as
     // the true minimum for aggregations and there is no way to mark that a
     // value has been truncated and is a lower bound and not in the page.
+    // Unless truncation is enabled: BYTE_ARRAY bounds are then shortened to
+    // prefixes that remain lower and upper bounds, and the column chunk is
+    // marked so that readers do not take them for the true min and max.
+    const size_t max_statistics_size = properties_->max_statistics_size(descr_->path());
+    bool statistics_truncated = false;
+    if (properties_->statistics_truncation_enabled() &&
+        descr_->physical_type() == Type::BYTE_ARRAY &&
+        chunk_statistics.max_stat_length() > max_statistics_size) {
+      statistics_truncated = chunk_statistics.TruncateMinMax(
+          max_statistics_size, SortOrder::SIGNED == descr_->sort_order());
+    }
     if (chunk_statistics.is_set() &&
-        chunk_statistics.max_stat_length() <=
-            properties_->max_statistics_size(descr_->path())) {
+        chunk_statistics.max_stat_length() <= max_statistics_size) {
       metadata_->SetStatistics(SortOrder::SIGNED == descr_->sort_order(),
                                chunk_statistics);
+      if (statistics_truncated) {
+        metadata_->SetStatisticsTruncated();
+      }
     }
     pager_->Close(has_dictionary_, fallback_);
   }
@@ -453,10 +831,14 @@ void ColumnWriter::FlushBufferedDataPages() {
   if (num_buffered_values_ > 0) {
     AddDataPage();
   }
+  if (compression_pool_) {
+    CommitCompressedDataPages(0);
+  }
   for (size_t i = 0; i < data_pages_.size(); i++) {
     WriteDataPage(data_pages_[i]);
   }
   data_pages_.clear();
+  data_pages_size_ = 0;
 }
 
 // ----------------------------------------------------------------------
@@ -476,10 +858,14 @@ TypedColumnWriter<Type>::TypedColumnWriter(ColumnChunkMetaDataBuilder* metadata,
       current_encoder_.reset(new PlainEncoder<Type>(descr_, properties->memory_pool()));
       break;
     case Encoding::PLAIN_DICTIONARY:
-    case Encoding::RLE_DICTIONARY:
-      current_encoder_.reset(
-          new DictEncoder<Type>(descr_, &pool_, properties->memory_pool()));
+    case Encoding::RLE_DICTIONARY: {
+      auto dict_encoder =
+          new DictEncoder<Type>(descr_, &pool_, properties->memory_pool());
+      // The dictionary sees every distinct value until it falls back to PLAIN
+      dict_encoder->set_distinct_sketch(distinct_sketch_.get());
+      current_encoder_.reset(dict_encoder);
       break;
+    }
     default:
       ParquetException::NYI("Selected encoding is not supported");
   }
@@ -492,11 +878,13 @@ TypedColumnWriter<Type>::TypedColumnWriter(ColumnChunkMetaDataBuilder* metadata,
 }
 
 // Only one Dictionary Page is written.
-// Fallback to PLAIN if dictionary page limit is reached.
+// Fallback to PLAIN if dictionary page limit is reached, or if the Data Pages
+// waiting for the Dictionary Page take up too much memory.
 template <typename Type>
 void TypedColumnWriter<Type>::CheckDictionarySizeLimit() {
   auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
-  if (dict_encoder->dict_encoded_size() >= properties_->dictionary_pagesize_limit()) {
+  if (dict_encoder->dict_encoded_size() >= properties_->dictionary_pagesize_limit() ||
+      data_pages_size_ >= properties_->buffered_dictionary_data_limit()) {
     WriteDictionaryPage();
     // Serialize the buffered Dictionary Indicies
     FlushBufferedDataPages();
@@ -776,6 +1164,12 @@ void TypedColumnWriter<DType>::WriteBatchSpaced(
 template <typename DType>
 void TypedColumnWriter<DType>::WriteValues(int64_t num_values, const T* values) {
   current_encoder_->Put(values, static_cast<int>(num_values));
+  if (distinct_sketch_ && (!has_dictionary_ || fallback_)) {
+    const int type_length = descr_->type_length();
+    for (int64_t i = 0; i < num_values; ++i) {
+      distinct_sketch_->AddHash(DistinctCountHash(values[i], type_length));
+    }
+  }
 }
 
 template <typename DType>
@@ -785,6 +1179,17 @@ void TypedColumnWriter<DType>::WriteValuesSpaced(int64_t num_values,
                                                  const T* values) {
   current_encoder_->PutSpaced(values, static_cast<int>(num_values), valid_bits,
                               valid_bits_offset);
+  if (distinct_sketch_ && (!has_dictionary_ || fallback_)) {
+    const int type_length = descr_->type_length();
+    ::arrow::internal::BitmapReader valid_bits_reader(valid_bits, valid_bits_offset,
+                                                      num_values);
+    for (int64_t i = 0; i < num_values; ++i) {
+      if (valid_bits_reader.IsSet()) {
+        distinct_sketch_->AddHash(DistinctCountHash(values[i], type_length));
+      }
+      valid_bits_reader.Next();
+    }
+  }
 }
 
 template class PARQUET_TEMPLATE_EXPORT TypedColumnWriter<BooleanType>;
@@ -33,12 +33,13 @@
 namespace arrow {
 
 class BitWriter;
-class RleEncoder;
 
 }  // namespace arrow
 
 namespace parquet {
 
+class RleRunEncoder;
+
 class PARQUET_EXPORT LevelEncoder {
  public:
   LevelEncoder();
@@ -54,6 +55,10 @@ class PARQUET_EXPORT LevelEncoder {
   // Encodes a batch of levels from an array and returns the number of levels encoded
   int Encode(int batch_size, const int16_t* levels);
 
+  // Encodes batch_size copies of level without materializing them and returns
+  // the number of levels encoded
+  int EncodeRepeated(int batch_size, int16_t level);
+
   int32_t len() {
     if (encoding_ != Encoding::RLE) {
       throw ParquetException("Only implemented for RLE encoding");
@@ -65,7 +70,7 @@ class PARQUET_EXPORT LevelEncoder {
   int bit_width_;
   int rle_length_;
   Encoding::type encoding_;
-  std::unique_ptr<::arrow::RleEncoder> rle_encoder_;
+  std::unique_ptr<RleRunEncoder> rle_encoder_;
   std::unique_ptr<::arrow::BitWriter> bit_packed_encoder_;
 };
 
@@ -89,16 +94,62 @@ class PageWriter {
   virtual bool has_compressor() = 0;
 
   virtual void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) = 0;
+
+  // Return a new instance of the codec used by Compress, so that pages can be
+  // compressed on other threads. nullptr if pages can only go through Compress
+  virtual std::unique_ptr<::arrow::Codec> MakeCompressor() { return nullptr; }
+};
+
+class SerializedPageWriter;
+
+// A PageWriter that keeps the pages of a column chunk in memory, so that the
+// column chunks of a row group can be encoded and compressed concurrently. The
+// chunk and its metadata are written to the file, at their final offsets, by
+// Flush once the ColumnWriter is closed
+class PARQUET_EXPORT BufferedPageWriter : public PageWriter {
+ public:
+  BufferedPageWriter(Compression::type codec, ColumnChunkMetaDataBuilder* metadata,
+                     ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  ~BufferedPageWriter() override;
+
+  void Close(bool has_dictionary, bool fallback) override;
+
+  int64_t WriteDataPage(const CompressedDataPage& page) override;
+
+  int64_t WriteDictionaryPage(const DictionaryPage& page) override;
+
+  bool has_compressor() override;
+
+  void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) override;
+
+  std::unique_ptr<::arrow::Codec> MakeCompressor() override;
+
+  // Write the column chunk to sink and finish its metadata. Return the number
+  // of bytes of pages written
+  int64_t Flush(OutputStream* sink);
+
+ private:
+  ColumnChunkMetaDataBuilder* metadata_;
+  std::unique_ptr<InMemoryOutputStream> buffer_sink_;
+  std::unique_ptr<SerializedPageWriter> pager_;
+  bool has_dictionary_;
+  bool fallback_;
+  bool closed_;
 };
 
 static constexpr int WRITE_BATCH_SIZE = 1000;
+
+class HyperLogLog;
+class PageCompressionPool;
+
 class PARQUET_EXPORT ColumnWriter {
  public:
   ColumnWriter(ColumnChunkMetaDataBuilder*, std::unique_ptr<PageWriter>,
                bool has_dictionary, Encoding::type encoding,
                const WriterProperties* properties);
 
-  virtual ~ColumnWriter() = default;
+  virtual ~ColumnWriter();
 
   static std::shared_ptr<ColumnWriter> Make(ColumnChunkMetaDataBuilder*,
                                             std::unique_ptr<PageWriter>,
@@ -125,8 +176,9 @@ class PARQUET_EXPORT ColumnWriter {
   // Serializes Dictionary Page if enabled
   virtual void WriteDictionaryPage() = 0;
 
-  // Checks if the Dictionary Page size limit is reached
-  // If the limit is reached, the Dictionary and Data Pages are serialized
+  // Checks if the Dictionary Page size limit, or the limit of the Data Pages
+  // buffered until the Dictionary Page is written, is reached
+  // If a limit is reached, the Dictionary and Data Pages are serialized
   // The encoding is switched to PLAIN
 
   virtual void CheckDictionarySizeLimit() = 0;
@@ -147,15 +199,25 @@ class PARQUET_EXPORT ColumnWriter {
   // Serializes Data Pages
   void WriteDataPage(const CompressedDataPage& page);
 
+  // Commits the pages compressed by the compression pool, in the order they
+  // were added, waiting until no more than max_pages_in_flight are left
+  void CommitCompressedDataPages(int64_t max_pages_in_flight);
+
   // Write multiple definition levels
   void WriteDefinitionLevels(int64_t num_levels, const int16_t* levels);
 
   // Write multiple repetition levels
   void WriteRepetitionLevels(int64_t num_levels, const int16_t* levels);
 
-  // RLE encode the src_buffer into dest_buffer and return the encoded size
-  int64_t RleEncodeLevels(const Buffer& src_buffer, ResizableBuffer* dest_buffer,
-                          int16_t max_level);
+  // Upper bound of the size of the RLE encoded levels of the buffered values
+  int64_t RleEncodedLevelsMaxSize(int16_t max_level);
+
+  // RLE encode the src_buffer into dest, which holds at least
+  // RleEncodedLevelsMaxSize(max_level) bytes, and return the encoded size. If
+  // all_max_level, the levels are known to all equal max_level and src_buffer
+  // is not read
+  int64_t RleEncodeLevels(const Buffer& src_buffer, int16_t max_level,
+                          bool all_max_level, uint8_t* dest);
 
   // Serialize the buffered Data Pages
   void FlushBufferedDataPages();
@@ -201,13 +263,20 @@ class PARQUET_EXPORT ColumnWriter {
   std::unique_ptr<InMemoryOutputStream> definition_levels_sink_;
   std::unique_ptr<InMemoryOutputStream> repetition_levels_sink_;
 
-  std::shared_ptr<ResizableBuffer> definition_levels_rle_;
-  std::shared_ptr<ResizableBuffer> repetition_levels_rle_;
-
+  // Scratch buffers the pages are assembled and compressed in
   std::shared_ptr<ResizableBuffer> uncompressed_data_;
   std::shared_ptr<ResizableBuffer> compressed_data_;
 
   std::vector<CompressedDataPage> data_pages_;
+  // Compressed bytes of the pages in data_pages_
+  int64_t data_pages_size_;
+
+  // Compresses data pages on the executor if page_compression_threads > 1
+  std::unique_ptr<PageCompressionPool> compression_pool_;
+
+  // Sketch of the distinct values of the chunk if distinct counts are enabled.
+  // Fed by the DictEncoder, then by WriteValues once it falls back to PLAIN
+  std::unique_ptr<HyperLogLog> distinct_sketch_;
 
  private:
   void InitSinks();
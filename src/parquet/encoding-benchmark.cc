@@ -161,6 +161,19 @@ static void BM_DictDecodingInt64_literals(::benchmark::State& state) {
 
 BENCHMARK(BM_DictDecodingInt64_literals)->Range(1024, 65536);
 
+static void BM_DictDecodingInt32_literals(::benchmark::State& state) {
+  typedef Int32Type Type;
+  typedef typename Type::c_type T;
+
+  std::vector<T> values(state.range(0));
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<T>(i);
+  }
+  DecodeDict<Type>(values, state);
+}
+
+BENCHMARK(BM_DictDecodingInt32_literals)->Range(1024, 65536);
+
 }  // namespace benchmark
 
 }  // namespace parquet
@@ -35,7 +35,10 @@
 #include "parquet/exception.h"
 #include "parquet/schema.h"
 #include "parquet/types.h"
+#include "parquet/util/bitmap-internal.h"
+#include "parquet/util/hyperloglog.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/rle-internal.h"
 
 namespace parquet {
 
@@ -70,6 +73,12 @@ class PlainDecoder : public Decoder<DType> {
 
   virtual int Decode(T* buffer, int max_values);
 
+  // Copies fixed-width values straight from the page into their slots
+  virtual int DecodeSpaced(T* buffer, int num_values, int null_count,
+                           const uint8_t* valid_bits, int64_t valid_bits_offset);
+
+  virtual int Skip(int num_values);
+
  private:
   using Decoder<DType>::descr_;
   const uint8_t* data_;
@@ -136,14 +145,111 @@ inline int PlainDecoder<DType>::Decode(T* buffer, int max_values) {
   return max_values;
 }
 
+template <typename DType>
+inline int PlainDecoder<DType>::DecodeSpaced(T* buffer, int num_values, int null_count,
+                                             const uint8_t* valid_bits,
+                                             int64_t valid_bits_offset) {
+  const int values_to_read = num_values - null_count;
+  if (values_to_read > num_values_) {
+    throw ParquetException("Number of values / definition_levels read did not match");
+  }
+  const int bytes_to_decode = values_to_read * static_cast<int>(sizeof(T));
+  if (len_ < bytes_to_decode) {
+    ParquetException::EofException();
+  }
+  internal::ExpandSpaced(data_, num_values, null_count, valid_bits, valid_bits_offset,
+                         buffer);
+  data_ += bytes_to_decode;
+  len_ -= bytes_to_decode;
+  num_values_ -= values_to_read;
+  return num_values;
+}
+
+// The plain encoding of BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values is not the
+// values themselves, so they are decoded densely and then spaced
+template <>
+inline int PlainDecoder<ByteArrayType>::DecodeSpaced(ByteArray* buffer, int num_values,
+                                                     int null_count,
+                                                     const uint8_t* valid_bits,
+                                                     int64_t valid_bits_offset) {
+  return Decoder<ByteArrayType>::DecodeSpaced(buffer, num_values, null_count, valid_bits,
+                                              valid_bits_offset);
+}
+
+template <>
+inline int PlainDecoder<FLBAType>::DecodeSpaced(FixedLenByteArray* buffer,
+                                                int num_values, int null_count,
+                                                const uint8_t* valid_bits,
+                                                int64_t valid_bits_offset) {
+  return Decoder<FLBAType>::DecodeSpaced(buffer, num_values, null_count, valid_bits,
+                                         valid_bits_offset);
+}
+
+// Return the number of bytes taken by the next num_values values, without
+// decoding them
+template <typename T>
+inline int SkipPlain(const uint8_t* data, int64_t data_size, int num_values,
+                     int type_length) {
+  int bytes_to_skip = num_values * static_cast<int>(sizeof(T));
+  if (data_size < bytes_to_skip) {
+    ParquetException::EofException();
+  }
+  return bytes_to_skip;
+}
+
+// BYTE_ARRAY values are variable length, so the length prefixes have to be walked
+template <>
+inline int SkipPlain<ByteArray>(const uint8_t* data, int64_t data_size, int num_values,
+                                int type_length) {
+  int bytes_skipped = 0;
+  for (int i = 0; i < num_values; ++i) {
+    if (data_size < static_cast<int64_t>(sizeof(uint32_t))) {
+      ParquetException::EofException();
+    }
+    uint32_t len = *reinterpret_cast<const uint32_t*>(data);
+    int increment = static_cast<int>(sizeof(uint32_t) + len);
+    if (data_size < increment) ParquetException::EofException();
+    data += increment;
+    data_size -= increment;
+    bytes_skipped += increment;
+  }
+  return bytes_skipped;
+}
+
+template <>
+inline int SkipPlain<FixedLenByteArray>(const uint8_t* data, int64_t data_size,
+                                        int num_values, int type_length) {
+  int bytes_to_skip = type_length * num_values;
+  if (data_size < bytes_to_skip) {
+    ParquetException::EofException();
+  }
+  return bytes_to_skip;
+}
+
+template <typename DType>
+inline int PlainDecoder<DType>::Skip(int num_values) {
+  num_values = std::min(num_values, num_values_);
+  int bytes_skipped = SkipPlain<T>(data_, len_, num_values, type_length_);
+  data_ += bytes_skipped;
+  len_ -= bytes_skipped;
+  num_values_ -= num_values;
+  return num_values;
+}
+
 template <>
 class PlainDecoder<BooleanType> : public Decoder<BooleanType> {
  public:
   explicit PlainDecoder(const ColumnDescriptor* descr)
-      : Decoder<BooleanType>(descr, Encoding::PLAIN) {}
+      : Decoder<BooleanType>(descr, Encoding::PLAIN),
+        data_(nullptr),
+        len_(0),
+        total_num_values_(0) {}
 
   virtual void SetData(int num_values, const uint8_t* data, int len) {
     num_values_ = num_values;
+    total_num_values_ = num_values;
+    data_ = data;
+    len_ = len;
     bit_reader_ = ::arrow::BitReader(data, len);
   }
 
@@ -170,8 +276,30 @@ class PlainDecoder<BooleanType> : public Decoder<BooleanType> {
     return max_values;
   }
 
+  // Each value is a single bit, so skipping only needs to reposition the reader
+  virtual int Skip(int num_values) {
+    num_values = std::min(num_values, num_values_);
+    const int64_t bit_offset = total_num_values_ - num_values_ + num_values;
+    const int byte_offset = static_cast<int>(bit_offset / 8);
+    if (byte_offset > len_) {
+      ParquetException::EofException();
+    }
+    bit_reader_ = ::arrow::BitReader(data_ + byte_offset, len_ - byte_offset);
+    bool unused;
+    for (int64_t i = 0; i < bit_offset % 8; ++i) {
+      if (!bit_reader_.GetValue(1, &unused)) {
+        ParquetException::EofException();
+      }
+    }
+    num_values_ -= num_values;
+    return num_values;
+  }
+
  private:
   ::arrow::BitReader bit_reader_;
+  const uint8_t* data_;
+  int len_;
+  int total_num_values_;
 };
 
 // ----------------------------------------------------------------------
@@ -325,25 +453,32 @@ class DictionaryDecoder : public Decoder<Type> {
   explicit DictionaryDecoder(const ColumnDescriptor* descr,
                              ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
       : Decoder<Type>(descr, Encoding::RLE_DICTIONARY),
-        dictionary_(0, pool),
+        dictionary_(std::make_shared<Vector<T>>(0, pool)),
         byte_array_data_(AllocateBuffer(pool, 0)) {}
 
   // Perform type-specific initiatialization
   void SetDict(Decoder<Type>* dictionary);
 
+  // Decode with the dictionary of other instead of decoding the dictionary again.
+  // The dictionary is shared read-only, so both decoders can be used concurrently
+  void ShareDict(const DictionaryDecoder<Type>& other) {
+    dictionary_ = other.dictionary_;
+    byte_array_data_ = other.byte_array_data_;
+  }
+
   void SetData(int num_values, const uint8_t* data, int len) override {
     num_values_ = num_values;
     if (len == 0) return;
     uint8_t bit_width = *data;
     ++data;
     --len;
-    idx_decoder_ = ::arrow::RleDecoder(data, len, bit_width);
+    idx_decoder_.Reset(data, len, bit_width);
   }
 
   int Decode(T* buffer, int max_values) override {
     max_values = std::min(max_values, num_values_);
     int decoded_values =
-        idx_decoder_.GetBatchWithDict(dictionary_.data(), buffer, max_values);
+        idx_decoder_.GetBatchWithDict(dictionary_->data(), buffer, max_values);
     if (decoded_values != max_values) {
       ParquetException::EofException();
     }
@@ -354,32 +489,61 @@ class DictionaryDecoder : public Decoder<Type> {
   int DecodeSpaced(T* buffer, int num_values, int null_count, const uint8_t* valid_bits,
                    int64_t valid_bits_offset) override {
     int decoded_values =
-        idx_decoder_.GetBatchWithDictSpaced(dictionary_.data(), buffer, num_values,
+        idx_decoder_.GetBatchWithDictSpaced(dictionary_->data(), buffer, num_values,
                                             null_count, valid_bits, valid_bits_offset);
     if (decoded_values != num_values) {
       ParquetException::EofException();
     }
+    num_values_ -= num_values - null_count;
     return decoded_values;
   }
 
+  // Skips whole index runs at a time, without looking anything up in the
+  // dictionary
+  int Skip(int num_values) override {
+    num_values = std::min(num_values, num_values_);
+    int skipped_values = idx_decoder_.Skip(num_values);
+    if (skipped_values != num_values) {
+      ParquetException::EofException();
+    }
+    num_values_ -= num_values;
+    return num_values;
+  }
+
+  // Decodes the indices of up to max_values values and writes
+  // entry_matches[index] for each of them to out, without looking up the
+  // dictionary values. Returns the number of values decoded
+  int DecodeMatches(const uint8_t* entry_matches, uint8_t* out, int max_values) {
+    max_values = std::min(max_values, num_values_);
+    int decoded_values = idx_decoder_.GetBatchWithDict(entry_matches, out, max_values);
+    if (decoded_values != max_values) {
+      ParquetException::EofException();
+    }
+    num_values_ -= max_values;
+    return max_values;
+  }
+
+  const T* dictionary() const { return dictionary_->data(); }
+  int dictionary_length() const { return static_cast<int>(dictionary_->size()); }
+
  private:
   using Decoder<Type>::num_values_;
 
-  // Only one is set.
-  Vector<T> dictionary_;
+  // Only one is set. Shared with the decoders set up by ShareDict
+  std::shared_ptr<Vector<T>> dictionary_;
 
   // Data that contains the byte array data (byte_array_dictionary_ just has the
   // pointers).
   std::shared_ptr<PoolBuffer> byte_array_data_;
 
-  ::arrow::RleDecoder idx_decoder_;
+  RleRunDecoder idx_decoder_;
 };
 
 template <typename Type>
 inline void DictionaryDecoder<Type>::SetDict(Decoder<Type>* dictionary) {
   int num_dictionary_values = dictionary->values_left();
-  dictionary_.Resize(num_dictionary_values);
-  dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  dictionary_->Resize(num_dictionary_values);
+  dictionary->Decode(&(*dictionary_)[0], num_dictionary_values);
 }
 
 template <>
@@ -391,29 +555,29 @@ template <>
 inline void DictionaryDecoder<ByteArrayType>::SetDict(
     Decoder<ByteArrayType>* dictionary) {
   int num_dictionary_values = dictionary->values_left();
-  dictionary_.Resize(num_dictionary_values);
-  dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  dictionary_->Resize(num_dictionary_values);
+  dictionary->Decode(&(*dictionary_)[0], num_dictionary_values);
 
   int total_size = 0;
   for (int i = 0; i < num_dictionary_values; ++i) {
-    total_size += dictionary_[i].len;
+    total_size += (*dictionary_)[i].len;
   }
   PARQUET_THROW_NOT_OK(byte_array_data_->Resize(total_size, false));
   int offset = 0;
 
   uint8_t* bytes_data = byte_array_data_->mutable_data();
   for (int i = 0; i < num_dictionary_values; ++i) {
-    memcpy(bytes_data + offset, dictionary_[i].ptr, dictionary_[i].len);
-    dictionary_[i].ptr = bytes_data + offset;
-    offset += dictionary_[i].len;
+    memcpy(bytes_data + offset, (*dictionary_)[i].ptr, (*dictionary_)[i].len);
+    (*dictionary_)[i].ptr = bytes_data + offset;
+    offset += (*dictionary_)[i].len;
   }
 }
 
 template <>
 inline void DictionaryDecoder<FLBAType>::SetDict(Decoder<FLBAType>* dictionary) {
   int num_dictionary_values = dictionary->values_left();
-  dictionary_.Resize(num_dictionary_values);
-  dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  dictionary_->Resize(num_dictionary_values);
+  dictionary->Decode(&(*dictionary_)[0], num_dictionary_values);
 
   int fixed_len = descr_->type_length();
   int total_size = num_dictionary_values * fixed_len;
@@ -421,8 +585,8 @@ inline void DictionaryDecoder<FLBAType>::SetDict(Decoder<FLBAType>* dictionary)
   PARQUET_THROW_NOT_OK(byte_array_data_->Resize(total_size, false));
   uint8_t* bytes_data = byte_array_data_->mutable_data();
   for (int32_t i = 0, offset = 0; i < num_dictionary_values; ++i, offset += fixed_len) {
-    memcpy(bytes_data + offset, dictionary_[i].ptr, fixed_len);
-    dictionary_[i].ptr = bytes_data + offset;
+    memcpy(bytes_data + offset, (*dictionary_)[i].ptr, fixed_len);
+    (*dictionary_)[i].ptr = bytes_data + offset;
   }
 }
 
@@ -441,6 +605,43 @@ static constexpr hash_slot_t HASH_SLOT_EMPTY = std::numeric_limits<int32_t>::max
 // The maximum load factor for the hash table before resizing.
 static constexpr double MAX_HASH_LOAD = 0.7;
 
+/// Hash of a value as DictEncoder computes it. type_length is only used for
+/// FixedLenByteArray values
+template <typename T>
+inline int HashValue(const T& value, int /* type_length */) {
+  return HashUtil::Hash(&value, sizeof(value), 0);
+}
+
+inline int HashValue(const ByteArray& value, int /* type_length */) {
+  if (value.len > 0) {
+    DCHECK_NE(nullptr, value.ptr) << "Value ptr cannot be NULL";
+  }
+  return HashUtil::Hash(value.ptr, value.len, 0);
+}
+
+inline int HashValue(const FixedLenByteArray& value, int type_length) {
+  if (type_length > 0) {
+    DCHECK_NE(nullptr, value.ptr) << "Value ptr cannot be NULL";
+  }
+  return HashUtil::Hash(value.ptr, type_length, 0);
+}
+
+/// Hash of a value as HyperLogLog sketches of distinct values expect it.
+/// HashUtil::Hash depends on the CPU and build flags, so sketches that are
+/// persisted and merged across files need a fixed function instead
+template <typename T>
+inline uint64_t DistinctCountHash(const T& value, int /* type_length */) {
+  return HashUtil::MurmurHash2_64(&value, sizeof(value), 0);
+}
+
+inline uint64_t DistinctCountHash(const ByteArray& value, int /* type_length */) {
+  return HashUtil::MurmurHash2_64(value.ptr, static_cast<int>(value.len), 0);
+}
+
+inline uint64_t DistinctCountHash(const FixedLenByteArray& value, int type_length) {
+  return HashUtil::MurmurHash2_64(value.ptr, type_length, 0);
+}
+
 /// See the dictionary encoding section of https://github.com/Parquet/parquet-format.
 /// The encoding supports streaming encoding. Values are encoded as they are added while
 /// the dictionary is being constructed. At any time, the buffered values can be
@@ -460,7 +661,8 @@ class DictEncoder : public Encoder<DType> {
         mod_bitmask_(hash_table_size_ - 1),
         hash_slots_(0, allocator),
         dict_encoded_size_(0),
-        type_length_(desc->type_length()) {
+        type_length_(desc->type_length()),
+        distinct_sketch_(nullptr) {
     hash_slots_.Assign(hash_table_size_, HASH_SLOT_EMPTY);
     if (!::arrow::CpuInfo::initialized()) {
       ::arrow::CpuInfo::Init();
@@ -475,6 +677,10 @@ class DictEncoder : public Encoder<DType> {
 
   void set_type_length(int type_length) { type_length_ = type_length; }
 
+  /// Add every new dictionary entry to sketch, which must outlive the encoder.
+  /// Hashes are those of DistinctCountHash
+  void set_distinct_sketch(HyperLogLog* sketch) { distinct_sketch_ = sketch; }
+
   /// Returns a conservative estimate of the number of bytes needed to encode the buffered
   /// indices. Used to size the buffer passed to WriteIndices().
   int64_t EstimatedDataEncodedSize() override {
@@ -581,34 +787,16 @@ class DictEncoder : public Encoder<DType> {
   /// Size of each encoded dictionary value. -1 for variable-length types.
   int type_length_;
 
+  // Sketch of the distinct values, if they are counted. Not owned
+  HyperLogLog* distinct_sketch_;
+
   /// Hash function for mapping a value to a bucket.
-  inline int Hash(const T& value) const;
+  int Hash(const T& value) const { return HashValue(value, type_length_); }
 
   /// Adds value to the hash table and updates dict_encoded_size_
   void AddDictKey(const T& value);
 };
 
-template <typename DType>
-inline int DictEncoder<DType>::Hash(const typename DType::c_type& value) const {
-  return HashUtil::Hash(&value, sizeof(value), 0);
-}
-
-template <>
-inline int DictEncoder<ByteArrayType>::Hash(const ByteArray& value) const {
-  if (value.len > 0) {
-    DCHECK_NE(nullptr, value.ptr) << "Value ptr cannot be NULL";
-  }
-  return HashUtil::Hash(value.ptr, value.len, 0);
-}
-
-template <>
-inline int DictEncoder<FLBAType>::Hash(const FixedLenByteArray& value) const {
-  if (type_length_ > 0) {
-    DCHECK_NE(nullptr, value.ptr) << "Value ptr cannot be NULL";
-  }
-  return HashUtil::Hash(value.ptr, type_length_, 0);
-}
-
 template <typename DType>
 inline bool DictEncoder<DType>::SlotDifferent(const typename DType::c_type& v,
                                               hash_slot_t slot) {
@@ -639,6 +827,9 @@ inline void DictEncoder<DType>::Put(const typename DType::c_type& v) {
     index = static_cast<hash_slot_t>(uniques_.size());
     hash_slots_[j] = index;
     AddDictKey(v);
+    if (distinct_sketch_ != nullptr) {
+      distinct_sketch_->AddHash(DistinctCountHash(v, type_length_));
+    }
 
     if (ARROW_PREDICT_FALSE(static_cast<int>(uniques_.size()) >
                             hash_table_size_ * MAX_HASH_LOAD)) {
@@ -800,6 +991,43 @@ class DeltaBitPackDecoder : public Decoder<DType> {
     return GetInternal(buffer, max_values);
   }
 
+  // The deltas are cumulative so they still need to be summed, but the rest of
+  // each miniblock is unpacked in batches and nothing is materialized
+  virtual int Skip(int num_values) {
+    static constexpr int kSkipBatchSize = 128;
+    num_values = std::min(num_values, num_values_);
+    const uint8_t* bit_width_data = delta_bit_widths_->data();
+    int64_t deltas[kSkipBatchSize];
+    int values_skipped = 0;
+    while (values_skipped < num_values) {
+      if (ARROW_PREDICT_FALSE(values_current_mini_block_ == 0)) {
+        ++mini_block_idx_;
+        if (mini_block_idx_ < static_cast<size_t>(delta_bit_widths_->size())) {
+          delta_bit_width_ = bit_width_data[mini_block_idx_];
+          values_current_mini_block_ = values_per_mini_block_;
+        } else {
+          InitBlock();
+          ++values_skipped;
+          continue;
+        }
+      }
+
+      int batch_size = static_cast<int>(std::min<uint64_t>(
+          std::min(num_values - values_skipped, kSkipBatchSize),
+          values_current_mini_block_));
+      if (decoder_.GetBatch(delta_bit_width_, deltas, batch_size) != batch_size) {
+        ParquetException::EofException();
+      }
+      for (int i = 0; i < batch_size; ++i) {
+        last_value_ += static_cast<int32_t>(deltas[i] + min_delta_);
+      }
+      values_current_mini_block_ -= batch_size;
+      values_skipped += batch_size;
+    }
+    num_values_ -= num_values;
+    return num_values;
+  }
+
  private:
   using Decoder<DType>::num_values_;
 
@@ -905,6 +1133,30 @@ class DeltaLengthByteArrayDecoder : public Decoder<ByteArrayType> {
     return max_values;
   }
 
+  // Only the lengths have to be decoded to find where the data continues
+  virtual int Skip(int num_values) {
+    static constexpr int kSkipBatchSize = 128;
+    num_values = std::min(num_values, num_values_);
+    int lengths[kSkipBatchSize];
+    int values_skipped = 0;
+    while (values_skipped < num_values) {
+      const int batch_size = std::min(num_values - values_skipped, kSkipBatchSize);
+      if (len_decoder_.Decode(lengths, batch_size) != batch_size) {
+        ParquetException::EofException();
+      }
+      for (int i = 0; i < batch_size; ++i) {
+        if (lengths[i] < 0 || lengths[i] > len_) {
+          ParquetException::EofException();
+        }
+        data_ += lengths[i];
+        len_ -= lengths[i];
+      }
+      values_skipped += batch_size;
+    }
+    num_values_ -= num_values;
+    return num_values;
+  }
+
  private:
   using Decoder<ByteArrayType>::num_values_;
   DeltaBitPackDecoder<Int32Type> len_decoder_;
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -175,6 +176,55 @@ class TestEncodingBase : public ::testing::Test {
 
   virtual void CheckRoundtrip() = 0;
 
+  // Alternately skip and decode runs of varying length, checking the decoded
+  // values against the input
+  void CheckSkip(Decoder<Type>* decoder) {
+    int position = 0;
+    int run_length = 1;
+    while (position < num_values_) {
+      int num_skip = std::min(run_length, num_values_ - position);
+      ASSERT_EQ(num_skip, decoder->Skip(num_skip));
+      position += num_skip;
+
+      int num_decode = std::min(run_length + 3, num_values_ - position);
+      ASSERT_EQ(num_decode, decoder->Decode(decode_buf_, num_decode));
+      ASSERT_NO_FATAL_FAILURE(
+          VerifyResults<T>(decode_buf_, draws_ + position, num_decode));
+      position += num_decode;
+      run_length = run_length * 2 + 1;
+    }
+    ASSERT_EQ(0, decoder->values_left());
+  }
+
+  // Decode the first values into the valid slots of num_values_ slots at an
+  // unaligned bit offset, with whole bytes of valid and null slots and mixed
+  // ones, checking the values of the valid slots
+  void CheckDecodeSpaced(Decoder<Type>* decoder) {
+    const int64_t offset = 3;
+    std::vector<uint8_t> valid_bits(BitUtil::BytesForBits(num_values_ + offset), 0);
+    int num_valid = 0;
+    for (int i = 0; i < num_values_; ++i) {
+      const int block = (i / 64) % 4;
+      if (block == 0 || (block == 2 && i % 3 != 0) ||
+          (block == 3 && (i * 7919) % 5 != 0)) {
+        BitUtil::SetBit(valid_bits.data(), offset + i);
+        ++num_valid;
+      }
+    }
+    ASSERT_EQ(num_values_, decoder->DecodeSpaced(decode_buf_, num_values_,
+                                                 num_values_ - num_valid,
+                                                 valid_bits.data(), offset));
+    ASSERT_EQ(num_values_ - num_valid, decoder->values_left());
+    int position = 0;
+    for (int i = 0; i < num_values_; ++i) {
+      if (BitUtil::GetBit(valid_bits.data(), offset + i)) {
+        ASSERT_NO_FATAL_FAILURE(VerifyResults<T>(decode_buf_ + i, draws_ + position, 1))
+            << "slot " << i;
+        ++position;
+      }
+    }
+  }
+
   void Execute(int nvalues, int repeats) {
     InitData(nvalues, repeats);
     CheckRoundtrip();
@@ -226,6 +276,16 @@ class TestPlainEncoding : public TestEncodingBase<Type> {
     int values_decoded = decoder.Decode(decode_buf_, num_values_);
     ASSERT_EQ(num_values_, values_decoded);
     ASSERT_NO_FATAL_FAILURE(VerifyResults<T>(decode_buf_, draws_, num_values_));
+
+    // Also test skipping
+    decoder.SetData(num_values_, encode_buffer_->data(),
+                    static_cast<int>(encode_buffer_->size()));
+    ASSERT_NO_FATAL_FAILURE(this->CheckSkip(&decoder));
+
+    // Also test spaced decoding with nulls
+    decoder.SetData(num_values_, encode_buffer_->data(),
+                    static_cast<int>(encode_buffer_->size()));
+    ASSERT_NO_FATAL_FAILURE(this->CheckDecodeSpaced(&decoder));
   }
 
  protected:
@@ -288,6 +348,14 @@ class TestDictionaryEncoding : public TestEncodingBase<Type> {
         decoder.DecodeSpaced(decode_buf_, num_values_, 0, valid_bits.data(), 0);
     ASSERT_EQ(num_values_, values_decoded);
     ASSERT_NO_FATAL_FAILURE(VerifyResults<T>(decode_buf_, draws_, num_values_));
+
+    // Also test skipping
+    decoder.SetData(num_values_, indices->data(), static_cast<int>(indices->size()));
+    ASSERT_NO_FATAL_FAILURE(this->CheckSkip(&decoder));
+
+    // Also test spaced decoding with nulls
+    decoder.SetData(num_values_, indices->data(), static_cast<int>(indices->size()));
+    ASSERT_NO_FATAL_FAILURE(this->CheckDecodeSpaced(&decoder));
   }
 
  protected:
@@ -308,6 +376,110 @@ TEST(TestDictionaryEncoding, CannotDictDecodeBoolean) {
   ASSERT_THROW(decoder.SetDict(&dict_decoder), ParquetException);
 }
 
+// ----------------------------------------------------------------------
+// Dictionary index decoding across bit widths
+
+typedef ::testing::Types<Int32Type, Int64Type, FloatType, DoubleType> DictGatherTypes;
+
+template <typename Type>
+class TestDictionaryDecoding : public ::testing::Test {};
+
+TYPED_TEST_CASE(TestDictionaryDecoding, DictGatherTypes);
+
+// Dictionaries of 2^k + 1 entries give indices of k + 1 bits. The values are
+// decoded in odd batches, so that literal runs are left at unaligned offsets
+TYPED_TEST(TestDictionaryDecoding, BitWidths) {
+  typedef typename TypeParam::c_type T;
+  std::shared_ptr<ColumnDescriptor> descr = ExampleDescr<TypeParam>();
+  ChunkedAllocator pool;
+
+  for (int k = 0; k <= 16; ++k) {
+    const int num_entries = (1 << k) + 1;
+    vector<T> values;
+    for (int i = 0; i < num_entries; ++i) {
+      values.push_back(static_cast<T>(i * 3 + 1));
+    }
+    values.insert(values.end(), 50, values.back());
+    for (int i = 0; i < 2 * num_entries + 7; ++i) {
+      values.push_back(values[(i * 7919) % num_entries]);
+    }
+    const int num_values = static_cast<int>(values.size());
+
+    DictEncoder<TypeParam> encoder(descr.get(), &pool);
+    ASSERT_NO_THROW(encoder.Put(values.data(), num_values));
+    std::shared_ptr<PoolBuffer> dict_buffer =
+        AllocateBuffer(default_memory_pool(), encoder.dict_encoded_size());
+    encoder.WriteDict(dict_buffer->mutable_data());
+    std::shared_ptr<Buffer> indices = encoder.FlushValues();
+
+    PlainDecoder<TypeParam> dict_decoder(descr.get());
+    dict_decoder.SetData(encoder.num_entries(), dict_buffer->data(),
+                         static_cast<int>(dict_buffer->size()));
+    DictionaryDecoder<TypeParam> decoder(descr.get());
+    decoder.SetDict(&dict_decoder);
+    decoder.SetData(num_values, indices->data(), static_cast<int>(indices->size()));
+
+    vector<T> decoded(num_values);
+    int position = 0;
+    while (position < num_values) {
+      const int batch_size = std::min(13, num_values - position);
+      ASSERT_EQ(batch_size, decoder.Decode(decoded.data() + position, batch_size));
+      position += batch_size;
+    }
+    ASSERT_EQ(0, decoder.values_left());
+    ASSERT_EQ(values, decoded) << "dictionary of " << num_entries << " entries";
+  }
+}
+
+// Literal runs of indices up to one bit wider than the gather kernel handles,
+// packed by hand so that the dictionaries need not be built. Only the entries
+// looked up are written
+TYPED_TEST(TestDictionaryDecoding, WideIndices) {
+  typedef typename TypeParam::c_type T;
+  const int num_values = 8 * 64;
+  // Indices are still packed at the full bit width, but masked into a dictionary
+  // of at most 64K entries to keep the test small
+  const uint32_t kDictionaryMask = 0xFFFF;
+  vector<T> dictionary(kDictionaryMask + 1);
+  for (uint32_t i = 0; i <= kDictionaryMask; ++i) {
+    dictionary[i] = static_cast<T>(i * 3 + 1);
+  }
+  for (int bit_width = 1; bit_width <= internal::kMaxGatherBitWidth + 1; ++bit_width) {
+    vector<uint32_t> indices(num_values);
+    for (int i = 0; i < num_values; ++i) {
+      // Spread the indices over all of their bits
+      indices[i] =
+          (static_cast<uint32_t>(i * 2654435761ULL) >> (32 - bit_width)) & kDictionaryMask;
+    }
+
+    // Header of a literal run of num_values / 8 groups, then the packed indices
+    const uint32_t header = (num_values / 8) << 1 | 1;
+    vector<uint8_t> data(2 + num_values * bit_width / 8);
+    data[0] = static_cast<uint8_t>((header & 0x7F) | 0x80);
+    data[1] = static_cast<uint8_t>(header >> 7);
+    ::arrow::BitWriter writer(data.data() + 2, static_cast<int>(data.size()) - 2);
+    for (int i = 0; i < num_values; ++i) {
+      ASSERT_TRUE(writer.PutValue(indices[i], bit_width));
+    }
+    writer.Flush();
+
+    RleRunDecoder decoder(data.data(), static_cast<int>(data.size()), bit_width);
+    vector<T> decoded(num_values);
+    int position = 0;
+    while (position < num_values) {
+      const int batch_size = std::min(13, num_values - position);
+      ASSERT_EQ(batch_size, decoder.GetBatchWithDict(dictionary.data(),
+                                                     decoded.data() + position,
+                                                     batch_size));
+      position += batch_size;
+    }
+    for (int i = 0; i < num_values; ++i) {
+      ASSERT_EQ(dictionary[indices[i]], decoded[i])
+          << "bit width " << bit_width << ", value " << i;
+    }
+  }
+}
+
 }  // namespace test
 
 }  // namespace parquet
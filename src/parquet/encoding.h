@@ -18,6 +18,7 @@
 #ifndef PARQUET_ENCODING_H
 #define PARQUET_ENCODING_H
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <sstream>
@@ -129,6 +130,23 @@ class Decoder {
     return num_values;
   }
 
+  // Advance over up to 'num_values' values without materializing them. Returns the
+  // number of values skipped, which should be num_values except for end of the
+  // current data page. Subclasses should override this with a cheaper native
+  // implementation; the default decodes into a scratch buffer.
+  virtual int Skip(int num_values) {
+    static constexpr int kSkipBatchSize = 1024;
+    std::unique_ptr<T[]> scratch(new T[std::min(num_values, kSkipBatchSize)]);
+    int values_skipped = 0;
+    while (values_skipped < num_values) {
+      int batch_size = std::min(num_values - values_skipped, kSkipBatchSize);
+      int values_read = Decode(scratch.get(), batch_size);
+      values_skipped += values_read;
+      if (values_read < batch_size) break;
+    }
+    return values_skipped;
+  }
+
   // Returns the number of values left (for the last call to SetData()). This is
   // the number of values left in this page.
   int values_left() const { return num_values_; }
@@ -230,6 +230,35 @@ TEST_F(TestPageSerde, Compression) {
   }
 }
 
+TEST_F(TestPageSerde, SkipDataPages) {
+  const int32_t num_rows = 32;
+  data_page_header_.num_values = num_rows;
+
+  const int num_pages = 5;
+  const int data_size = 64;
+  std::vector<std::vector<uint8_t>> faux_data(num_pages);
+  for (int i = 0; i < num_pages; ++i) {
+    test::random_bytes(data_size, i, &faux_data[i]);
+    ASSERT_NO_FATAL_FAILURE(WriteDataPageHeader(1024, data_size, data_size));
+    out_stream_->Write(faux_data[i].data(), data_size);
+  }
+  InitSerializedPageReader(num_rows * num_pages);
+
+  // Only whole pages are skipped
+  ASSERT_EQ(2 * num_rows, page_reader_->SkipDataPages(3 * num_rows - 1));
+  ASSERT_EQ(0, page_reader_->SkipDataPages(num_rows - 1));
+
+  // The header read while looking ahead is not lost
+  std::shared_ptr<Page> page = page_reader_->NextPage();
+  ASSERT_NE(nullptr, page);
+  const DataPage* data_page = static_cast<const DataPage*>(page.get());
+  ASSERT_EQ(num_rows, data_page->num_values());
+  ASSERT_EQ(0, memcmp(faux_data[2].data(), data_page->data(), data_size));
+
+  ASSERT_EQ(2 * num_rows, page_reader_->SkipDataPages(10 * num_rows));
+  ASSERT_EQ(nullptr, page_reader_->NextPage());
+}
+
 TEST_F(TestPageSerde, LZONotSupported) {
   // Must await PARQUET-530
   int data_size = 1024;
@@ -19,11 +19,13 @@
 
 #include "parquet/column_reader.h"
 #include "parquet/column_writer.h"
+#include "parquet/encoding-internal.h"
 #include "parquet/file_reader.h"
 #include "parquet/file_writer.h"
 #include "parquet/test-specialization.h"
 #include "parquet/test-util.h"
 #include "parquet/types.h"
+#include "parquet/util/hyperloglog.h"
 #include "parquet/util/memory.h"
 
 namespace parquet {
@@ -51,7 +53,7 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
   int num_rowgroups_;
   int rows_per_rowgroup_;
 
-  void FileSerializeTest(Compression::type codec_type) {
+  void FileSerializeTest(Compression::type codec_type, bool buffered_row_group = false) {
     std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
     auto gnode = std::static_pointer_cast<GroupNode>(this->node_);
 
@@ -65,14 +67,28 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
     auto file_writer = ParquetFileWriter::Open(sink, gnode, writer_properties);
     for (int rg = 0; rg < num_rowgroups_; ++rg) {
       RowGroupWriter* row_group_writer;
-      row_group_writer = file_writer->AppendRowGroup();
       this->GenerateData(rows_per_rowgroup_);
-      for (int col = 0; col < num_columns_; ++col) {
-        auto column_writer =
-            static_cast<TypedColumnWriter<TestType>*>(row_group_writer->NextColumn());
-        column_writer->WriteBatch(rows_per_rowgroup_, this->def_levels_.data(), nullptr,
-                                  this->values_ptr_);
-        column_writer->Close();
+      if (buffered_row_group) {
+        // The columns of a buffered row group can be written in any order
+        row_group_writer = file_writer->AppendBufferedRowGroup();
+        for (int col = num_columns_ - 1; col >= 0; --col) {
+          auto column_writer =
+              static_cast<TypedColumnWriter<TestType>*>(row_group_writer->column(col));
+          column_writer->WriteBatch(rows_per_rowgroup_, this->def_levels_.data(),
+                                    nullptr, this->values_ptr_);
+        }
+        ASSERT_THROW(row_group_writer->NextColumn(), ParquetException);
+        ASSERT_EQ(rows_per_rowgroup_, row_group_writer->num_rows());
+      } else {
+        row_group_writer = file_writer->AppendRowGroup();
+        for (int col = 0; col < num_columns_; ++col) {
+          auto column_writer =
+              static_cast<TypedColumnWriter<TestType>*>(row_group_writer->NextColumn());
+          column_writer->WriteBatch(rows_per_rowgroup_, this->def_levels_.data(),
+                                    nullptr, this->values_ptr_);
+          column_writer->Close();
+        }
+        ASSERT_THROW(row_group_writer->column(0), ParquetException);
       }
 
       row_group_writer->Close();
@@ -95,6 +111,12 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
       // Check that the specified compression was actually used.
       ASSERT_EQ(codec_type, rg_reader->metadata()->ColumnChunk(0)->compression());
 
+      // The column chunks are laid out in schema order
+      for (int i = 1; i < num_columns_; ++i) {
+        ASSERT_LT(rg_reader->metadata()->ColumnChunk(i - 1)->data_page_offset(),
+                  rg_reader->metadata()->ColumnChunk(i)->data_page_offset());
+      }
+
       int64_t values_read;
 
       for (int i = 0; i < num_columns_; ++i) {
@@ -187,6 +209,10 @@ TYPED_TEST(TestSerialize, SmallFileUncompressed) {
   ASSERT_NO_FATAL_FAILURE(this->FileSerializeTest(Compression::UNCOMPRESSED));
 }
 
+TYPED_TEST(TestSerialize, SmallFileBufferedRowGroups) {
+  ASSERT_NO_FATAL_FAILURE(this->FileSerializeTest(Compression::UNCOMPRESSED, true));
+}
+
 TYPED_TEST(TestSerialize, TooFewRows) {
   std::vector<int64_t> num_rows = {100, 100, 100, 99};
   ASSERT_THROW(this->UnequalNumRows(100, num_rows), ParquetException);
@@ -221,6 +247,65 @@ TYPED_TEST(TestSerialize, SmallFileZstd) {
   ASSERT_NO_FATAL_FAILURE(this->FileSerializeTest(Compression::ZSTD));
 }
 
+// Write values [begin, end) of column "a" in two row groups, with a sketch of
+// its distinct values in the file. Column "b" has no distinct count
+static std::shared_ptr<Buffer> WriteDistinctCountFile(int32_t begin, int32_t end) {
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("a", Repetition::REQUIRED, Type::INT32),
+       PrimitiveNode::Make("b", Repetition::REQUIRED, Type::INT32)});
+  std::shared_ptr<WriterProperties> props = WriterProperties::Builder()
+                                                .enable_distinct_count("a")
+                                                ->enable_distinct_count_sketches()
+                                                ->build();
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema), props);
+  const int32_t middle = begin + (end - begin) / 2;
+  for (int32_t row_group_begin : {begin, middle}) {
+    const int32_t row_group_end = row_group_begin == begin ? middle : end;
+    std::vector<int32_t> values;
+    for (int32_t i = row_group_begin; i < row_group_end; ++i) {
+      values.push_back(i);
+    }
+    auto rg_writer = file_writer->AppendRowGroup();
+    for (int c = 0; c < 2; ++c) {
+      static_cast<Int32Writer*>(rg_writer->NextColumn())
+          ->WriteBatch(static_cast<int64_t>(values.size()), nullptr, nullptr,
+                       values.data());
+    }
+    rg_writer->Close();
+  }
+  file_writer->Close();
+  return sink->GetBuffer();
+}
+
+TEST(TestDistinctCountSketches, MergeAcrossFiles) {
+  std::unique_ptr<HyperLogLog> sketches[2];
+  const int32_t ranges[2][2] = {{0, 30000}, {20000, 50000}};
+  HyperLogLog expected;
+  for (int f = 0; f < 2; ++f) {
+    std::shared_ptr<Buffer> buffer = WriteDistinctCountFile(ranges[f][0], ranges[f][1]);
+    auto file_reader =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+    sketches[f] = file_reader->metadata()->distinct_count_sketch(0);
+    ASSERT_NE(nullptr, sketches[f]);
+    ASSERT_EQ(nullptr, file_reader->metadata()->distinct_count_sketch(1));
+
+    // The sketch of the file covers both of its row groups
+    HyperLogLog file_expected;
+    for (int32_t i = ranges[f][0]; i < ranges[f][1]; ++i) {
+      file_expected.AddHash(DistinctCountHash(i, -1));
+      expected.AddHash(DistinctCountHash(i, -1));
+    }
+    ASSERT_EQ(file_expected.Estimate(), sketches[f]->Estimate());
+  }
+
+  sketches[0]->Merge(*sketches[1]);
+  ASSERT_EQ(expected.Estimate(), sketches[0]->Estimate());
+  ASSERT_NEAR(50000, static_cast<double>(sketches[0]->Estimate()), 50000 * 0.065);
+}
+
 }  // namespace test
 
 }  // namespace parquet
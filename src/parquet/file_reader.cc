@@ -35,6 +35,8 @@
 #include "parquet/metadata.h"
 #include "parquet/parquet_types.h"
 #include "parquet/properties.h"
+#include "parquet/statistics.h"
+#include "parquet/thrift.h"
 #include "parquet/types.h"
 #include "parquet/util/logging.h"
 #include "parquet/util/memory.h"
@@ -57,6 +59,9 @@ static constexpr uint8_t PARQUET_MAGIC[4] = {'P', 'A', 'R', '1'};
 // For PARQUET-816
 static constexpr int64_t kMaxDictHeaderSize = 100;
 
+// Number of levels read at a time when scanning a column chunk for aggregates
+static constexpr int64_t kAggregateScanBatchSize = 1024;
+
 // ----------------------------------------------------------------------
 // RowGroupReader public API
 
@@ -82,6 +87,59 @@ std::unique_ptr<PageReader> RowGroupReader::GetColumnPageReader(int i) {
   return contents_->GetColumnPageReader(i);
 }
 
+std::unique_ptr<ColumnPageIndex> RowGroupReader::GetColumnPageIndex(int i) {
+  DCHECK(i < metadata()->num_columns())
+      << "The RowGroup only has " << metadata()->num_columns()
+      << "columns, requested column: " << i;
+  return contents_->GetColumnPageIndex(i);
+}
+
+std::vector<PageLocation> RowGroupReader::GetColumnPageLocations(int i) {
+  DCHECK(i < metadata()->num_columns())
+      << "The RowGroup only has " << metadata()->num_columns()
+      << "columns, requested column: " << i;
+  return contents_->GetColumnPageLocations(i);
+}
+
+std::unique_ptr<PageReader> RowGroupReader::GetColumnPageReader(
+    int i, const std::vector<PageLocation>& pages, int begin, int end) {
+  DCHECK(i < metadata()->num_columns())
+      << "The RowGroup only has " << metadata()->num_columns()
+      << "columns, requested column: " << i;
+  if (begin < 0 || begin > end || end > static_cast<int>(pages.size())) {
+    std::stringstream ss;
+    ss << "Invalid page range [" << begin << ", " << end << ") of " << pages.size()
+       << " pages";
+    throw ParquetException(ss.str());
+  }
+  return contents_->GetColumnPageReader(i, pages, begin, end);
+}
+
+std::unique_ptr<PageReader> RowGroupReader::GetColumnDictionaryPageReader(
+    int i, const std::vector<PageLocation>& pages) {
+  DCHECK(i < metadata()->num_columns())
+      << "The RowGroup only has " << metadata()->num_columns()
+      << "columns, requested column: " << i;
+  return contents_->GetColumnDictionaryPageReader(i, pages);
+}
+
+std::vector<PageLocation> RowGroupReader::Contents::GetColumnPageLocations(int i) {
+  ParquetException::NYI("Page locations are not supported by this row group reader");
+  return {};
+}
+
+std::unique_ptr<PageReader> RowGroupReader::Contents::GetColumnPageReader(
+    int i, const std::vector<PageLocation>& pages, int begin, int end) {
+  ParquetException::NYI("Page ranges are not supported by this row group reader");
+  return nullptr;
+}
+
+std::unique_ptr<PageReader> RowGroupReader::Contents::GetColumnDictionaryPageReader(
+    int i, const std::vector<PageLocation>& pages) {
+  ParquetException::NYI("Page ranges are not supported by this row group reader");
+  return nullptr;
+}
+
 // Returns the rowgroup metadata
 const RowGroupMetaData* RowGroupReader::metadata() const { return contents_->metadata(); }
 
@@ -102,13 +160,121 @@ class SerializedRowGroup : public RowGroupReader::Contents {
     // Read column chunk from the file
     auto col = row_group_metadata_->ColumnChunk(i);
 
-    int64_t col_start = col->data_page_offset();
-    if (col->has_dictionary_page() && col_start > col->dictionary_page_offset()) {
-      col_start = col->dictionary_page_offset();
+    int64_t col_start, col_length;
+    GetColumnChunkRange(*col, &col_start, &col_length);
+    std::unique_ptr<InputStream> stream =
+        properties_.GetStream(source_, col_start, col_length);
+
+    return PageReader::Open(std::move(stream), col->num_values(), col->compression(),
+                            properties_.memory_pool());
+  }
+
+  std::vector<PageLocation> GetColumnPageLocations(int i) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    if (col->has_offset_index()) {
+      return ReadOffsetIndex(*col);
+    }
+
+    // Walk the page headers of the column chunk
+    int64_t col_start, col_length;
+    GetColumnChunkRange(*col, &col_start, &col_length);
+    std::unique_ptr<PageReader> pager = PageReader::Open(
+        properties_.GetStream(source_, col_start, col_length), col->num_values(),
+        col->compression(), properties_.memory_pool());
+
+    // Without repetition, each value (level) is a row
+    const bool repeated = file_metadata_->schema()->Column(i)->max_repetition_level() > 0;
+
+    std::vector<PageLocation> result;
+    int64_t offset = col_start;
+    int64_t first_row_index = 0;
+    PageHeaderInfo info;
+    while (pager->SkipPage(&info)) {
+      if (info.type == PageType::DATA_PAGE || info.type == PageType::DATA_PAGE_V2) {
+        result.push_back({offset, static_cast<int32_t>(info.size), first_row_index});
+        const int64_t num_rows = repeated ? info.num_rows : info.num_values;
+        if (first_row_index >= 0) {
+          first_row_index = num_rows < 0 ? -1 : first_row_index + num_rows;
+        }
+      }
+      offset += info.size;
+    }
+    return result;
+  }
+
+  std::unique_ptr<PageReader> GetColumnPageReader(
+      int i, const std::vector<PageLocation>& pages, int begin, int end) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    int64_t start = 0;
+    int64_t length = 0;
+    if (begin < end) {
+      start = pages[begin].offset;
+      length = pages[end - 1].offset + pages[end - 1].compressed_page_size - start;
     }
+    return PageReader::Open(properties_.GetStream(source_, start, length),
+                            col->num_values(), col->compression(),
+                            properties_.memory_pool());
+  }
 
-    int64_t col_length = col->total_compressed_size();
-    std::unique_ptr<InputStream> stream;
+  std::unique_ptr<PageReader> GetColumnDictionaryPageReader(
+      int i, const std::vector<PageLocation>& pages) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    int64_t col_start, col_length;
+    GetColumnChunkRange(*col, &col_start, &col_length);
+    if (!pages.empty()) {
+      col_length = std::max<int64_t>(pages[0].offset - col_start, 0);
+    }
+    return PageReader::Open(properties_.GetStream(source_, col_start, col_length),
+                            col->num_values(), col->compression(),
+                            properties_.memory_pool());
+  }
+
+  std::unique_ptr<ColumnPageIndex> GetColumnPageIndex(int i) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    if (!col->has_column_index()) {
+      return nullptr;
+    }
+
+    uint32_t index_len = static_cast<uint32_t>(col->column_index_length());
+    std::shared_ptr<PoolBuffer> index_buffer =
+        AllocateBuffer(properties_.memory_pool(), index_len);
+    int64_t bytes_read = source_->ReadAt(col->column_index_offset(), index_len,
+                                         index_buffer->mutable_data());
+    if (bytes_read != index_len) {
+      throw ParquetException("Invalid parquet file. Could not read column index.");
+    }
+
+    format::ColumnIndex column_index;
+    DeserializeThriftMsg(index_buffer->data(), &index_len, &column_index);
+
+    size_t num_pages = column_index.null_pages.size();
+    if (column_index.min_values.size() != num_pages ||
+        column_index.max_values.size() != num_pages ||
+        (column_index.__isset.null_counts &&
+         column_index.null_counts.size() != num_pages)) {
+      throw ParquetException("Invalid parquet file. Corrupt column index.");
+    }
+
+    std::unique_ptr<ColumnPageIndex> result(new ColumnPageIndex());
+    result->null_pages = column_index.null_pages;
+    result->min_values = column_index.min_values;
+    result->max_values = column_index.max_values;
+    if (column_index.__isset.null_counts) {
+      result->null_counts = column_index.null_counts;
+    }
+    return result;
+  }
+
+ private:
+  // Compute the byte range of a column chunk in the file
+  void GetColumnChunkRange(const ColumnChunkMetaData& col, int64_t* col_start,
+                           int64_t* col_length) {
+    *col_start = col.data_page_offset();
+    if (col.has_dictionary_page() && *col_start > col.dictionary_page_offset()) {
+      *col_start = col.dictionary_page_offset();
+    }
+
+    *col_length = col.total_compressed_size();
 
     // PARQUET-816 workaround for old files created by older parquet-mr
     const ApplicationVersion& version = file_metadata_->writer_version();
@@ -116,18 +282,33 @@ class SerializedRowGroup : public RowGroupReader::Contents {
       // The Parquet MR writer had a bug in 1.2.8 and below where it didn't include the
       // dictionary page header size in total_compressed_size and total_uncompressed_size
       // (see IMPALA-694). We add padding to compensate.
-      int64_t bytes_remaining = source_->Size() - (col_start + col_length);
+      int64_t bytes_remaining = source_->Size() - (*col_start + *col_length);
       int64_t padding = std::min<int64_t>(kMaxDictHeaderSize, bytes_remaining);
-      col_length += padding;
+      *col_length += padding;
     }
+  }
 
-    stream = properties_.GetStream(source_, col_start, col_length);
+  std::vector<PageLocation> ReadOffsetIndex(const ColumnChunkMetaData& col) {
+    uint32_t index_len = static_cast<uint32_t>(col.offset_index_length());
+    std::shared_ptr<PoolBuffer> index_buffer =
+        AllocateBuffer(properties_.memory_pool(), index_len);
+    int64_t bytes_read = source_->ReadAt(col.offset_index_offset(), index_len,
+                                         index_buffer->mutable_data());
+    if (bytes_read != index_len) {
+      throw ParquetException("Invalid parquet file. Could not read offset index.");
+    }
 
-    return PageReader::Open(std::move(stream), col->num_values(), col->compression(),
-                            properties_.memory_pool());
+    format::OffsetIndex offset_index;
+    DeserializeThriftMsg(index_buffer->data(), &index_len, &offset_index);
+
+    std::vector<PageLocation> result;
+    for (const format::PageLocation& location : offset_index.page_locations) {
+      result.push_back(
+          {location.offset, location.compressed_page_size, location.first_row_index});
+    }
+    return result;
   }
 
- private:
   RandomAccessSource* source_;
   FileMetaData* file_metadata_;
   std::unique_ptr<RowGroupMetaData> row_group_metadata_;
@@ -308,6 +489,152 @@ std::shared_ptr<RowGroupReader> ParquetFileReader::RowGroup(int i) {
   return contents_->GetRowGroup(i);
 }
 
+template <typename DType>
+static void ComputeTypedAggregates(ParquetFileReader* reader, int i,
+                                   bool compute_min_max, ColumnAggregates* out) {
+  using T = typename DType::c_type;
+  using TypedStats = TypedRowGroupStatistics<DType>;
+
+  std::shared_ptr<FileMetaData> file_metadata = reader->metadata();
+  const ColumnDescriptor* descr = file_metadata->schema()->Column(i);
+
+  // Without a defined sort order there is no meaningful MIN and MAX
+  compute_min_max = compute_min_max && descr->sort_order() != SortOrder::UNKNOWN;
+  std::shared_ptr<TypedStats> min_max;
+  if (compute_min_max) {
+    min_max = std::make_shared<TypedStats>(descr);
+    out->min_max = min_max;
+  }
+
+  // Binary page index bounds may be truncated, so they are not the exact min
+  // and max of the page
+  const bool exact_page_index_bounds =
+      descr->physical_type() != Type::BYTE_ARRAY &&
+      descr->physical_type() != Type::FIXED_LEN_BYTE_ARRAY;
+
+  std::vector<int16_t> def_levels;
+  std::vector<uint8_t> values;
+
+  for (int r = 0; r < file_metadata->num_row_groups(); ++r) {
+    auto row_group_metadata = file_metadata->RowGroup(r);
+    auto column_chunk = row_group_metadata->ColumnChunk(i);
+    out->num_rows += row_group_metadata->num_rows();
+
+    // A required column has no nulls, so without MIN and MAX the value count
+    // of the column chunk is all that is needed
+    if (!compute_min_max && descr->max_definition_level() == 0) {
+      out->num_values += column_chunk->num_values();
+      ++out->num_row_groups_from_metadata;
+      continue;
+    }
+
+    // The statistics are only returned if they can be trusted. Statistics
+    // without min and max for a column chunk with non-null values are
+    // incomplete, and truncated min and max are only bounds
+    std::shared_ptr<RowGroupStatistics> stats = column_chunk->statistics();
+    if (stats != nullptr &&
+        (!compute_min_max ||
+         (stats->HasMinMax() && !column_chunk->statistics_truncated()) ||
+         stats->num_values() == 0)) {
+      out->null_count += stats->null_count();
+      out->num_values += stats->num_values();
+      if (compute_min_max) {
+        min_max->Merge(*std::static_pointer_cast<TypedStats>(stats));
+      }
+      ++out->num_row_groups_from_metadata;
+      continue;
+    }
+
+    std::shared_ptr<RowGroupReader> row_group = reader->RowGroup(r);
+
+    std::unique_ptr<ColumnPageIndex> page_index = row_group->GetColumnPageIndex(i);
+    if (page_index != nullptr && !page_index->null_counts.empty() &&
+        (!compute_min_max || exact_page_index_bounds)) {
+      int64_t null_count = 0;
+      for (int64_t page_null_count : page_index->null_counts) {
+        null_count += page_null_count;
+      }
+      int64_t num_values = column_chunk->num_values() - null_count;
+      out->null_count += null_count;
+      out->num_values += num_values;
+      if (compute_min_max) {
+        min_max->Merge(TypedStats(descr, std::string(), std::string(), num_values,
+                                  null_count, 0, false));
+        for (size_t page = 0; page < page_index->null_pages.size(); ++page) {
+          if (page_index->null_pages[page]) {
+            continue;
+          }
+          min_max->Merge(TypedStats(descr, page_index->min_values[page],
+                                    page_index->max_values[page], 0, 0, 0, true));
+        }
+      }
+      ++out->num_row_groups_from_page_index;
+      continue;
+    }
+
+    // Fall back to reading the values of the column chunk
+    def_levels.resize(kAggregateScanBatchSize);
+    values.resize(kAggregateScanBatchSize * sizeof(T));
+    T* typed_values = reinterpret_cast<T*>(values.data());
+
+    std::shared_ptr<ColumnReader> column_reader = row_group->Column(i);
+    auto typed_reader = static_cast<TypedColumnReader<DType>*>(column_reader.get());
+    while (typed_reader->HasNext()) {
+      int64_t values_read = 0;
+      int64_t levels_read =
+          typed_reader->ReadBatch(kAggregateScanBatchSize, def_levels.data(), nullptr,
+                                  typed_values, &values_read);
+      out->null_count += levels_read - values_read;
+      out->num_values += values_read;
+      if (compute_min_max) {
+        min_max->Update(typed_values, values_read, levels_read - values_read);
+      }
+    }
+    ++out->num_row_groups_scanned;
+    out->num_rows_scanned += row_group_metadata->num_rows();
+  }
+}
+
+ColumnAggregates ParquetFileReader::ComputeAggregates(int i, bool compute_min_max) {
+  if (i < 0 || i >= metadata()->num_columns()) {
+    std::stringstream ss;
+    ss << "The file only has " << metadata()->num_columns()
+       << " columns, requested aggregates for column: " << i;
+    throw ParquetException(ss.str());
+  }
+
+  ColumnAggregates result;
+  switch (metadata()->schema()->Column(i)->physical_type()) {
+    case Type::BOOLEAN:
+      ComputeTypedAggregates<BooleanType>(this, i, compute_min_max, &result);
+      break;
+    case Type::INT32:
+      ComputeTypedAggregates<Int32Type>(this, i, compute_min_max, &result);
+      break;
+    case Type::INT64:
+      ComputeTypedAggregates<Int64Type>(this, i, compute_min_max, &result);
+      break;
+    case Type::INT96:
+      ComputeTypedAggregates<Int96Type>(this, i, compute_min_max, &result);
+      break;
+    case Type::FLOAT:
+      ComputeTypedAggregates<FloatType>(this, i, compute_min_max, &result);
+      break;
+    case Type::DOUBLE:
+      ComputeTypedAggregates<DoubleType>(this, i, compute_min_max, &result);
+      break;
+    case Type::BYTE_ARRAY:
+      ComputeTypedAggregates<ByteArrayType>(this, i, compute_min_max, &result);
+      break;
+    case Type::FIXED_LEN_BYTE_ARRAY:
+      ComputeTypedAggregates<FLBAType>(this, i, compute_min_max, &result);
+      break;
+    default:
+      ParquetException::NYI("type reader not implemented");
+  }
+  return result;
+}
+
 // ----------------------------------------------------------------------
 // File metadata helpers
 
@@ -37,6 +37,30 @@ namespace parquet {
 
 class ColumnReader;
 
+/// \brief Page-level statistics of a column chunk, read from the ColumnIndex
+/// structure of the page index. Entry i describes the i-th data page
+struct PARQUET_EXPORT ColumnPageIndex {
+  /// True for the pages that only contain nulls, whose min and max are empty
+  std::vector<bool> null_pages;
+  /// Plain-encoded lower and upper bounds of the values of each page. Writers
+  /// may store shorter bounds than the actual min and max of binary values
+  std::vector<std::string> min_values;
+  std::vector<std::string> max_values;
+  /// Number of nulls of each page, empty if the writer did not store them
+  std::vector<int64_t> null_counts;
+};
+
+/// \brief Location of a data page of a column chunk, as in the OffsetIndex
+/// structure of the page index
+struct PARQUET_EXPORT PageLocation {
+  /// File offset of the page header
+  int64_t offset;
+  /// Size of the page header and the compressed page in bytes
+  int32_t compressed_page_size;
+  /// Index of the first row of the page in the row group, -1 if unknown
+  int64_t first_row_index;
+};
+
 class PARQUET_EXPORT RowGroupReader {
  public:
   // Forward declare a virtual class 'Contents' to aid dependency injection and more
@@ -47,6 +71,14 @@ class PARQUET_EXPORT RowGroupReader {
     virtual std::unique_ptr<PageReader> GetColumnPageReader(int i) = 0;
     virtual const RowGroupMetaData* metadata() const = 0;
     virtual const ReaderProperties* properties() const = 0;
+    virtual std::unique_ptr<ColumnPageIndex> GetColumnPageIndex(int i) {
+      return nullptr;
+    }
+    virtual std::vector<PageLocation> GetColumnPageLocations(int i);
+    virtual std::unique_ptr<PageReader> GetColumnPageReader(
+        int i, const std::vector<PageLocation>& pages, int begin, int end);
+    virtual std::unique_ptr<PageReader> GetColumnDictionaryPageReader(
+        int i, const std::vector<PageLocation>& pages);
   };
 
   explicit RowGroupReader(std::unique_ptr<Contents> contents);
@@ -60,11 +92,64 @@ class PARQUET_EXPORT RowGroupReader {
 
   std::unique_ptr<PageReader> GetColumnPageReader(int i);
 
+  // Read the page index of the indicated column chunk. Returns nullptr if the
+  // writer did not store one
+  std::unique_ptr<ColumnPageIndex> GetColumnPageIndex(int i);
+
+  // Return the locations of the data pages of the indicated column chunk, from
+  // the OffsetIndex of the page index if the writer stored one and otherwise by
+  // reading the page headers, without decompressing the pages. The first row
+  // of a page is unknown if only its header is available and the column is
+  // repeated, unless it is a DATA_PAGE_V2
+  std::vector<PageLocation> GetColumnPageLocations(int i);
+
+  // Construct a PageReader over the data pages [begin, end) of pages, the
+  // page locations of the indicated column chunk. Only these pages are read,
+  // so that ranges of pages can be decoded independently
+  std::unique_ptr<PageReader> GetColumnPageReader(
+      int i, const std::vector<PageLocation>& pages, int begin, int end);
+
+  // Construct a PageReader over the pages of the indicated column chunk that
+  // precede its first data page in pages, i.e. its dictionary page if any
+  std::unique_ptr<PageReader> GetColumnDictionaryPageReader(
+      int i, const std::vector<PageLocation>& pages);
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
 };
 
+/// \brief Aggregates of a leaf column over all row groups of a file, see
+/// ParquetFileReader::ComputeAggregates
+struct PARQUET_EXPORT ColumnAggregates {
+  /// COUNT(*): number of rows in the file
+  int64_t num_rows = 0;
+  /// Number of null values; for repeated columns this includes empty and null
+  /// lists, like the null count of the column chunk statistics
+  int64_t null_count = 0;
+  /// Number of non-null values, i.e. COUNT(column) for non-repeated columns
+  int64_t num_values = 0;
+  /// MIN and MAX of the column in the sort order of its logical type, merged
+  /// over all row groups. nullptr if they were not requested or the column has
+  /// no defined sort order; HasMinMax() is false if all values are null
+  std::shared_ptr<RowGroupStatistics> min_max;
+
+  /// Number of row groups answered from the footer metadata (row counts and
+  /// column chunk statistics), from the page index and by scanning the column
+  /// chunk respectively
+  int num_row_groups_from_metadata = 0;
+  int num_row_groups_from_page_index = 0;
+  int num_row_groups_scanned = 0;
+  /// Number of rows of the scanned row groups
+  int64_t num_rows_scanned = 0;
+};
+
+/// Thread safety: once opened, a ParquetFileReader can be shared by any number
+/// of threads, which can call metadata() and RowGroup() and read column chunks
+/// concurrently, including the same column chunk. The readers of row groups,
+/// columns and pages that it returns are not thread-safe, so each must be used
+/// by one thread at a time. Only ReadAt of the source is used, which every
+/// RandomAccessSource, and so ArrowInputFile, supports concurrently
 class PARQUET_EXPORT ParquetFileReader {
  public:
   // Forward declare a virtual class 'Contents' to aid dependency injection and more
@@ -87,17 +172,15 @@ class PARQUET_EXPORT ParquetFileReader {
   ~ParquetFileReader();
 
   // Create a reader from some implementation of parquet-cpp's generic file
-  // input interface
-  //
-  // If you cannot provide exclusive access to your file resource, create a
-  // subclass of RandomAccessSource that wraps the shared resource
+  // input interface, whose ReadAt must be thread-safe (see RandomAccessSource)
   static std::unique_ptr<ParquetFileReader> Open(
       std::unique_ptr<RandomAccessSource> source,
       const ReaderProperties& props = default_reader_properties(),
       const std::shared_ptr<FileMetaData>& metadata = nullptr);
 
-  // Create a file reader instance from an Arrow file object. Thread-safety is
-  // the responsibility of the file implementation
+  // Create a file reader instance from an Arrow file object, wrapped in an
+  // ArrowInputFile. The Arrow file must not be read elsewhere without locking
+  // unless its ReadAt is thread-safe
   static std::unique_ptr<ParquetFileReader> Open(
       const std::shared_ptr<::arrow::io::ReadableFileInterface>& source,
       const ReaderProperties& props = default_reader_properties(),
@@ -119,6 +202,18 @@ class PARQUET_EXPORT ParquetFileReader {
   // Returns the file metadata. Only one instance is ever created
   std::shared_ptr<FileMetaData> metadata() const;
 
+  /// \brief Compute COUNT(*), the null and non-null value counts and, if
+  /// compute_min_max is true, MIN and MAX of leaf column i without reading its
+  /// data where possible.
+  ///
+  /// Each row group is answered from its row count and column chunk statistics.
+  /// Only if the statistics are missing, incomplete or untrustworthy (see
+  /// ApplicationVersion::HasCorrectStatistics), or their MIN and MAX were
+  /// truncated by the writer (see ColumnChunkMetaData::statistics_truncated),
+  /// the page index of the column chunk is used instead and, failing that, the
+  /// column chunk is scanned
+  ColumnAggregates ComputeAggregates(int i, bool compute_min_max = true);
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
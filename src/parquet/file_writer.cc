@@ -53,6 +53,12 @@ int RowGroupWriter::num_columns() const { return contents_->num_columns(); }
 
 int64_t RowGroupWriter::num_rows() const { return contents_->num_rows(); }
 
+ColumnWriter* RowGroupWriter::column(int i) { return contents_->column(i); }
+
+ColumnWriter* RowGroupWriter::Contents::column(int i) {
+  throw ParquetException("Columns can only be accessed in buffered row groups");
+}
+
 // ----------------------------------------------------------------------
 // RowGroupSerializer
 
@@ -60,27 +66,40 @@ int64_t RowGroupWriter::num_rows() const { return contents_->num_rows(); }
 class RowGroupSerializer : public RowGroupWriter::Contents {
  public:
   RowGroupSerializer(OutputStream* sink, RowGroupMetaDataBuilder* metadata,
-                     const WriterProperties* properties)
+                     const WriterProperties* properties, bool buffered_row_group = false)
       : sink_(sink),
         metadata_(metadata),
         properties_(properties),
         total_bytes_written_(0),
         closed_(false),
         current_column_index_(0),
-        num_rows_(-1) {}
+        num_rows_(-1),
+        buffered_row_group_(buffered_row_group) {
+    if (buffered_row_group_) {
+      InitColumns();
+    }
+  }
 
   int num_columns() const override { return metadata_->num_columns(); }
 
   int64_t num_rows() const override {
     if (current_column_writer_) {
-      CheckRowsWritten();
+      CheckRowsWritten(*current_column_writer_);
+    } else if (!column_writers_.empty()) {
+      // The columns of a buffered row group are checked against each other on Close
+      return column_writers_[0]->rows_written();
     }
     return num_rows_ < 0 ? 0 : num_rows_;
   }
 
   ColumnWriter* NextColumn() override {
+    if (buffered_row_group_) {
+      throw ParquetException(
+          "NextColumn() is not supported when a RowGroup is written by column index");
+    }
+
     if (current_column_writer_) {
-      CheckRowsWritten();
+      CheckRowsWritten(*current_column_writer_);
     }
 
     // Throws an error if more columns are being written
@@ -100,6 +119,20 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
     return current_column_writer_.get();
   }
 
+  ColumnWriter* column(int i) override {
+    if (!buffered_row_group_) {
+      throw ParquetException(
+          "column() is only supported when a BufferedRowGroup is being written");
+    }
+    if (i < 0 || i >= static_cast<int>(column_writers_.size())) {
+      std::stringstream ss;
+      ss << "The schema only has " << column_writers_.size()
+         << " columns, requested column: " << i;
+      throw ParquetException(ss.str());
+    }
+    return column_writers_[i].get();
+  }
+
   int current_column() const override { return metadata_->current_column(); }
 
   void Close() override {
@@ -107,11 +140,22 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
       closed_ = true;
 
       if (current_column_writer_) {
-        CheckRowsWritten();
+        CheckRowsWritten(*current_column_writer_);
         total_bytes_written_ += current_column_writer_->Close();
         current_column_writer_.reset();
       }
 
+      // Write the buffered column chunks in schema order
+      for (size_t i = 0; i < column_writers_.size(); ++i) {
+        current_column_index_ = static_cast<int>(i) + 1;
+        CheckRowsWritten(*column_writers_[i]);
+        column_writers_[i]->Close();
+        total_bytes_written_ += buffered_pagers_[i]->Flush(sink_);
+        column_writers_[i].reset();
+      }
+      column_writers_.clear();
+      buffered_pagers_.clear();
+
       // Ensures all columns have been written
       metadata_->Finish(total_bytes_written_);
     }
@@ -125,9 +169,10 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
   bool closed_;
   int current_column_index_;
   mutable int64_t num_rows_;
+  bool buffered_row_group_;
 
-  void CheckRowsWritten() const {
-    int64_t current_rows = current_column_writer_->rows_written();
+  void CheckRowsWritten(const ColumnWriter& column_writer) const {
+    int64_t current_rows = column_writer.rows_written();
     if (num_rows_ < 0) {
       num_rows_ = current_rows;
       metadata_->set_num_rows(current_rows);
@@ -139,7 +184,27 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
     }
   }
 
+  // Create the writers of all columns of a buffered row group
+  void InitColumns() {
+    for (int i = 0; i < num_columns(); i++) {
+      auto col_meta = metadata_->NextColumnChunk();
+      const ColumnDescriptor* column_descr = col_meta->descr();
+      std::unique_ptr<BufferedPageWriter> pager(new BufferedPageWriter(
+          properties_->compression(column_descr->path()), col_meta,
+          properties_->memory_pool()));
+      buffered_pagers_.push_back(pager.get());
+      column_writers_.push_back(
+          ColumnWriter::Make(col_meta, std::unique_ptr<PageWriter>(pager.release()),
+                             properties_));
+    }
+  }
+
   std::shared_ptr<ColumnWriter> current_column_writer_;
+
+  // Only used by buffered row groups. The page writers are owned by the
+  // column writers
+  std::vector<std::shared_ptr<ColumnWriter>> column_writers_;
+  std::vector<BufferedPageWriter*> buffered_pagers_;
 };
 
 // ----------------------------------------------------------------------
@@ -186,17 +251,9 @@ class FileSerializer : public ParquetFileWriter::Contents {
     return properties_;
   }
 
-  RowGroupWriter* AppendRowGroup() override {
-    if (row_group_writer_) {
-      row_group_writer_->Close();
-    }
-    num_row_groups_++;
-    auto rg_metadata = metadata_->AppendRowGroup();
-    std::unique_ptr<RowGroupWriter::Contents> contents(
-        new RowGroupSerializer(sink_.get(), rg_metadata, properties_.get()));
-    row_group_writer_.reset(new RowGroupWriter(std::move(contents)));
-    return row_group_writer_.get();
-  }
+  RowGroupWriter* AppendRowGroup() override { return AppendRowGroup(false); }
+
+  RowGroupWriter* AppendBufferedRowGroup() override { return AppendRowGroup(true); }
 
   ~FileSerializer() override {
     try {
@@ -228,6 +285,18 @@ class FileSerializer : public ParquetFileWriter::Contents {
   std::unique_ptr<FileMetaDataBuilder> metadata_;
   std::unique_ptr<RowGroupWriter> row_group_writer_;
 
+  RowGroupWriter* AppendRowGroup(bool buffered_row_group) {
+    if (row_group_writer_) {
+      row_group_writer_->Close();
+    }
+    num_row_groups_++;
+    auto rg_metadata = metadata_->AppendRowGroup();
+    std::unique_ptr<RowGroupWriter::Contents> contents(new RowGroupSerializer(
+        sink_.get(), rg_metadata, properties_.get(), buffered_row_group));
+    row_group_writer_.reset(new RowGroupWriter(std::move(contents)));
+    return row_group_writer_.get();
+  }
+
   void StartFile() {
     // Parquet files always start with PAR1
     sink_->Write(PARQUET_MAGIC, 4);
@@ -316,6 +385,15 @@ RowGroupWriter* ParquetFileWriter::AppendRowGroup(int64_t num_rows) {
   return AppendRowGroup();
 }
 
+RowGroupWriter* ParquetFileWriter::AppendBufferedRowGroup() {
+  return contents_->AppendBufferedRowGroup();
+}
+
+RowGroupWriter* ParquetFileWriter::Contents::AppendBufferedRowGroup() {
+  ParquetException::NYI("Buffered row groups are not supported by this writer");
+  return nullptr;
+}
+
 const std::shared_ptr<WriterProperties>& ParquetFileWriter::properties() const {
   return contents_->properties();
 }
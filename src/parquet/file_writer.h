@@ -52,6 +52,9 @@ class PARQUET_EXPORT RowGroupWriter {
     virtual ColumnWriter* NextColumn() = 0;
     virtual int current_column() const = 0;
     virtual void Close() = 0;
+
+    // Only implemented by buffered row groups
+    virtual ColumnWriter* column(int i);
   };
 
   explicit RowGroupWriter(std::unique_ptr<Contents> contents);
@@ -67,6 +70,14 @@ class PARQUET_EXPORT RowGroupWriter {
   int current_column();
   void Close();
 
+  /// Return the ColumnWriter of the indicated column of a row group started
+  /// with ParquetFileWriter::AppendBufferedRowGroup.
+  ///
+  /// The columns can be written in any order and concurrently, one thread per
+  /// ColumnWriter. Their pages are kept in memory and written to the sink in
+  /// schema order by Close.
+  ColumnWriter* column(int i);
+
   int num_columns() const;
 
   /**
@@ -99,6 +110,8 @@ class PARQUET_EXPORT ParquetFileWriter {
 
     virtual RowGroupWriter* AppendRowGroup() = 0;
 
+    virtual RowGroupWriter* AppendBufferedRowGroup();
+
     virtual int64_t num_rows() const = 0;
     virtual int num_columns() const = 0;
     virtual int num_row_groups() const = 0;
@@ -151,6 +164,13 @@ class PARQUET_EXPORT ParquetFileWriter {
   /// until the next call to AppendRowGroup or Close.
   RowGroupWriter* AppendRowGroup();
 
+  /// Construct a RowGroupWriter whose column chunks are buffered in memory
+  /// until the row group is closed, see RowGroupWriter::column.
+  ///
+  /// Ownership is solely within the ParquetFileWriter. The RowGroupWriter is only valid
+  /// until the next call to AppendRowGroup, AppendBufferedRowGroup or Close.
+  RowGroupWriter* AppendBufferedRowGroup();
+
   /// Number of columns.
   ///
   /// This number is fixed during the lifetime of the writer as it is determined via
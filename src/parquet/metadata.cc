@@ -31,6 +31,14 @@
 
 namespace parquet {
 
+// Key of the key-value metadata entry holding the distinct count sketch of a
+// column, followed by the dot-separated column path
+static const char kDistinctCountSketchKeyPrefix[] = "parquet.distinct_count_sketch.";
+
+// Key of the key-value metadata entry of a column chunk whose statistics have
+// truncated min and max
+static const char kStatisticsTruncatedKey[] = "parquet.statistics.truncated";
+
 const ApplicationVersion& ApplicationVersion::PARQUET_251_FIXED_VERSION() {
   static ApplicationVersion version("parquet-mr", 1, 8, 0);
   return version;
@@ -135,6 +143,15 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
     return stats_;
   }
 
+  inline bool statistics_truncated() const {
+    for (const format::KeyValue& kv : column_->meta_data.key_value_metadata) {
+      if (kv.key == kStatisticsTruncatedKey) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   inline Compression::type compression() const {
     return FromThrift(column_->meta_data.codec);
   }
@@ -163,6 +180,22 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
     return column_->meta_data.total_uncompressed_size;
   }
 
+  inline bool has_column_index() const {
+    return column_->__isset.column_index_offset && column_->__isset.column_index_length;
+  }
+
+  inline int64_t column_index_offset() const { return column_->column_index_offset; }
+
+  inline int32_t column_index_length() const { return column_->column_index_length; }
+
+  inline bool has_offset_index() const {
+    return column_->__isset.offset_index_offset && column_->__isset.offset_index_length;
+  }
+
+  inline int64_t offset_index_offset() const { return column_->offset_index_offset; }
+
+  inline int32_t offset_index_length() const { return column_->offset_index_length; }
+
  private:
   mutable std::shared_ptr<RowGroupStatistics> stats_;
   std::vector<Encoding::type> encodings_;
@@ -206,6 +239,10 @@ std::shared_ptr<RowGroupStatistics> ColumnChunkMetaData::statistics() const {
 
 bool ColumnChunkMetaData::is_stats_set() const { return impl_->is_stats_set(); }
 
+bool ColumnChunkMetaData::statistics_truncated() const {
+  return impl_->statistics_truncated();
+}
+
 int64_t ColumnChunkMetaData::has_dictionary_page() const {
   return impl_->has_dictionary_page();
 }
@@ -234,6 +271,26 @@ int64_t ColumnChunkMetaData::total_uncompressed_size() const {
   return impl_->total_uncompressed_size();
 }
 
+bool ColumnChunkMetaData::has_column_index() const { return impl_->has_column_index(); }
+
+int64_t ColumnChunkMetaData::column_index_offset() const {
+  return impl_->column_index_offset();
+}
+
+int32_t ColumnChunkMetaData::column_index_length() const {
+  return impl_->column_index_length();
+}
+
+bool ColumnChunkMetaData::has_offset_index() const { return impl_->has_offset_index(); }
+
+int64_t ColumnChunkMetaData::offset_index_offset() const {
+  return impl_->offset_index_offset();
+}
+
+int32_t ColumnChunkMetaData::offset_index_length() const {
+  return impl_->offset_index_length();
+}
+
 int64_t ColumnChunkMetaData::total_compressed_size() const {
   return impl_->total_compressed_size();
 }
@@ -454,6 +511,21 @@ std::shared_ptr<const KeyValueMetadata> FileMetaData::key_value_metadata() const
   return impl_->key_value_metadata();
 }
 
+std::unique_ptr<HyperLogLog> FileMetaData::distinct_count_sketch(int i) const {
+  std::shared_ptr<const KeyValueMetadata> metadata = impl_->key_value_metadata();
+  if (metadata == nullptr) {
+    return nullptr;
+  }
+  const std::string key =
+      kDistinctCountSketchKeyPrefix + schema()->Column(i)->path()->ToDotString();
+  for (int64_t j = 0; j < metadata->size(); ++j) {
+    if (metadata->key(j) == key) {
+      return HyperLogLog::Deserialize(metadata->value(j));
+    }
+  }
+  return nullptr;
+}
+
 void FileMetaData::WriteTo(OutputStream* dst) { return impl_->WriteTo(dst); }
 
 ApplicationVersion::ApplicationVersion(const std::string& application, int major,
@@ -595,6 +667,20 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
     column_chunk_->meta_data.__set_statistics(stats);
   }
 
+  void SetStatisticsTruncated() {
+    format::KeyValue kv_pair;
+    kv_pair.__set_key(kStatisticsTruncatedKey);
+    kv_pair.__set_value("true");
+    column_chunk_->meta_data.key_value_metadata.push_back(kv_pair);
+    column_chunk_->meta_data.__isset.key_value_metadata = true;
+  }
+
+  void SetDistinctSketch(const HyperLogLog& sketch) {
+    distinct_sketch_.reset(new HyperLogLog(sketch));
+  }
+
+  const HyperLogLog* distinct_sketch() const { return distinct_sketch_.get(); }
+
   void Finish(int64_t num_values, int64_t dictionary_page_offset,
               int64_t index_page_offset, int64_t data_page_offset,
               int64_t compressed_size, int64_t uncompressed_size, bool has_dictionary,
@@ -641,6 +727,7 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
   format::ColumnChunk* column_chunk_;
   const std::shared_ptr<WriterProperties> properties_;
   const ColumnDescriptor* column_;
+  std::unique_ptr<HyperLogLog> distinct_sketch_;
 };
 
 std::unique_ptr<ColumnChunkMetaDataBuilder> ColumnChunkMetaDataBuilder::Make(
@@ -683,6 +770,18 @@ void ColumnChunkMetaDataBuilder::SetStatistics(bool is_signed,
   impl_->SetStatistics(is_signed, result);
 }
 
+void ColumnChunkMetaDataBuilder::SetStatisticsTruncated() {
+  impl_->SetStatisticsTruncated();
+}
+
+void ColumnChunkMetaDataBuilder::SetDistinctSketch(const HyperLogLog& sketch) {
+  impl_->SetDistinctSketch(sketch);
+}
+
+const HyperLogLog* ColumnChunkMetaDataBuilder::distinct_sketch() const {
+  return impl_->distinct_sketch();
+}
+
 class RowGroupMetaDataBuilder::RowGroupMetaDataBuilderImpl {
  public:
   explicit RowGroupMetaDataBuilderImpl(const std::shared_ptr<WriterProperties>& props,
@@ -711,6 +810,10 @@ class RowGroupMetaDataBuilder::RowGroupMetaDataBuilderImpl {
 
   int current_column() { return current_column_; }
 
+  const ColumnChunkMetaDataBuilder* column_chunk(int i) const {
+    return column_builders_[i].get();
+  }
+
   void Finish(int64_t total_bytes_written) {
     if (!(current_column_ == schema_->num_columns())) {
       std::stringstream ss;
@@ -771,6 +874,10 @@ ColumnChunkMetaDataBuilder* RowGroupMetaDataBuilder::NextColumnChunk() {
 
 int RowGroupMetaDataBuilder::current_column() const { return impl_->current_column(); }
 
+const ColumnChunkMetaDataBuilder* RowGroupMetaDataBuilder::column_chunk(int i) const {
+  return impl_->column_chunk(i);
+}
+
 int RowGroupMetaDataBuilder::num_columns() { return impl_->num_columns(); }
 
 int64_t RowGroupMetaDataBuilder::num_rows() { return impl_->num_rows(); }
@@ -828,6 +935,9 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
       }
       metadata_->__isset.key_value_metadata = true;
     }
+    if (properties_->distinct_count_sketches_enabled()) {
+      AppendDistinctCountSketches();
+    }
 
     int32_t file_version = 0;
     switch (properties_->version()) {
@@ -862,6 +972,7 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
     auto file_meta_data = std::unique_ptr<FileMetaData>(new FileMetaData());
     file_meta_data->impl_->metadata_ = std::move(metadata_);
     file_meta_data->impl_->InitSchema();
+    file_meta_data->impl_->InitKeyValueMetadata();
     return file_meta_data;
   }
 
@@ -869,6 +980,36 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
   std::unique_ptr<format::FileMetaData> metadata_;
 
  private:
+  // Merge the distinct count sketches of each column over the row groups, and
+  // add them to the key-value metadata
+  void AppendDistinctCountSketches() {
+    for (int i = 0; i < schema_->num_columns(); ++i) {
+      std::unique_ptr<HyperLogLog> file_sketch;
+      for (const auto& row_group_builder : row_group_builders_) {
+        if (row_group_builder->current_column() <= i) {
+          continue;
+        }
+        const HyperLogLog* sketch = row_group_builder->column_chunk(i)->distinct_sketch();
+        if (sketch == nullptr) {
+          continue;
+        }
+        if (file_sketch) {
+          file_sketch->Merge(*sketch);
+        } else {
+          file_sketch.reset(new HyperLogLog(*sketch));
+        }
+      }
+      if (file_sketch) {
+        format::KeyValue kv_pair;
+        kv_pair.__set_key(kDistinctCountSketchKeyPrefix +
+                          schema_->Column(i)->path()->ToDotString());
+        kv_pair.__set_value(file_sketch->Serialize());
+        metadata_->key_value_metadata.push_back(kv_pair);
+        metadata_->__isset.key_value_metadata = true;
+      }
+    }
+  }
+
   const std::shared_ptr<WriterProperties> properties_;
   std::vector<std::unique_ptr<format::RowGroup>> row_groups_;
   std::vector<std::unique_ptr<RowGroupMetaDataBuilder>> row_group_builders_;
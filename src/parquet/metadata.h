@@ -28,6 +28,7 @@
 #include "parquet/schema.h"
 #include "parquet/statistics.h"
 #include "parquet/types.h"
+#include "parquet/util/hyperloglog.h"
 #include "parquet/util/memory.h"
 #include "parquet/util/visibility.h"
 
@@ -106,6 +107,9 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   std::shared_ptr<schema::ColumnPath> path_in_schema() const;
   bool is_stats_set() const;
   std::shared_ptr<RowGroupStatistics> statistics() const;
+  // true if the writer truncated the min and max of the statistics, which are
+  // then only a lower and an upper bound of the values
+  bool statistics_truncated() const;
   Compression::type compression() const;
   const std::vector<Encoding::type>& encodings() const;
   int64_t has_dictionary_page() const;
@@ -114,6 +118,14 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   int64_t index_page_offset() const;
   int64_t total_compressed_size() const;
   int64_t total_uncompressed_size() const;
+  // location of the ColumnIndex of the page index, if the writer stored one
+  bool has_column_index() const;
+  int64_t column_index_offset() const;
+  int32_t column_index_length() const;
+  // location of the OffsetIndex of the page index, if the writer stored one
+  bool has_offset_index() const;
+  int64_t offset_index_offset() const;
+  int32_t offset_index_length() const;
 
  private:
   explicit ColumnChunkMetaData(const uint8_t* metadata, const ColumnDescriptor* descr,
@@ -177,6 +189,10 @@ class PARQUET_EXPORT FileMetaData {
 
   std::shared_ptr<const KeyValueMetadata> key_value_metadata() const;
 
+  // Distinct values sketch of column i over the whole file, stored if the writer
+  // had distinct count sketches enabled. nullptr if there is none
+  std::unique_ptr<HyperLogLog> distinct_count_sketch(int i) const;
+
  private:
   friend FileMetaDataBuilder;
   explicit FileMetaData(const uint8_t* serialized_metadata, uint32_t* metadata_len);
@@ -202,6 +218,12 @@ class PARQUET_EXPORT ColumnChunkMetaDataBuilder {
   void set_file_path(const std::string& path);
   // column metadata
   void SetStatistics(bool is_signed, const EncodedStatistics& stats);
+  // mark the min and max of the statistics as truncated bounds
+  void SetStatisticsTruncated();
+  // sketch of the distinct values, merged into the file's key-value metadata
+  void SetDistinctSketch(const HyperLogLog& sketch);
+  // nullptr if SetDistinctSketch was not called
+  const HyperLogLog* distinct_sketch() const;
   // get the column descriptor
   const ColumnDescriptor* descr() const;
   // commit the metadata
@@ -231,6 +253,8 @@ class PARQUET_EXPORT RowGroupMetaDataBuilder {
   ~RowGroupMetaDataBuilder();
 
   ColumnChunkMetaDataBuilder* NextColumnChunk();
+  // Builder of the i-th column chunk returned by NextColumnChunk
+  const ColumnChunkMetaDataBuilder* column_chunk(int i) const;
   int num_columns();
   int64_t num_rows();
   int current_column() const;
@@ -26,6 +26,7 @@
 #include "parquet/parquet_version.h"
 #include "parquet/schema.h"
 #include "parquet/types.h"
+#include "parquet/util/executor.h"
 #include "parquet/util/memory.h"
 #include "parquet/util/visibility.h"
 
@@ -81,10 +82,16 @@ ReaderProperties PARQUET_EXPORT default_reader_properties();
 static constexpr int64_t DEFAULT_PAGE_SIZE = 1024 * 1024;
 static constexpr bool DEFAULT_IS_DICTIONARY_ENABLED = true;
 static constexpr int64_t DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT = DEFAULT_PAGE_SIZE;
+static constexpr int64_t DEFAULT_BUFFERED_DICTIONARY_DATA_LIMIT = 64 * 1024 * 1024;
 static constexpr int64_t DEFAULT_WRITE_BATCH_SIZE = 1024;
 static constexpr int64_t DEFAULT_MAX_ROW_GROUP_LENGTH = 64 * 1024 * 1024;
+static constexpr int DEFAULT_PAGE_COMPRESSION_THREADS = 1;
+static constexpr int DEFAULT_MAX_PAGES_IN_FLIGHT = 8;
 static constexpr bool DEFAULT_ARE_STATISTICS_ENABLED = true;
 static constexpr int64_t DEFAULT_MAX_STATISTICS_SIZE = 4096;
+static constexpr bool DEFAULT_IS_STATISTICS_TRUNCATION_ENABLED = false;
+static constexpr bool DEFAULT_IS_DISTINCT_COUNT_ENABLED = false;
+static constexpr bool DEFAULT_ARE_DISTINCT_COUNT_SKETCHES_ENABLED = false;
 static constexpr Encoding::type DEFAULT_ENCODING = Encoding::PLAIN;
 static constexpr ParquetVersion::type DEFAULT_WRITER_VERSION =
     ParquetVersion::PARQUET_1_0;
@@ -97,12 +104,14 @@ class PARQUET_EXPORT ColumnProperties {
                    Compression::type codec = DEFAULT_COMPRESSION_TYPE,
                    bool dictionary_enabled = DEFAULT_IS_DICTIONARY_ENABLED,
                    bool statistics_enabled = DEFAULT_ARE_STATISTICS_ENABLED,
-                   size_t max_stats_size = DEFAULT_MAX_STATISTICS_SIZE)
+                   size_t max_stats_size = DEFAULT_MAX_STATISTICS_SIZE,
+                   bool distinct_count_enabled = DEFAULT_IS_DISTINCT_COUNT_ENABLED)
       : encoding_(encoding),
         codec_(codec),
         dictionary_enabled_(dictionary_enabled),
         statistics_enabled_(statistics_enabled),
-        max_stats_size_(max_stats_size) {}
+        max_stats_size_(max_stats_size),
+        distinct_count_enabled_(distinct_count_enabled) {}
 
   void set_encoding(Encoding::type encoding) { encoding_ = encoding; }
 
@@ -120,6 +129,10 @@ class PARQUET_EXPORT ColumnProperties {
     max_stats_size_ = max_stats_size;
   }
 
+  void set_distinct_count_enabled(bool distinct_count_enabled) {
+    distinct_count_enabled_ = distinct_count_enabled;
+  }
+
   Encoding::type encoding() const { return encoding_; }
 
   Compression::type compression() const { return codec_; }
@@ -130,12 +143,15 @@ class PARQUET_EXPORT ColumnProperties {
 
   size_t max_statistics_size() const { return max_stats_size_; }
 
+  bool distinct_count_enabled() const { return distinct_count_enabled_; }
+
  private:
   Encoding::type encoding_;
   Compression::type codec_;
   bool dictionary_enabled_;
   bool statistics_enabled_;
   size_t max_stats_size_;
+  bool distinct_count_enabled_;
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -145,9 +161,14 @@ class PARQUET_EXPORT WriterProperties {
     Builder()
         : pool_(::arrow::default_memory_pool()),
           dictionary_pagesize_limit_(DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT),
+          buffered_dictionary_data_limit_(DEFAULT_BUFFERED_DICTIONARY_DATA_LIMIT),
           write_batch_size_(DEFAULT_WRITE_BATCH_SIZE),
           max_row_group_length_(DEFAULT_MAX_ROW_GROUP_LENGTH),
           pagesize_(DEFAULT_PAGE_SIZE),
+          page_compression_threads_(DEFAULT_PAGE_COMPRESSION_THREADS),
+          max_pages_in_flight_(DEFAULT_MAX_PAGES_IN_FLIGHT),
+          statistics_truncation_enabled_(DEFAULT_IS_STATISTICS_TRUNCATION_ENABLED),
+          distinct_count_sketches_enabled_(DEFAULT_ARE_DISTINCT_COUNT_SKETCHES_ENABLED),
           version_(DEFAULT_WRITER_VERSION),
           created_by_(DEFAULT_CREATED_BY) {}
     virtual ~Builder() {}
@@ -190,6 +211,16 @@ class PARQUET_EXPORT WriterProperties {
       return this;
     }
 
+    /// The data pages of a dictionary-encoded column chunk are held in memory
+    /// until its dictionary page is written. Once they take up this many bytes,
+    /// the dictionary page is written early and the rest of the column chunk
+    /// falls back to PLAIN encoding, so that the memory of the writer does not
+    /// grow with the size of the row group
+    Builder* buffered_dictionary_data_limit(int64_t limit) {
+      buffered_dictionary_data_limit_ = limit;
+      return this;
+    }
+
     Builder* write_batch_size(int64_t write_batch_size) {
       write_batch_size_ = write_batch_size;
       return this;
@@ -205,6 +236,28 @@ class PARQUET_EXPORT WriterProperties {
       return this;
     }
 
+    /// Compress up to this many data pages of each column chunk at once, on
+    /// the threads of executor(). The pages are still written in order; with
+    /// more than one thread the memory pool must be thread-safe
+    Builder* page_compression_threads(int num_threads) {
+      page_compression_threads_ = num_threads;
+      return this;
+    }
+
+    /// Maximum number of data pages of a column chunk being compressed at
+    /// once; bounds the memory held by page_compression_threads
+    Builder* max_pages_in_flight(int max_pages) {
+      max_pages_in_flight_ = max_pages;
+      return this;
+    }
+
+    /// Run the page compression tasks on executor instead of
+    /// default_executor(), e.g. to share a bounded set of threads between files
+    Builder* executor(const std::shared_ptr<Executor>& executor) {
+      executor_ = executor;
+      return this;
+    }
+
     Builder* version(ParquetVersion::type version) {
       version_ = version;
       return this;
@@ -306,6 +359,70 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_statistics(path->ToDotString());
     }
 
+    /**
+     * Truncate the min and max of BYTE_ARRAY column chunks that are longer than
+     * max_statistics_size, instead of not writing them. The min is cut to a
+     * prefix and the max rounded up to the next prefix, so they remain bounds.
+     * Such column chunks are marked (ColumnChunkMetaData::statistics_truncated)
+     * so that readers do not use the bounds as the exact min and max.
+     */
+    Builder* enable_statistics_truncation() {
+      statistics_truncation_enabled_ = true;
+      return this;
+    }
+
+    Builder* disable_statistics_truncation() {
+      statistics_truncation_enabled_ = false;
+      return this;
+    }
+
+    /**
+     * Estimate the number of distinct values of each column chunk with a
+     * HyperLogLog sketch and write it as the distinct_count of its statistics.
+     */
+    Builder* enable_distinct_count() {
+      default_column_properties_.set_distinct_count_enabled(true);
+      return this;
+    }
+
+    Builder* disable_distinct_count() {
+      default_column_properties_.set_distinct_count_enabled(false);
+      return this;
+    }
+
+    Builder* enable_distinct_count(const std::string& path) {
+      distinct_count_enabled_[path] = true;
+      return this;
+    }
+
+    Builder* enable_distinct_count(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->enable_distinct_count(path->ToDotString());
+    }
+
+    Builder* disable_distinct_count(const std::string& path) {
+      distinct_count_enabled_[path] = false;
+      return this;
+    }
+
+    Builder* disable_distinct_count(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_distinct_count(path->ToDotString());
+    }
+
+    /**
+     * Store the sketches of the columns with distinct counts, merged over all
+     * row groups, in the key-value metadata of the file. They can be merged
+     * across files with FileMetaData::distinct_count_sketch.
+     */
+    Builder* enable_distinct_count_sketches() {
+      distinct_count_sketches_enabled_ = true;
+      return this;
+    }
+
+    Builder* disable_distinct_count_sketches() {
+      distinct_count_sketches_enabled_ = false;
+      return this;
+    }
+
     std::shared_ptr<WriterProperties> build() {
       std::unordered_map<std::string, ColumnProperties> column_properties;
       auto get = [&](const std::string& key) -> ColumnProperties& {
@@ -322,19 +439,31 @@ class PARQUET_EXPORT WriterProperties {
         get(item.first).set_dictionary_enabled(item.second);
       for (const auto& item : statistics_enabled_)
         get(item.first).set_statistics_enabled(item.second);
+      for (const auto& item : distinct_count_enabled_)
+        get(item.first).set_distinct_count_enabled(item.second);
 
       return std::shared_ptr<WriterProperties>(
-          new WriterProperties(pool_, dictionary_pagesize_limit_, write_batch_size_,
-                               max_row_group_length_, pagesize_, version_, created_by_,
+          new WriterProperties(pool_, dictionary_pagesize_limit_,
+                               buffered_dictionary_data_limit_, write_batch_size_,
+                               max_row_group_length_, pagesize_,
+                               page_compression_threads_, max_pages_in_flight_,
+                               executor_, statistics_truncation_enabled_,
+                               distinct_count_sketches_enabled_, version_, created_by_,
                                default_column_properties_, column_properties));
     }
 
    private:
     ::arrow::MemoryPool* pool_;
     int64_t dictionary_pagesize_limit_;
+    int64_t buffered_dictionary_data_limit_;
     int64_t write_batch_size_;
     int64_t max_row_group_length_;
     int64_t pagesize_;
+    int page_compression_threads_;
+    int max_pages_in_flight_;
+    std::shared_ptr<Executor> executor_;
+    bool statistics_truncation_enabled_;
+    bool distinct_count_sketches_enabled_;
     ParquetVersion::type version_;
     std::string created_by_;
 
@@ -344,18 +473,39 @@ class PARQUET_EXPORT WriterProperties {
     std::unordered_map<std::string, Compression::type> codecs_;
     std::unordered_map<std::string, bool> dictionary_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
+    std::unordered_map<std::string, bool> distinct_count_enabled_;
   };
 
   inline ::arrow::MemoryPool* memory_pool() const { return pool_; }
 
   inline int64_t dictionary_pagesize_limit() const { return dictionary_pagesize_limit_; }
 
+  inline int64_t buffered_dictionary_data_limit() const {
+    return buffered_dictionary_data_limit_;
+  }
+
   inline int64_t write_batch_size() const { return write_batch_size_; }
 
   inline int64_t max_row_group_length() const { return max_row_group_length_; }
 
   inline int64_t data_pagesize() const { return pagesize_; }
 
+  inline int page_compression_threads() const { return page_compression_threads_; }
+
+  inline int max_pages_in_flight() const { return max_pages_in_flight_; }
+
+  inline std::shared_ptr<Executor> executor() const {
+    return executor_ ? executor_ : default_executor();
+  }
+
+  inline bool statistics_truncation_enabled() const {
+    return statistics_truncation_enabled_;
+  }
+
+  inline bool distinct_count_sketches_enabled() const {
+    return distinct_count_sketches_enabled_;
+  }
+
   inline ParquetVersion::type version() const { return parquet_version_; }
 
   inline std::string created_by() const { return parquet_created_by_; }
@@ -403,18 +553,32 @@ class PARQUET_EXPORT WriterProperties {
     return column_properties(path).max_statistics_size();
   }
 
+  bool distinct_count_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).distinct_count_enabled();
+  }
+
  private:
   explicit WriterProperties(
       ::arrow::MemoryPool* pool, int64_t dictionary_pagesize_limit,
-      int64_t write_batch_size, int64_t max_row_group_length, int64_t pagesize,
-      ParquetVersion::type version, const std::string& created_by,
+      int64_t buffered_dictionary_data_limit, int64_t write_batch_size,
+      int64_t max_row_group_length, int64_t pagesize,
+      int page_compression_threads, int max_pages_in_flight,
+      const std::shared_ptr<Executor>& executor, bool statistics_truncation_enabled,
+      bool distinct_count_sketches_enabled, ParquetVersion::type version,
+      const std::string& created_by,
       const ColumnProperties& default_column_properties,
       const std::unordered_map<std::string, ColumnProperties>& column_properties)
       : pool_(pool),
         dictionary_pagesize_limit_(dictionary_pagesize_limit),
+        buffered_dictionary_data_limit_(buffered_dictionary_data_limit),
         write_batch_size_(write_batch_size),
         max_row_group_length_(max_row_group_length),
         pagesize_(pagesize),
+        page_compression_threads_(page_compression_threads),
+        max_pages_in_flight_(max_pages_in_flight),
+        executor_(executor),
+        statistics_truncation_enabled_(statistics_truncation_enabled),
+        distinct_count_sketches_enabled_(distinct_count_sketches_enabled),
         parquet_version_(version),
         parquet_created_by_(created_by),
         default_column_properties_(default_column_properties),
@@ -422,9 +586,15 @@ class PARQUET_EXPORT WriterProperties {
 
   ::arrow::MemoryPool* pool_;
   int64_t dictionary_pagesize_limit_;
+  int64_t buffered_dictionary_data_limit_;
   int64_t write_batch_size_;
   int64_t max_row_group_length_;
   int64_t pagesize_;
+  int page_compression_threads_;
+  int max_pages_in_flight_;
+  std::shared_ptr<Executor> executor_;
+  bool statistics_truncation_enabled_;
+  bool distinct_count_sketches_enabled_;
   ParquetVersion::type parquet_version_;
   std::string parquet_created_by_;
   ColumnProperties default_column_properties_;
@@ -17,17 +17,24 @@
 
 #include <fcntl.h>
 #include <gtest/gtest.h>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <exception>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "arrow/io/file.h"
+#include "arrow/io/memory.h"
 
 #include "parquet/column_reader.h"
 #include "parquet/column_scanner.h"
+#include "parquet/column_writer.h"
 #include "parquet/file_reader.h"
+#include "parquet/file_writer.h"
 #include "parquet/printer.h"
 #include "parquet/util/memory.h"
 #include "parquet/util/test-common.h"
@@ -167,6 +174,52 @@ TEST_F(TestAllTypesPlain, ColumnSelectionOutOfRange) {
   ASSERT_THROW(printer2.DebugPrint(ss, columns), ParquetException);
 }
 
+// Pages of a column chunk, read by the calling thread
+std::vector<std::string> ReadColumnChunkPages(ParquetFileReader* reader, int row_group,
+                                              int column) {
+  std::vector<std::string> pages;
+  std::unique_ptr<PageReader> page_reader =
+      reader->RowGroup(row_group)->GetColumnPageReader(column);
+  std::shared_ptr<Page> page;
+  while ((page = page_reader->NextPage()) != nullptr) {
+    pages.emplace_back(reinterpret_cast<const char*>(page->data()), page->size());
+  }
+  return pages;
+}
+
+// Read the column chunks of one reader from num_threads threads at once, each
+// in its own order, and compare the pages to those of a sequential read
+void CheckConcurrentReads(ParquetFileReader* reader, int num_threads) {
+  const int num_columns = reader->metadata()->num_columns();
+  const int num_chunks = reader->metadata()->num_row_groups() * num_columns;
+  std::vector<std::vector<std::string>> expected;
+  for (int i = 0; i < num_chunks; ++i) {
+    expected.push_back(ReadColumnChunkPages(reader, i / num_columns, i % num_columns));
+  }
+
+  std::atomic<int> num_failures(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int k = 0; k < 4 * num_chunks; ++k) {
+        const int i = (t + k * (t + 1)) % num_chunks;
+        try {
+          if (ReadColumnChunkPages(reader, i / num_columns, i % num_columns) !=
+              expected[i]) {
+            ++num_failures;
+          }
+        } catch (const std::exception&) {
+          ++num_failures;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(0, num_failures);
+}
+
 class TestLocalFile : public ::testing::Test {
  public:
   void SetUp() {
@@ -232,6 +285,79 @@ TEST_F(TestLocalFile, OpenWithMetadata) {
   ASSERT_EQ(metadata.get(), reader2->metadata().get());
 }
 
+TEST_F(TestLocalFile, ConcurrentReads) {
+  // Local files are read with pread
+  std::unique_ptr<ParquetFileReader> reader = ParquetFileReader::Open(handle);
+  ASSERT_NO_FATAL_FAILURE(CheckConcurrentReads(reader.get(), 8));
+
+  // Reads of memory maps are serialized
+  reader = ParquetFileReader::OpenFile(alltypes_plain(), true);
+  ASSERT_NO_FATAL_FAILURE(CheckConcurrentReads(reader.get(), 8));
+}
+
+TEST_F(TestLocalFile, ReadAtKeepsPosition) {
+  ArrowInputFile source(handle);
+  const int64_t size = source.Size();
+
+  uint8_t magic[4];
+  ASSERT_EQ(4, source.Read(4, magic));
+  ASSERT_EQ(0, memcmp("PAR1", magic, 4));
+  ASSERT_EQ(4, source.ReadAt(size - 4, 4, magic));
+  ASSERT_EQ(0, memcmp("PAR1", magic, 4));
+  ASSERT_EQ(4, source.ReadAt(size - 4, 4)->size());
+  ASSERT_EQ(4, source.Tell());
+
+  // Reads go on from the position of the previous Read
+  std::shared_ptr<Buffer> expected = source.ReadAt(4, 16);
+  std::shared_ptr<Buffer> actual = source.Read(16);
+  ASSERT_TRUE(expected->Equals(*actual));
+  ASSERT_EQ(20, source.Tell());
+}
+
+TEST(TestConcurrentReads, ManyRowGroups) {
+  const int num_columns = 4;
+  const int num_row_groups = 8;
+  const int num_rows = 1000;
+
+  schema::NodeVector fields;
+  for (int i = 0; i < num_columns; ++i) {
+    fields.push_back(schema::Int64("c" + std::to_string(i), Repetition::REQUIRED));
+  }
+  auto schema = std::static_pointer_cast<schema::GroupNode>(
+      schema::GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+  // Small pages, so that chunks span many reads
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(
+      sink, schema, WriterProperties::Builder().data_pagesize(1024)->build());
+  std::vector<int64_t> values(num_rows);
+  for (int rg = 0; rg < num_row_groups; ++rg) {
+    RowGroupWriter* row_group_writer = file_writer->AppendRowGroup();
+    for (int i = 0; i < num_columns; ++i) {
+      for (int row = 0; row < num_rows; ++row) {
+        values[row] = (rg * num_columns + i) * num_rows + row;
+      }
+      auto column_writer = static_cast<Int64Writer*>(row_group_writer->NextColumn());
+      column_writer->WriteBatch(num_rows, nullptr, nullptr, values.data());
+      column_writer->Close();
+    }
+    row_group_writer->Close();
+  }
+  file_writer->Close();
+  auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+
+  std::unique_ptr<ParquetFileReader> reader = ParquetFileReader::Open(source);
+  ASSERT_EQ(num_row_groups, reader->metadata()->num_row_groups());
+  ASSERT_NO_FATAL_FAILURE(CheckConcurrentReads(reader.get(), 16));
+
+  // Each column chunk has a stream of its own
+  ReaderProperties properties;
+  properties.enable_buffered_stream();
+  properties.set_buffer_size(512);
+  reader = ParquetFileReader::Open(source, properties);
+  ASSERT_NO_FATAL_FAILURE(CheckConcurrentReads(reader.get(), 16));
+}
+
 TEST(TestFileReaderAdHoc, NationDictTruncatedDataPage) {
   // PARQUET-816. Some files generated by older Parquet implementations may
   // contain malformed data page metadata, and we can successfully decode them
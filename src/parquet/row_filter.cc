@@ -0,0 +1,94 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/row_filter.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "arrow/util/bit-util.h"
+
+#include "parquet/exception.h"
+#include "parquet/file_reader.h"
+#include "parquet/metadata.h"
+
+namespace parquet {
+
+template <typename DType>
+void TypedColumnPredicate<DType>::Evaluate(ColumnReader* reader,
+                                           const RowSelection& candidates,
+                                           uint8_t* selection) const {
+  if (reader->type() != DType::type_num) {
+    std::stringstream ss;
+    ss << "Predicate on " << TypeToString(DType::type_num)
+       << " values cannot be applied to " << TypeToString(reader->type())
+       << " column " << reader->descr()->path()->ToDotString();
+    throw ParquetException(ss.str());
+  }
+  auto typed_reader = static_cast<TypedColumnReader<DType>*>(reader);
+  typed_reader->SetPredicate(predicate_);
+
+  int64_t position = 0;
+  for (const RowSelection::Range& range : candidates.ranges()) {
+    if (typed_reader->Skip(range.offset - position) != range.offset - position) {
+      ParquetException::EofException();
+    }
+    int64_t num_selected = 0;
+    if (typed_reader->ReadFilter(range.length, selection, range.offset,
+                                 &num_selected) != range.length) {
+      ParquetException::EofException();
+    }
+    position = range.end();
+  }
+}
+
+RowSelection RowFilter::Evaluate(RowGroupReader* row_group) const {
+  const RowGroupMetaData* metadata = row_group->metadata();
+  const int64_t num_rows = metadata->num_rows();
+
+  RowSelection selection = RowSelection::All(num_rows);
+  std::vector<uint8_t> bitmap(::arrow::BitUtil::BytesForBits(num_rows));
+  for (const std::shared_ptr<ColumnPredicate>& predicate : predicates_) {
+    if (selection.empty()) {
+      break;
+    }
+    const int column_index = predicate->column_index();
+    if (column_index < 0 || column_index >= metadata->num_columns()) {
+      std::stringstream ss;
+      ss << "Predicate on column " << column_index << " but the row group only has "
+         << metadata->num_columns() << " columns";
+      throw ParquetException(ss.str());
+    }
+
+    std::fill(bitmap.begin(), bitmap.end(), 0);
+    std::shared_ptr<ColumnReader> reader = row_group->Column(column_index);
+    predicate->Evaluate(reader.get(), selection, bitmap.data());
+    selection = RowSelection::FromBitmap(bitmap.data(), 0, num_rows);
+  }
+  return selection;
+}
+
+template class PARQUET_TEMPLATE_EXPORT TypedColumnPredicate<BooleanType>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnPredicate<Int32Type>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnPredicate<Int64Type>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnPredicate<Int96Type>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnPredicate<FloatType>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnPredicate<DoubleType>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnPredicate<ByteArrayType>;
+template class PARQUET_TEMPLATE_EXPORT TypedColumnPredicate<FLBAType>;
+
+}  // namespace parquet
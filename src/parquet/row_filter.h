@@ -0,0 +1,125 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_ROW_FILTER_H
+#define PARQUET_ROW_FILTER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "parquet/column_reader.h"
+#include "parquet/row_selection.h"
+#include "parquet/types.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+class RowGroupReader;
+
+/// \brief A predicate on the values of one non-repeated leaf column. Null
+/// values never satisfy it.
+///
+/// The predicate is evaluated with TypedColumnReader::ReadFilter, so for
+/// dictionary-encoded column chunks it is evaluated once per dictionary entry.
+class PARQUET_EXPORT ColumnPredicate {
+ public:
+  virtual ~ColumnPredicate() = default;
+
+  template <typename DType>
+  static std::shared_ptr<ColumnPredicate> Make(
+      int column_index, const typename TypedColumnReader<DType>::Predicate& predicate);
+
+  /// \brief Index of the leaf column in the file schema
+  int column_index() const { return column_index_; }
+
+  /// \brief Evaluate the predicate on the candidate rows of the column chunk
+  /// read by reader, and set bit i of selection for each candidate row i that
+  /// satisfies it. The other rows are skipped without being decoded and their
+  /// bits are left untouched. Throws ParquetException if the column does not
+  /// have the physical type of the predicate or is repeated
+  virtual void Evaluate(ColumnReader* reader, const RowSelection& candidates,
+                        uint8_t* selection) const = 0;
+
+ protected:
+  explicit ColumnPredicate(int column_index) : column_index_(column_index) {}
+
+ private:
+  int column_index_;
+};
+
+template <typename DType>
+class PARQUET_EXPORT TypedColumnPredicate : public ColumnPredicate {
+ public:
+  typedef typename TypedColumnReader<DType>::Predicate Predicate;
+
+  TypedColumnPredicate(int column_index, const Predicate& predicate)
+      : ColumnPredicate(column_index), predicate_(predicate) {}
+
+  void Evaluate(ColumnReader* reader, const RowSelection& candidates,
+                uint8_t* selection) const override;
+
+ private:
+  Predicate predicate_;
+};
+
+template <typename DType>
+std::shared_ptr<ColumnPredicate> ColumnPredicate::Make(
+    int column_index, const typename TypedColumnReader<DType>::Predicate& predicate) {
+  return std::make_shared<TypedColumnPredicate<DType>>(column_index, predicate);
+}
+
+/// \brief A conjunction of column predicates, used to select the rows of a row
+/// group before reading its other columns (late materialization)
+class PARQUET_EXPORT RowFilter {
+ public:
+  /// \brief A filter without predicates, which selects all rows
+  RowFilter() {}
+
+  explicit RowFilter(const std::vector<std::shared_ptr<ColumnPredicate>>& predicates)
+      : predicates_(predicates) {}
+
+  const std::vector<std::shared_ptr<ColumnPredicate>>& predicates() const {
+    return predicates_;
+  }
+
+  bool empty() const { return predicates_.empty(); }
+
+  /// \brief Return the rows of the row group that satisfy all predicates.
+  ///
+  /// The predicates are evaluated in order, each one only on the rows that
+  /// satisfy all of the previous ones; the other rows are skipped without being
+  /// decoded. Once no row is left, the remaining predicate columns are not read
+  /// at all, so the most selective predicates should come first
+  RowSelection Evaluate(RowGroupReader* row_group) const;
+
+ private:
+  std::vector<std::shared_ptr<ColumnPredicate>> predicates_;
+};
+
+extern template class PARQUET_EXPORT TypedColumnPredicate<BooleanType>;
+extern template class PARQUET_EXPORT TypedColumnPredicate<Int32Type>;
+extern template class PARQUET_EXPORT TypedColumnPredicate<Int64Type>;
+extern template class PARQUET_EXPORT TypedColumnPredicate<Int96Type>;
+extern template class PARQUET_EXPORT TypedColumnPredicate<FloatType>;
+extern template class PARQUET_EXPORT TypedColumnPredicate<DoubleType>;
+extern template class PARQUET_EXPORT TypedColumnPredicate<ByteArrayType>;
+extern template class PARQUET_EXPORT TypedColumnPredicate<FLBAType>;
+
+}  // namespace parquet
+
+#endif  // PARQUET_ROW_FILTER_H
@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "parquet/exception.h"
+#include "parquet/row_selection.h"
+
+namespace parquet {
+
+namespace test {
+
+static void AssertRanges(const std::vector<RowSelection::Range>& expected,
+                         const RowSelection& selection) {
+  ASSERT_EQ(expected.size(), selection.ranges().size());
+  int64_t num_rows_selected = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i].offset, selection.ranges()[i].offset);
+    ASSERT_EQ(expected[i].length, selection.ranges()[i].length);
+    num_rows_selected += expected[i].length;
+  }
+  ASSERT_EQ(num_rows_selected, selection.num_rows_selected());
+}
+
+TEST(TestRowSelection, All) {
+  ASSERT_NO_FATAL_FAILURE(AssertRanges({{0, 100}}, RowSelection::All(100)));
+  ASSERT_TRUE(RowSelection::All(0).empty());
+  ASSERT_TRUE(RowSelection().empty());
+  ASSERT_EQ(0, RowSelection().end());
+}
+
+TEST(TestRowSelection, FromRanges) {
+  // Empty ranges are dropped and adjacent ranges merged
+  RowSelection selection =
+      RowSelection::FromRanges({{0, 10}, {10, 5}, {20, 0}, {30, 10}, {50, 1}});
+  ASSERT_NO_FATAL_FAILURE(AssertRanges({{0, 15}, {30, 10}, {50, 1}}, selection));
+  ASSERT_EQ(51, selection.end());
+
+  // Unsorted, overlapping and negative ranges are rejected
+  ASSERT_THROW(RowSelection::FromRanges({{10, 5}, {0, 5}}), ParquetException);
+  ASSERT_THROW(RowSelection::FromRanges({{0, 10}, {5, 10}}), ParquetException);
+  ASSERT_THROW(RowSelection::FromRanges({{-1, 10}}), ParquetException);
+  ASSERT_THROW(RowSelection::FromRanges({{0, -1}}), ParquetException);
+}
+
+TEST(TestRowSelection, FromBitmap) {
+  // Bits 1-3, 8-9 and 15, starting at bit offset 2
+  const std::vector<uint8_t> bitmap = {0x38, 0x0C, 0x02};
+  RowSelection selection = RowSelection::FromBitmap(bitmap.data(), 2, 16);
+  ASSERT_NO_FATAL_FAILURE(AssertRanges({{1, 3}, {8, 2}, {15, 1}}, selection));
+
+  const std::vector<uint8_t> none = {0x00, 0x00};
+  ASSERT_TRUE(RowSelection::FromBitmap(none.data(), 0, 16).empty());
+
+  const std::vector<uint8_t> all = {0xFF, 0x0F};
+  ASSERT_NO_FATAL_FAILURE(
+      AssertRanges({{0, 12}}, RowSelection::FromBitmap(all.data(), 0, 12)));
+}
+
+TEST(TestRowSelection, Intersects) {
+  RowSelection selection = RowSelection::FromRanges({{10, 10}, {40, 5}});
+  ASSERT_FALSE(selection.Intersects(0, 10));
+  ASSERT_TRUE(selection.Intersects(0, 11));
+  ASSERT_TRUE(selection.Intersects(19, 1));
+  ASSERT_FALSE(selection.Intersects(20, 20));
+  ASSERT_TRUE(selection.Intersects(20, 21));
+  ASSERT_TRUE(selection.Intersects(30, 100));
+  ASSERT_FALSE(selection.Intersects(45, 100));
+  ASSERT_FALSE(selection.Intersects(10, 0));
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/row_selection.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "arrow/util/bit-util.h"
+
+#include "parquet/exception.h"
+
+namespace parquet {
+
+RowSelection RowSelection::All(int64_t num_rows) {
+  RowSelection result;
+  result.Append(0, num_rows);
+  return result;
+}
+
+RowSelection RowSelection::FromRanges(const std::vector<Range>& ranges) {
+  RowSelection result;
+  for (const Range& range : ranges) {
+    if (range.offset < 0 || range.length < 0) {
+      std::stringstream ss;
+      ss << "Invalid row range: offset " << range.offset << ", length "
+         << range.length;
+      throw ParquetException(ss.str());
+    }
+    if (range.offset < result.end()) {
+      std::stringstream ss;
+      ss << "Row ranges must be sorted and non-overlapping, but range at offset "
+         << range.offset << " starts before row " << result.end();
+      throw ParquetException(ss.str());
+    }
+    result.Append(range.offset, range.length);
+  }
+  return result;
+}
+
+RowSelection RowSelection::FromBitmap(const uint8_t* bitmap, int64_t bitmap_offset,
+                                      int64_t num_rows) {
+  RowSelection result;
+  ::arrow::internal::BitmapReader reader(bitmap, bitmap_offset, num_rows);
+  int64_t run_start = 0;
+  bool in_run = false;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    const bool is_set = reader.IsSet();
+    if (is_set && !in_run) {
+      run_start = i;
+    } else if (!is_set && in_run) {
+      result.Append(run_start, i - run_start);
+    }
+    in_run = is_set;
+    reader.Next();
+  }
+  if (in_run) {
+    result.Append(run_start, num_rows - run_start);
+  }
+  return result;
+}
+
+bool RowSelection::Intersects(int64_t offset, int64_t length) const {
+  if (length <= 0) {
+    return false;
+  }
+  // First range ending after offset
+  auto it = std::upper_bound(
+      ranges_.begin(), ranges_.end(), offset,
+      [](int64_t row, const Range& range) { return row < range.end(); });
+  return it != ranges_.end() && it->offset < offset + length;
+}
+
+bool RowSelection::Equals(const RowSelection& other) const {
+  if (ranges_.size() != other.ranges_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < ranges_.size(); ++i) {
+    if (ranges_[i].offset != other.ranges_[i].offset ||
+        ranges_[i].length != other.ranges_[i].length) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void RowSelection::Append(int64_t offset, int64_t length) {
+  if (length == 0) {
+    return;
+  }
+  if (!ranges_.empty() && ranges_.back().end() == offset) {
+    ranges_.back().length += length;
+  } else {
+    ranges_.push_back({offset, length});
+  }
+  num_rows_selected_ += length;
+}
+
+}  // namespace parquet
@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_ROW_SELECTION_H
+#define PARQUET_ROW_SELECTION_H
+
+#include <cstdint>
+#include <vector>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+/// \brief A set of rows to read from a row group, stored as sorted,
+/// non-overlapping ranges of row numbers relative to the start of the row
+/// group.
+///
+/// Readers use the gaps between the ranges to skip the unselected rows
+/// without materializing them.
+class PARQUET_EXPORT RowSelection {
+ public:
+  struct Range {
+    int64_t offset;
+    int64_t length;
+
+    int64_t end() const { return offset + length; }
+  };
+
+  /// \brief An empty selection
+  RowSelection() : num_rows_selected_(0) {}
+
+  /// \brief Select the rows [0, num_rows)
+  static RowSelection All(int64_t num_rows);
+
+  /// \brief Select the given ranges, which must be sorted by offset and must
+  /// not overlap. Adjacent ranges are merged and empty ranges are dropped.
+  /// Throws ParquetException if the ranges are invalid
+  static RowSelection FromRanges(const std::vector<Range>& ranges);
+
+  /// \brief Select row i for each set bit i of the num_rows bits of bitmap
+  /// starting at bit bitmap_offset
+  static RowSelection FromBitmap(const uint8_t* bitmap, int64_t bitmap_offset,
+                                 int64_t num_rows);
+
+  const std::vector<Range>& ranges() const { return ranges_; }
+
+  /// \brief Total number of selected rows
+  int64_t num_rows_selected() const { return num_rows_selected_; }
+
+  bool empty() const { return ranges_.empty(); }
+
+  /// \brief One past the last selected row, or 0 if nothing is selected
+  int64_t end() const { return ranges_.empty() ? 0 : ranges_.back().end(); }
+
+  /// \brief Return true if any row of [offset, offset + length) is selected
+  bool Intersects(int64_t offset, int64_t length) const;
+
+  bool Equals(const RowSelection& other) const;
+
+ private:
+  void Append(int64_t offset, int64_t length);
+
+  std::vector<Range> ranges_;
+  int64_t num_rows_selected_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_ROW_SELECTION_H
@@ -22,6 +22,8 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <random>
+#include <type_traits>
 #include <vector>
 
 #include "parquet/column_reader.h"
@@ -777,5 +779,290 @@ TEST(TestStatisticsDoubleNaN, NaNValues) {
   ASSERT_EQ(min, -3.0);
   ASSERT_EQ(max, 4.0);
 }
+
+// The min/max kernels against a plain loop over the valid values, for the
+// signed and unsigned orders, and batches of every length modulo the vectors
+template <typename TestType>
+class TestMinMaxKernels : public ::testing::Test {
+ public:
+  using T = typename TestType::c_type;
+
+  // Random values of both signs, with some NaNs for the floating point types
+  std::vector<T> MakeValues(int length, std::mt19937* gen) {
+    std::uniform_int_distribution<int> dist(-1000000, 1000000);
+    std::vector<T> values(length);
+    for (int i = 0; i < length; i++) {
+      values[i] = static_cast<T>(dist(*gen));
+      if (std::is_floating_point<T>::value && dist(*gen) % 7 == 0) {
+        values[i] = std::numeric_limits<T>::quiet_NaN();
+      }
+    }
+    return values;
+  }
+
+  bool Less(const T& a, const T& b, bool unsigned_order) {
+    if (unsigned_order) {
+      return static_cast<uint64_t>(static_cast<int64_t>(a)) <
+             static_cast<uint64_t>(static_cast<int64_t>(b));
+    }
+    return a < b;
+  }
+
+  void CheckMinMax(const ColumnDescriptor* descr, const std::vector<T>& values,
+                   const uint8_t* valid_bits, int64_t valid_bits_offset) {
+    const bool unsigned_order = SortOrder::UNSIGNED == descr->sort_order();
+    bool found = false;
+    T min = T(), max = T();
+    int64_t num_not_null = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+      if (valid_bits && !::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+        continue;
+      }
+      num_not_null++;
+      if (values[i] != values[i]) continue;
+      if (!found || Less(values[i], min, unsigned_order)) min = values[i];
+      if (!found || Less(max, values[i], unsigned_order)) max = values[i];
+      found = true;
+    }
+
+    TypedRowGroupStatistics<TestType> stats(descr);
+    const int64_t num_null = static_cast<int64_t>(values.size()) - num_not_null;
+    if (valid_bits) {
+      stats.UpdateSpaced(values.data(), valid_bits, valid_bits_offset, num_not_null,
+                         num_null);
+    } else {
+      stats.Update(values.data(), num_not_null, 0);
+    }
+    ASSERT_EQ(found, stats.HasMinMax());
+    if (found) {
+      ASSERT_EQ(min, stats.min());
+      ASSERT_EQ(max, stats.max());
+    }
+  }
+};
+
+TYPED_TEST_CASE(TestMinMaxKernels, NumericTypes);
+
+TYPED_TEST(TestMinMaxKernels, MatchScalar) {
+  std::mt19937 gen(42);
+  std::vector<LogicalType::type> logical_types = {LogicalType::NONE};
+  if (TypeParam::type_num == Type::INT32) {
+    logical_types.push_back(LogicalType::UINT_32);
+  } else if (TypeParam::type_num == Type::INT64) {
+    logical_types.push_back(LogicalType::UINT_64);
+  }
+
+  for (LogicalType::type logical_type : logical_types) {
+    NodePtr node =
+        PrimitiveNode::Make("c", Repetition::OPTIONAL, TypeParam::type_num, logical_type);
+    ColumnDescriptor descr(node, 1, 0);
+    for (int length : {1, 3, 8, 17, 64, 1000, 1001}) {
+      std::vector<typename TypeParam::c_type> values = this->MakeValues(length, &gen);
+      ASSERT_NO_FATAL_FAILURE(this->CheckMinMax(&descr, values, nullptr, 0));
+
+      // Runs of valid and null values, with mixed bytes in between
+      std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(length + 3), 0);
+      for (int i = 0; i < length; i++) {
+        if ((i / 24) % 3 == 0 || ((i / 24) % 3 == 1 && gen() % 2 == 0)) {
+          ::arrow::BitUtil::SetBit(valid_bits.data(), i + 3);
+        }
+      }
+      ASSERT_NO_FATAL_FAILURE(this->CheckMinMax(&descr, values, valid_bits.data(), 3));
+    }
+  }
+}
+
+TEST(TestEncodedStatistics, TruncateMinMax) {
+  EncodedStatistics stats;
+  stats.set_min("abcdef").set_max("abz\xff\xff").set_null_count(1);
+  EncodedStatistics copy = stats;
+
+  // Bounds that fit are kept
+  ASSERT_FALSE(stats.TruncateMinMax(6, false));
+  ASSERT_EQ("abcdef", stats.min());
+  ASSERT_EQ("abz\xff\xff", stats.max());
+
+  // The max is rounded up past the greatest bytes, as unsigned or signed bytes
+  ASSERT_TRUE(stats.TruncateMinMax(4, false));
+  ASSERT_EQ("abcd", stats.min());
+  ASSERT_EQ("ab{", stats.max());
+  ASSERT_TRUE(stats.has_min && stats.has_max);
+  // Copies of the statistics are left alone
+  ASSERT_EQ("abcdef", copy.min());
+
+  ASSERT_TRUE(copy.TruncateMinMax(4, true));
+  ASSERT_EQ(std::string("abz\x00", 4), copy.max());
+
+  // A max of greatest bytes has no greater prefix
+  EncodedStatistics all_greatest;
+  all_greatest.set_min("\x7f\x7f").set_max("\x7f\x7f\x7f").set_null_count(0);
+  ASSERT_FALSE(all_greatest.TruncateMinMax(2, true));
+  ASSERT_FALSE(all_greatest.has_min || all_greatest.has_max);
+  ASSERT_TRUE(all_greatest.is_set());
+  ASSERT_EQ(0U, all_greatest.max_stat_length());
+}
+
+// Aggregates are answered from the column chunk statistics where they are
+// available and by scanning the column chunks otherwise
+TEST(TestColumnAggregates, StatisticsAndScan) {
+  constexpr int kNumRowGroups = 3;
+  constexpr int kRowsPerRowGroup = 100;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("with_stats", Repetition::OPTIONAL, Type::INT32),
+       PrimitiveNode::Make("without_stats", Repetition::OPTIONAL, Type::INT32),
+       PrimitiveNode::Make("required", Repetition::REQUIRED, Type::INT64)});
+
+  std::shared_ptr<WriterProperties> props =
+      WriterProperties::Builder().disable_statistics("without_stats")->build();
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema), props);
+  for (int r = 0; r < kNumRowGroups; ++r) {
+    // Every tenth row is null
+    std::vector<int16_t> def_levels;
+    std::vector<int32_t> values;
+    std::vector<int64_t> required_values;
+    for (int i = r * kRowsPerRowGroup; i < (r + 1) * kRowsPerRowGroup; ++i) {
+      def_levels.push_back(i % 10 == 0 ? 0 : 1);
+      if (i % 10 != 0) {
+        values.push_back(i);
+      }
+      required_values.push_back(-i);
+    }
+    auto rg_writer = file_writer->AppendRowGroup();
+    for (int c = 0; c < 2; ++c) {
+      static_cast<Int32Writer*>(rg_writer->NextColumn())
+          ->WriteBatch(kRowsPerRowGroup, def_levels.data(), nullptr, values.data());
+    }
+    static_cast<Int64Writer*>(rg_writer->NextColumn())
+        ->WriteBatch(kRowsPerRowGroup, nullptr, nullptr, required_values.data());
+    rg_writer->Close();
+  }
+  file_writer->Close();
+
+  auto buffer = sink->GetBuffer();
+  auto file_reader =
+      ParquetFileReader::Open(std::make_shared<arrow::io::BufferReader>(buffer));
+
+  for (int c = 0; c < 2; ++c) {
+    ColumnAggregates aggregates = file_reader->ComputeAggregates(c);
+    ASSERT_EQ(kNumRowGroups * kRowsPerRowGroup, aggregates.num_rows);
+    ASSERT_EQ(kNumRowGroups * kRowsPerRowGroup / 10, aggregates.null_count);
+    ASSERT_EQ(kNumRowGroups * kRowsPerRowGroup * 9 / 10, aggregates.num_values);
+    auto min_max = std::static_pointer_cast<Int32Statistics>(aggregates.min_max);
+    ASSERT_TRUE(min_max->HasMinMax());
+    ASSERT_EQ(1, min_max->min());
+    ASSERT_EQ(kNumRowGroups * kRowsPerRowGroup - 1, min_max->max());
+    ASSERT_EQ(0, aggregates.num_row_groups_from_page_index);
+    if (c == 0) {
+      ASSERT_EQ(kNumRowGroups, aggregates.num_row_groups_from_metadata);
+      ASSERT_EQ(0, aggregates.num_row_groups_scanned);
+      ASSERT_EQ(0, aggregates.num_rows_scanned);
+    } else {
+      ASSERT_EQ(0, aggregates.num_row_groups_from_metadata);
+      ASSERT_EQ(kNumRowGroups, aggregates.num_row_groups_scanned);
+      ASSERT_EQ(kNumRowGroups * kRowsPerRowGroup, aggregates.num_rows_scanned);
+    }
+  }
+
+  // Without min and max, the counts of the column without statistics still
+  // need a scan, but those of a required column come from the metadata
+  ColumnAggregates counts = file_reader->ComputeAggregates(1, false);
+  ASSERT_FALSE(counts.min_max);
+  ASSERT_EQ(kNumRowGroups * kRowsPerRowGroup / 10, counts.null_count);
+  ASSERT_EQ(kNumRowGroups, counts.num_row_groups_scanned);
+
+  counts = file_reader->ComputeAggregates(2, false);
+  ASSERT_EQ(0, counts.null_count);
+  ASSERT_EQ(kNumRowGroups * kRowsPerRowGroup, counts.num_values);
+  ASSERT_EQ(kNumRowGroups, counts.num_row_groups_from_metadata);
+
+  ColumnAggregates required = file_reader->ComputeAggregates(2);
+  auto min_max = std::static_pointer_cast<Int64Statistics>(required.min_max);
+  ASSERT_EQ(-(kNumRowGroups * kRowsPerRowGroup - 1), min_max->min());
+  ASSERT_EQ(0, min_max->max());
+  ASSERT_EQ(kNumRowGroups, required.num_row_groups_from_metadata);
+
+  ASSERT_THROW(file_reader->ComputeAggregates(3), ParquetException);
+}
+
+// Truncated min and max of BYTE_ARRAY columns are bounds, not the MIN and MAX
+TEST(TestColumnAggregates, TruncatedStatistics) {
+  constexpr int kNumRowGroups = 2;
+  constexpr int kRowsPerRowGroup = 50;
+  constexpr size_t kMaxStatisticsSize = 8;
+  NodePtr schema = GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {PrimitiveNode::Make("long", Repetition::REQUIRED, Type::BYTE_ARRAY),
+       PrimitiveNode::Make("short", Repetition::REQUIRED, Type::BYTE_ARRAY)});
+
+  std::shared_ptr<WriterProperties> props = WriterProperties::Builder()
+                                                .max_statistics_size(kMaxStatisticsSize)
+                                                ->enable_statistics_truncation()
+                                                ->build();
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  auto file_writer =
+      ParquetFileWriter::Open(sink, std::static_pointer_cast<GroupNode>(schema), props);
+  for (int r = 0; r < kNumRowGroups; ++r) {
+    // "long" values only differ after the first kMaxStatisticsSize bytes
+    std::vector<std::string> strings[2];
+    for (int i = r * kRowsPerRowGroup; i < (r + 1) * kRowsPerRowGroup; ++i) {
+      const std::string number = std::to_string(1000 + i);
+      strings[0].push_back(std::string(kMaxStatisticsSize, 'x') + number);
+      strings[1].push_back(number);
+    }
+    auto rg_writer = file_writer->AppendRowGroup();
+    for (int c = 0; c < 2; ++c) {
+      std::vector<ByteArray> values;
+      for (const std::string& value : strings[c]) {
+        values.push_back(ByteArray(static_cast<uint32_t>(value.size()),
+                                   reinterpret_cast<const uint8_t*>(value.data())));
+      }
+      static_cast<ByteArrayWriter*>(rg_writer->NextColumn())
+          ->WriteBatch(kRowsPerRowGroup, nullptr, nullptr, values.data());
+    }
+    rg_writer->Close();
+  }
+  file_writer->Close();
+
+  auto buffer = sink->GetBuffer();
+  auto file_reader =
+      ParquetFileReader::Open(std::make_shared<arrow::io::BufferReader>(buffer));
+
+  auto column_chunk = file_reader->metadata()->RowGroup(0)->ColumnChunk(0);
+  ASSERT_TRUE(column_chunk->statistics_truncated());
+  auto stats = std::static_pointer_cast<ByteArrayStatistics>(column_chunk->statistics());
+  ASSERT_TRUE(stats->HasMinMax());
+  ASSERT_EQ(std::string(kMaxStatisticsSize, 'x'), ByteArrayToString(stats->min()));
+  ASSERT_EQ(std::string(kMaxStatisticsSize - 1, 'x') + "y",
+            ByteArrayToString(stats->max()));
+  column_chunk = file_reader->metadata()->RowGroup(0)->ColumnChunk(1);
+  ASSERT_FALSE(column_chunk->statistics_truncated());
+
+  // The truncated column is scanned for its MIN and MAX
+  ColumnAggregates aggregates = file_reader->ComputeAggregates(0);
+  auto min_max = std::static_pointer_cast<ByteArrayStatistics>(aggregates.min_max);
+  ASSERT_EQ(std::string(kMaxStatisticsSize, 'x') + "1000",
+            ByteArrayToString(min_max->min()));
+  ASSERT_EQ(std::string(kMaxStatisticsSize, 'x') +
+                std::to_string(1000 + kNumRowGroups * kRowsPerRowGroup - 1),
+            ByteArrayToString(min_max->max()));
+  ASSERT_EQ(0, aggregates.num_row_groups_from_metadata);
+  ASSERT_EQ(kNumRowGroups, aggregates.num_row_groups_scanned);
+
+  // Its counts are exact, and so are the bounds of the other column
+  aggregates = file_reader->ComputeAggregates(0, false);
+  ASSERT_EQ(kNumRowGroups * kRowsPerRowGroup, aggregates.num_values);
+  ASSERT_EQ(kNumRowGroups, aggregates.num_row_groups_from_metadata);
+
+  aggregates = file_reader->ComputeAggregates(1);
+  min_max = std::static_pointer_cast<ByteArrayStatistics>(aggregates.min_max);
+  ASSERT_EQ("1000", ByteArrayToString(min_max->min()));
+  ASSERT_EQ(std::to_string(1000 + kNumRowGroups * kRowsPerRowGroup - 1),
+            ByteArrayToString(min_max->max()));
+  ASSERT_EQ(kNumRowGroups, aggregates.num_row_groups_from_metadata);
+}
+
 }  // namespace test
 }  // namespace parquet
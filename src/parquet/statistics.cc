@@ -17,7 +17,19 @@
 
 #include <algorithm>
 #include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
 #include <type_traits>
+#include <utility>
+
+#if defined(PARQUET_USE_SSE) && defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+#include "arrow/util/bit-util.h"
 
 #include "parquet/encoding-internal.h"
 #include "parquet/exception.h"
@@ -29,6 +41,34 @@ using arrow::default_memory_pool;
 
 namespace parquet {
 
+bool EncodedStatistics::TruncateMinMax(size_t length, bool signed_bytes) {
+  bool truncated = false;
+  if (has_min && min_->length() > length) {
+    min_ = std::make_shared<std::string>(*min_, 0, length);
+    truncated = true;
+  }
+  if (!has_max || max_->length() <= length) {
+    return truncated;
+  }
+  // Round the prefix up: increment its last byte that is not the greatest one,
+  // and drop the bytes after it
+  const uint8_t greatest_byte = signed_bytes ? 0x7F : 0xFF;
+  std::string max(*max_, 0, length);
+  while (!max.empty() && static_cast<uint8_t>(max.back()) == greatest_byte) {
+    max.pop_back();
+  }
+  if (max.empty()) {
+    has_min = false;
+    has_max = false;
+    min_ = std::make_shared<std::string>();
+    max_ = std::make_shared<std::string>();
+    return false;
+  }
+  max.back() = static_cast<char>(static_cast<uint8_t>(max.back()) + 1);
+  max_ = std::make_shared<std::string>(std::move(max));
+  return true;
+}
+
 template <typename DType>
 TypedRowGroupStatistics<DType>::TypedRowGroupStatistics(const ColumnDescriptor* schema,
                                                         MemoryPool* pool)
@@ -89,6 +129,7 @@ template <typename DType>
 void TypedRowGroupStatistics<DType>::SetComparator() {
   comparator_ =
       std::static_pointer_cast<CompareDefault<DType> >(Comparator::Make(descr_));
+  unsigned_order_ = SortOrder::UNSIGNED == descr_->sort_order();
 }
 
 template <typename DType>
@@ -104,8 +145,13 @@ inline void TypedRowGroupStatistics<DType>::SetMinMax(const T& min, const T& max
     Copy(min, &min_, min_buffer_.get());
     Copy(max, &max_, max_buffer_.get());
   } else {
-    Copy(std::min(min_, min, std::ref(*(this->comparator_))), &min_, min_buffer_.get());
-    Copy(std::max(max_, max, std::ref(*(this->comparator_))), &max_, max_buffer_.get());
+    // The byte array types copy their bounds, so only do it when they change
+    if ((*comparator_)(min, min_)) {
+      Copy(min, &min_, min_buffer_.get());
+    }
+    if ((*comparator_)(max_, max)) {
+      Copy(max, &max_, max_buffer_.get());
+    }
   }
 }
 
@@ -158,6 +204,311 @@ void SetNaN<double>(double* value) {
   *value = std::nan("");
 }
 
+// ----------------------------------------------------------------------
+// Min/max kernels
+
+// The order of the numeric types, known at compile time so that the
+// comparisons are inlined rather than calls to the comparator
+template <typename T, bool kUnsigned, typename Enable = void>
+struct NumericLess {
+  bool operator()(const T& a, const T& b) const { return a < b; }
+};
+
+template <typename T>
+struct NumericLess<T, true,
+                   typename std::enable_if<std::is_integral<T>::value &&
+                                           !std::is_same<T, bool>::value>::type> {
+  bool operator()(const T& a, const T& b) const {
+    typedef typename std::make_unsigned<T>::type U;
+    return static_cast<U>(a) < static_cast<U>(b);
+  }
+};
+
+// NaNs compare false, so they are skipped as long as *min and *max are not NaN
+template <typename T, typename Less>
+inline void ScalarMinMax(const T* values, int64_t length, Less less, T* min, T* max) {
+  for (int64_t i = 0; i < length; i++) {
+    if (less(values[i], *min)) {
+      *min = values[i];
+    }
+    if (less(*max, values[i])) {
+      *max = values[i];
+    }
+  }
+}
+
+// Folds the longest prefix of values that fills whole vectors, and returns its
+// length. Only the numeric types have vector kernels
+template <typename T, bool kUnsigned>
+struct VectorMinMax {
+  static int64_t Accumulate(const T*, int64_t, T*, T*) { return 0; }
+};
+
+#if defined(PARQUET_USE_SSE) && (defined(__AVX2__) || defined(__SSE4_2__))
+
+#if defined(__AVX2__)
+typedef __m256i IntVector;
+typedef __m256 FloatVector;
+typedef __m256d DoubleVector;
+#define PARQUET_SIMD(name) _mm256_##name
+static inline IntVector LoadInts(const void* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+static inline void StoreInts(void* p, IntVector v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+static inline IntVector XorInts(IntVector a, IntVector b) {
+  return _mm256_xor_si256(a, b);
+}
+#else
+typedef __m128i IntVector;
+typedef __m128 FloatVector;
+typedef __m128d DoubleVector;
+#define PARQUET_SIMD(name) _mm_##name
+static inline IntVector LoadInts(const void* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+static inline void StoreInts(void* p, IntVector v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+static inline IntVector XorInts(IntVector a, IntVector b) { return _mm_xor_si128(a, b); }
+#endif
+
+// Vector operations of one type and order. Min and Max return acc when v is
+// NaN, as the min/max instructions return their second operand then
+template <typename T, bool kUnsigned>
+struct VectorOps;
+
+template <>
+struct VectorOps<int32_t, false> {
+  typedef IntVector Vector;
+  static Vector Set1(int32_t v) { return PARQUET_SIMD(set1_epi32)(v); }
+  static Vector Load(const int32_t* p) { return LoadInts(p); }
+  static void Store(int32_t* p, Vector v) { StoreInts(p, v); }
+  static Vector Min(Vector acc, Vector v) { return PARQUET_SIMD(min_epi32)(acc, v); }
+  static Vector Max(Vector acc, Vector v) { return PARQUET_SIMD(max_epi32)(acc, v); }
+};
+
+template <>
+struct VectorOps<int32_t, true> : public VectorOps<int32_t, false> {
+  static Vector Min(Vector acc, Vector v) { return PARQUET_SIMD(min_epu32)(acc, v); }
+  static Vector Max(Vector acc, Vector v) { return PARQUET_SIMD(max_epu32)(acc, v); }
+};
+
+// There are no 64-bit min/max instructions before AVX-512; select with a
+// comparison instead. The unsigned order is the signed order of the values
+// with their sign bit flipped
+template <bool kUnsigned>
+struct Int64VectorOps {
+  typedef IntVector Vector;
+  static Vector Set1(int64_t v) { return PARQUET_SIMD(set1_epi64x)(v); }
+  static Vector Load(const int64_t* p) { return LoadInts(p); }
+  static void Store(int64_t* p, Vector v) { StoreInts(p, v); }
+  static Vector Greater(Vector a, Vector b) {
+    if (kUnsigned) {
+      const Vector sign = Set1(std::numeric_limits<int64_t>::min());
+      a = XorInts(a, sign);
+      b = XorInts(b, sign);
+    }
+    return PARQUET_SIMD(cmpgt_epi64)(a, b);
+  }
+  static Vector Min(Vector acc, Vector v) {
+    return PARQUET_SIMD(blendv_epi8)(acc, v, Greater(acc, v));
+  }
+  static Vector Max(Vector acc, Vector v) {
+    return PARQUET_SIMD(blendv_epi8)(acc, v, Greater(v, acc));
+  }
+};
+
+template <>
+struct VectorOps<int64_t, false> : public Int64VectorOps<false> {};
+
+template <>
+struct VectorOps<int64_t, true> : public Int64VectorOps<true> {};
+
+template <>
+struct VectorOps<float, false> {
+  typedef FloatVector Vector;
+  static Vector Set1(float v) { return PARQUET_SIMD(set1_ps)(v); }
+  static Vector Load(const float* p) { return PARQUET_SIMD(loadu_ps)(p); }
+  static void Store(float* p, Vector v) { PARQUET_SIMD(storeu_ps)(p, v); }
+  static Vector Min(Vector acc, Vector v) { return PARQUET_SIMD(min_ps)(v, acc); }
+  static Vector Max(Vector acc, Vector v) { return PARQUET_SIMD(max_ps)(v, acc); }
+};
+
+template <>
+struct VectorOps<double, false> {
+  typedef DoubleVector Vector;
+  static Vector Set1(double v) { return PARQUET_SIMD(set1_pd)(v); }
+  static Vector Load(const double* p) { return PARQUET_SIMD(loadu_pd)(p); }
+  static void Store(double* p, Vector v) { PARQUET_SIMD(storeu_pd)(p, v); }
+  static Vector Min(Vector acc, Vector v) { return PARQUET_SIMD(min_pd)(v, acc); }
+  static Vector Max(Vector acc, Vector v) { return PARQUET_SIMD(max_pd)(v, acc); }
+};
+
+template <typename T, bool kUnsigned>
+struct SimdMinMax {
+  typedef VectorOps<T, kUnsigned> Ops;
+  static constexpr int64_t kLanes = sizeof(typename Ops::Vector) / sizeof(T);
+
+  static int64_t Accumulate(const T* values, int64_t length, T* min, T* max) {
+    const int64_t vector_length = length - length % kLanes;
+    if (vector_length == 0) return 0;
+    typename Ops::Vector min_vector = Ops::Set1(*min);
+    typename Ops::Vector max_vector = Ops::Set1(*max);
+    for (int64_t i = 0; i < vector_length; i += kLanes) {
+      typename Ops::Vector v = Ops::Load(values + i);
+      min_vector = Ops::Min(min_vector, v);
+      max_vector = Ops::Max(max_vector, v);
+    }
+    // The lanes only hold values, or the initial *min and *max
+    T lanes[kLanes];
+    Ops::Store(lanes, min_vector);
+    ScalarMinMax(lanes, kLanes, NumericLess<T, kUnsigned>(), min, max);
+    Ops::Store(lanes, max_vector);
+    ScalarMinMax(lanes, kLanes, NumericLess<T, kUnsigned>(), min, max);
+    return vector_length;
+  }
+};
+
+#undef PARQUET_SIMD
+
+template <>
+struct VectorMinMax<int32_t, false> : public SimdMinMax<int32_t, false> {};
+template <>
+struct VectorMinMax<int32_t, true> : public SimdMinMax<int32_t, true> {};
+template <>
+struct VectorMinMax<int64_t, false> : public SimdMinMax<int64_t, false> {};
+template <>
+struct VectorMinMax<int64_t, true> : public SimdMinMax<int64_t, true> {};
+template <>
+struct VectorMinMax<float, false> : public SimdMinMax<float, false> {};
+template <>
+struct VectorMinMax<double, false> : public SimdMinMax<double, false> {};
+
+#endif  // PARQUET_USE_SSE
+
+template <typename T, bool kUnsigned>
+inline void NumericMinMax(const T* values, int64_t length, T* min, T* max) {
+  int64_t i = VectorMinMax<T, kUnsigned>::Accumulate(values, length, min, max);
+  ScalarMinMax(values + i, length - i, NumericLess<T, kUnsigned>(), min, max);
+}
+
+// The types with no numeric order go through their comparator
+template <typename DType, typename Enable = void>
+struct MinMaxDispatch {
+  typedef typename DType::c_type T;
+  static void Accumulate(const T* values, int64_t length,
+                         CompareDefault<DType>* comparator, bool, T* min, T* max) {
+    ScalarMinMax(values, length, std::ref(*comparator), min, max);
+  }
+};
+
+// The byte array types use the non-virtual functions of their comparators,
+// and only keep pointers to the candidate bounds in the values
+template <bool kUnsigned>
+struct ByteArrayLess {
+  bool operator()(const ByteArray& a, const ByteArray& b) const {
+    return kUnsigned ? UnsignedBytesLess(a.ptr, a.len, b.ptr, b.len)
+                     : SignedBytesLess(a.ptr, a.len, b.ptr, b.len);
+  }
+};
+
+template <bool kUnsigned>
+struct FLBALess {
+  explicit FLBALess(uint32_t type_length) : type_length(type_length) {}
+  bool operator()(const FLBA& a, const FLBA& b) const {
+    return kUnsigned ? UnsignedBytesLess(a.ptr, type_length, b.ptr, type_length)
+                     : SignedBytesLess(a.ptr, type_length, b.ptr, type_length);
+  }
+  uint32_t type_length;
+};
+
+template <>
+struct MinMaxDispatch<ByteArrayType> {
+  static void Accumulate(const ByteArray* values, int64_t length,
+                         CompareDefault<ByteArrayType>*, bool unsigned_order,
+                         ByteArray* min, ByteArray* max) {
+    if (unsigned_order) {
+      ScalarMinMax(values, length, ByteArrayLess<true>(), min, max);
+    } else {
+      ScalarMinMax(values, length, ByteArrayLess<false>(), min, max);
+    }
+  }
+};
+
+template <>
+struct MinMaxDispatch<FLBAType> {
+  static void Accumulate(const FLBA* values, int64_t length,
+                         CompareDefault<FLBAType>* comparator, bool unsigned_order,
+                         FLBA* min, FLBA* max) {
+    const uint32_t type_length = comparator->type_length_;
+    if (unsigned_order) {
+      ScalarMinMax(values, length, FLBALess<true>(type_length), min, max);
+    } else {
+      ScalarMinMax(values, length, FLBALess<false>(type_length), min, max);
+    }
+  }
+};
+
+template <typename DType>
+using IsNumeric = std::is_arithmetic<typename DType::c_type>;
+
+template <typename DType>
+struct MinMaxDispatch<DType, typename std::enable_if<IsNumeric<DType>::value>::type> {
+  typedef typename DType::c_type T;
+  static void Accumulate(const T* values, int64_t length, CompareDefault<DType>*,
+                         bool unsigned_order, T* min, T* max) {
+    if (unsigned_order) {
+      NumericMinMax<T, true>(values, length, min, max);
+    } else {
+      NumericMinMax<T, false>(values, length, min, max);
+    }
+  }
+};
+
+// Call visit(position, length) on each run of set bits of the bitmap. Whole
+// bytes of set or unset bits are handled at once
+template <typename Visitor>
+static void VisitSetBitRuns(const uint8_t* bitmap, int64_t offset, int64_t length,
+                            Visitor&& visit) {
+  int64_t run_start = -1;
+  int64_t i = 0;
+  while (i < length) {
+    const int64_t bit = offset + i;
+    if ((bit & 7) == 0 && i + 8 <= length) {
+      const uint8_t byte = bitmap[bit >> 3];
+      if (byte == 0xFF || byte == 0) {
+        if (byte == 0xFF && run_start < 0) {
+          run_start = i;
+        } else if (byte == 0 && run_start >= 0) {
+          visit(run_start, i - run_start);
+          run_start = -1;
+        }
+        i += 8;
+        continue;
+      }
+    }
+    if (::arrow::BitUtil::GetBit(bitmap, bit)) {
+      if (run_start < 0) run_start = i;
+    } else if (run_start >= 0) {
+      visit(run_start, i - run_start);
+      run_start = -1;
+    }
+    i++;
+  }
+  if (run_start >= 0) {
+    visit(run_start, length - run_start);
+  }
+}
+
+template <typename DType>
+void TypedRowGroupStatistics<DType>::AccumulateMinMax(const T* values, int64_t length,
+                                                      T* min, T* max) {
+  MinMaxDispatch<DType>::Accumulate(values, length, comparator_.get(), unsigned_order_,
+                                    min, max);
+}
+
 template <typename DType>
 void TypedRowGroupStatistics<DType>::Update(const T* values, int64_t num_not_null,
                                             int64_t num_null) {
@@ -166,7 +517,6 @@ void TypedRowGroupStatistics<DType>::Update(const T* values, int64_t num_not_nul
 
   IncrementNullCount(num_null);
   IncrementNumValues(num_not_null);
-  // TODO: support distinct count?
   if (num_not_null == 0) return;
 
   // PARQUET-1225: Handle NaNs
@@ -188,10 +538,11 @@ void TypedRowGroupStatistics<DType>::Update(const T* values, int64_t num_not_nul
     return;
   }
 
-  auto batch_minmax = std::minmax_element(values + begin_offset, values + end_offset,
-                                          std::ref(*(this->comparator_)));
+  T min = values[begin_offset];
+  T max = values[begin_offset];
+  AccumulateMinMax(values + begin_offset + 1, end_offset - begin_offset - 1, &min, &max);
 
-  SetMinMax(*batch_minmax.first, *batch_minmax.second);
+  SetMinMax(min, max);
 }
 
 template <typename DType>
@@ -205,7 +556,6 @@ void TypedRowGroupStatistics<DType>::UpdateSpaced(const T* values,
 
   IncrementNullCount(num_null);
   IncrementNumValues(num_not_null);
-  // TODO: support distinct count?
   if (num_not_null == 0) return;
 
   // Find first valid entry and use that for min/max
@@ -236,16 +586,11 @@ void TypedRowGroupStatistics<DType>::UpdateSpaced(const T* values,
 
   T min = values[i];
   T max = values[i];
-  for (; i < length; i++) {
-    if (valid_bits_reader.IsSet()) {
-      if ((std::ref(*(this->comparator_)))(values[i], min)) {
-        min = values[i];
-      } else if ((std::ref(*(this->comparator_)))(max, values[i])) {
-        max = values[i];
-      }
-    }
-    valid_bits_reader.Next();
-  }
+  const T* run_values = values + i;
+  VisitSetBitRuns(valid_bits, valid_bits_offset + i, length - i,
+                  [this, run_values, &min, &max](int64_t position, int64_t run_length) {
+                    AccumulateMinMax(run_values + position, run_length, &min, &max);
+                  });
 
   SetMinMax(min, max);
 }
@@ -79,6 +79,13 @@ class PARQUET_EXPORT EncodedStatistics {
     has_distinct_count = true;
     return *this;
   }
+
+  // Truncate the plain-encoded min and max of a BYTE_ARRAY column to at most
+  // length bytes, keeping them bounds of the values: the min becomes its prefix
+  // and the max the smallest greater prefix in the order of the bytes. If the
+  // max has no such prefix, both are dropped. Returns whether a truncated min
+  // or max is left
+  bool TruncateMinMax(size_t length, bool signed_bytes);
 };
 
 template <typename DType>
@@ -179,6 +186,12 @@ class TypedRowGroupStatistics : public RowGroupStatistics {
   ::arrow::MemoryPool* pool_;
   std::shared_ptr<CompareDefault<DType> > comparator_;
 
+  // Whether values are compared under the UNSIGNED sort order
+  bool unsigned_order_ = false;
+
+  // Fold values into *min and *max, which start as one of the values
+  void AccumulateMinMax(const T* values, int64_t length, T* min, T* max);
+
   void PlainEncode(const T& src, std::string* dst);
   void PlainDecode(const std::string& src, T* dst);
   void Copy(const T& src, T* dst, PoolBuffer* buffer);
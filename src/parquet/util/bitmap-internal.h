@@ -0,0 +1,183 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_BITMAP_INTERNAL_H
+#define PARQUET_UTIL_BITMAP_INTERNAL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "arrow/util/bit-util.h"
+
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace parquet {
+namespace internal {
+
+inline int PopCount8(uint8_t bits) {
+#if defined(__GNUC__)
+  return __builtin_popcount(bits);
+#else
+  int count = 0;
+  for (; bits != 0; bits &= static_cast<uint8_t>(bits - 1)) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+// The 8 bits of bitmap starting at bit offset, which need not be byte aligned
+inline uint8_t LoadBits8(const uint8_t* bitmap, int64_t offset) {
+  const uint8_t* byte = bitmap + offset / 8;
+  const int shift = static_cast<int>(offset % 8);
+  if (shift == 0) {
+    return *byte;
+  }
+  return static_cast<uint8_t>((byte[0] >> shift) | (byte[1] << (8 - shift)));
+}
+
+// ----------------------------------------------------------------------
+// Expansion of dense values into the slots of a validity bitmap
+//
+// The spaced read paths have the non-null values of a batch densely, in the
+// page or decoded from the dictionary, and need them in the slots whose
+// validity bit is set. The slots are filled eight at a time: bytes of the
+// bitmap that are all valid or all null are copied or cleared in bulk, and
+// the mixed ones are expanded with byte shuffles from a table for 4 and 8-byte
+// values when SSE is enabled. Larger values take most of a register each and
+// are moved one by one.
+
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+
+// Shuffle masks moving the first values of a register into the valid slots of
+// a group of 16 bytes of slots, indexed by the validity bits of the group.
+// 0x80 bytes clear the null slots
+struct ExpandShuffleMasks {
+  ExpandShuffleMasks() {
+    FillMasks(4, masks4[0]);
+    FillMasks(8, masks8[0]);
+  }
+
+  // Four slots of 4 bytes
+  uint8_t masks4[16][16];
+  // Two slots of 8 bytes
+  uint8_t masks8[4][16];
+
+ private:
+  static void FillMasks(int value_size, uint8_t* masks) {
+    const int num_slots = 16 / value_size;
+    for (int bits = 0; bits < (1 << num_slots); ++bits) {
+      uint8_t* mask = masks + bits * 16;
+      int source = 0;
+      for (int slot = 0; slot < num_slots; ++slot) {
+        const bool valid = ((bits >> slot) & 1) != 0;
+        for (int i = 0; i < value_size; ++i) {
+          mask[slot * value_size + i] =
+              valid ? static_cast<uint8_t>(source * value_size + i) : 0x80;
+        }
+        source += valid;
+      }
+    }
+  }
+};
+
+inline const ExpandShuffleMasks& GetExpandShuffleMasks() {
+  static const ExpandShuffleMasks masks;
+  return masks;
+}
+
+// Expand the first values of dense into the 16 bytes of slots at out
+inline void ShuffleExpand16(const uint8_t* dense, const uint8_t* mask, uint8_t* out) {
+  const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dense));
+  const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(values, shuffle));
+}
+
+#endif
+
+// Expand the first PopCount8(bits) values of dense into the 8 slots at out.
+// Reads 8 whole values from dense if can_overread. Returns the number of
+// values consumed
+template <typename T>
+inline int ExpandBits8(const uint8_t* dense, uint8_t bits, bool can_overread, T* out) {
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+  if (can_overread && (sizeof(T) == 4 || sizeof(T) == 8)) {
+    const ExpandShuffleMasks& masks = GetExpandShuffleMasks();
+    uint8_t* out_bytes = reinterpret_cast<uint8_t*>(out);
+    const int slots_per_register = static_cast<int>(16 / sizeof(T));
+    const int register_mask = (1 << slots_per_register) - 1;
+    for (int slot = 0; slot < 8; slot += slots_per_register) {
+      const int register_bits = (bits >> slot) & register_mask;
+      const uint8_t* mask =
+          sizeof(T) == 4 ? masks.masks4[register_bits] : masks.masks8[register_bits];
+      ShuffleExpand16(dense, mask, out_bytes + slot * sizeof(T));
+      dense += PopCount8(static_cast<uint8_t>(register_bits)) * sizeof(T);
+    }
+    return PopCount8(bits);
+  }
+#endif
+  int num_consumed = 0;
+  for (int i = 0; i < 8; ++i) {
+    if ((bits >> i) & 1) {
+      memcpy(out + i, dense + num_consumed * sizeof(T), sizeof(T));
+      ++num_consumed;
+    } else {
+      out[i] = T();
+    }
+  }
+  return num_consumed;
+}
+
+// Copy the num_values - null_count values of dense, which may be unaligned,
+// to the slots of out whose bit of valid_bits is set, starting at bit
+// valid_bits_offset, and set the other slots to T(). T must be trivially
+// copyable
+template <typename T>
+inline void ExpandSpaced(const uint8_t* dense, int num_values, int null_count,
+                         const uint8_t* valid_bits, int64_t valid_bits_offset, T* out) {
+  const int num_dense = num_values - null_count;
+  int num_consumed = 0;
+  int i = 0;
+  for (; i + 8 <= num_values; i += 8) {
+    const uint8_t bits = LoadBits8(valid_bits, valid_bits_offset + i);
+    if (bits == 0xFF) {
+      memcpy(out + i, dense + num_consumed * sizeof(T), 8 * sizeof(T));
+      num_consumed += 8;
+    } else if (bits == 0) {
+      std::fill(out + i, out + i + 8, T());
+    } else {
+      num_consumed += ExpandBits8(dense + num_consumed * sizeof(T), bits,
+                                  num_consumed + 8 <= num_dense, out + i);
+    }
+  }
+  for (; i < num_values; ++i) {
+    if (::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+      memcpy(out + i, dense + num_consumed * sizeof(T), sizeof(T));
+      ++num_consumed;
+    } else {
+      out[i] = T();
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_BITMAP_INTERNAL_H
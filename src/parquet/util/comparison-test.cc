@@ -17,8 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
+#include <random>
+#include <string>
 #include <vector>
 
 #include "parquet/schema.h"
@@ -233,6 +236,39 @@ TEST(Comparison, UnsignedInt32) {
   ASSERT_TRUE(less(aaa, bbb));
 }
 
+TEST(Comparison, BytesLess) {
+  // Strings with long common prefixes and bytes of both signs
+  std::mt19937 gen(42);
+  std::vector<std::string> strings = {""};
+  const std::string prefix = "a common prefix longer than a word";
+  for (int i = 0; i < 200; i++) {
+    std::string s = prefix.substr(0, gen() % prefix.size());
+    const int length = static_cast<int>(gen() % 20);
+    for (int j = 0; j < length; j++) {
+      const auto byte = gen() % 4 == 0 ? 0x80 + gen() % 128 : 'a' + gen() % 4;
+      s.push_back(static_cast<char>(byte));
+    }
+    strings.push_back(s);
+  }
+
+  for (const std::string& a : strings) {
+    for (const std::string& b : strings) {
+      auto a_ptr = reinterpret_cast<const uint8_t*>(a.data());
+      auto b_ptr = reinterpret_cast<const uint8_t*>(b.data());
+      const auto a_length = static_cast<uint32_t>(a.size());
+      const auto b_length = static_cast<uint32_t>(b.size());
+      auto a_signed = reinterpret_cast<const int8_t*>(a_ptr);
+      auto b_signed = reinterpret_cast<const int8_t*>(b_ptr);
+      ASSERT_EQ(std::lexicographical_compare(a_ptr, a_ptr + a_length, b_ptr,
+                                             b_ptr + b_length),
+                UnsignedBytesLess(a_ptr, a_length, b_ptr, b_length));
+      ASSERT_EQ(std::lexicographical_compare(a_signed, a_signed + a_length, b_signed,
+                                             b_signed + b_length),
+                SignedBytesLess(a_ptr, a_length, b_ptr, b_length));
+    }
+  }
+}
+
 TEST(Comparison, UnknownSortOrder) {
   NodePtr node =
       PrimitiveNode::Make("Unknown", Repetition::REQUIRED, Type::FIXED_LEN_BYTE_ARRAY,
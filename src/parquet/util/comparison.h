@@ -19,6 +19,8 @@
 #define PARQUET_UTIL_COMPARISON_H
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 #include "parquet/exception.h"
 #include "parquet/schema.h"
@@ -26,6 +28,35 @@
 
 namespace parquet {
 
+// Lexicographical order of byte strings whose bytes compare as uint8_t
+inline bool UnsignedBytesLess(const uint8_t* a, uint32_t a_length, const uint8_t* b,
+                              uint32_t b_length) {
+  const uint32_t length = std::min(a_length, b_length);
+  const int cmp = length == 0 ? 0 : std::memcmp(a, b, length);
+  return cmp < 0 || (cmp == 0 && a_length < b_length);
+}
+
+// Lexicographical order of byte strings whose bytes compare as int8_t, which
+// is the SIGNED order of the byte array types
+inline bool SignedBytesLess(const uint8_t* a, uint32_t a_length, const uint8_t* b,
+                            uint32_t b_length) {
+  const uint32_t length = std::min(a_length, b_length);
+  uint32_t i = 0;
+  // Skip the common prefix a word at a time, the first mismatch decides
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t a_word, b_word;
+    std::memcpy(&a_word, a + i, sizeof(uint64_t));
+    std::memcpy(&b_word, b + i, sizeof(uint64_t));
+    if (a_word != b_word) break;
+  }
+  for (; i < length; ++i) {
+    if (a[i] != b[i]) {
+      return static_cast<int8_t>(a[i]) < static_cast<int8_t>(b[i]);
+    }
+  }
+  return a_length < b_length;
+}
+
 class PARQUET_EXPORT Comparator {
  public:
   virtual ~Comparator() {}
@@ -64,9 +95,7 @@ class PARQUET_EXPORT CompareDefault<ByteArrayType> : public Comparator {
  public:
   CompareDefault() {}
   virtual bool operator()(const ByteArray& a, const ByteArray& b) {
-    const int8_t* aptr = reinterpret_cast<const int8_t*>(a.ptr);
-    const int8_t* bptr = reinterpret_cast<const int8_t*>(b.ptr);
-    return std::lexicographical_compare(aptr, aptr + a.len, bptr, bptr + b.len);
+    return SignedBytesLess(a.ptr, a.len, b.ptr, b.len);
   }
 };
 
@@ -75,10 +104,7 @@ class PARQUET_EXPORT CompareDefault<FLBAType> : public Comparator {
  public:
   explicit CompareDefault(int length) : type_length_(length) {}
   virtual bool operator()(const FLBA& a, const FLBA& b) {
-    const int8_t* aptr = reinterpret_cast<const int8_t*>(a.ptr);
-    const int8_t* bptr = reinterpret_cast<const int8_t*>(b.ptr);
-    return std::lexicographical_compare(aptr, aptr + type_length_, bptr,
-                                        bptr + type_length_);
+    return SignedBytesLess(a.ptr, type_length_, b.ptr, type_length_);
   }
   int32_t type_length_;
 };
@@ -144,9 +170,7 @@ class PARQUET_EXPORT CompareUnsignedInt96 : public CompareDefaultInt96 {
 class PARQUET_EXPORT CompareUnsignedByteArray : public CompareDefaultByteArray {
  public:
   bool operator()(const ByteArray& a, const ByteArray& b) override {
-    const uint8_t* aptr = reinterpret_cast<const uint8_t*>(a.ptr);
-    const uint8_t* bptr = reinterpret_cast<const uint8_t*>(b.ptr);
-    return std::lexicographical_compare(aptr, aptr + a.len, bptr, bptr + b.len);
+    return UnsignedBytesLess(a.ptr, a.len, b.ptr, b.len);
   }
 };
 
@@ -154,10 +178,7 @@ class PARQUET_EXPORT CompareUnsignedFLBA : public CompareDefaultFLBA {
  public:
   explicit CompareUnsignedFLBA(int length) : CompareDefaultFLBA(length) {}
   bool operator()(const FLBA& a, const FLBA& b) override {
-    const uint8_t* aptr = reinterpret_cast<const uint8_t*>(a.ptr);
-    const uint8_t* bptr = reinterpret_cast<const uint8_t*>(b.ptr);
-    return std::lexicographical_compare(aptr, aptr + type_length_, bptr,
-                                        bptr + type_length_);
+    return UnsignedBytesLess(a.ptr, type_length_, b.ptr, type_length_);
   }
 };
 
@@ -0,0 +1,210 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_DICT_GATHER_INTERNAL_H
+#define PARQUET_UTIL_DICT_GATHER_INTERNAL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// The AVX2 kernels are compiled with a target attribute rather than the build
+// flags and chosen at runtime, so they do not depend on PARQUET_USE_SSE and any
+// x86-64 build can use them on CPUs that have AVX2
+#if defined(__x86_64__) && defined(__GNUC__)
+#define PARQUET_DICT_GATHER_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace parquet {
+namespace internal {
+
+// ----------------------------------------------------------------------
+// Fused unpacking and lookup of dictionary indices
+//
+// A bit-packed group of 8 indices of bit_width bits is bit_width bytes long.
+// The AVX2 kernel gathers the 32-bit word holding each index of a group,
+// shifts and masks the 8 indices out at once and gathers their values from
+// the dictionary, so the indices never go through memory. Repeated runs are
+// written with broadcast stores. RleRunDecoder falls back to unpacking into a
+// buffer and looking the values up one by one when the kernel cannot be used.
+
+// Widest index for which the word loaded at the byte of its first bit holds
+// all of its bits, as the index starts at most 7 bits into the word
+static constexpr int kMaxGatherBitWidth = 25;
+
+// Bytes the kernel may read past the end of the last group
+static constexpr int kGatherPadding = 4;
+
+// Whether the CPU running us supports AVX2. Checked once
+inline bool CpuSupportsAvx2() {
+#if defined(PARQUET_DICT_GATHER_AVX2)
+  static const bool supported = __builtin_cpu_supports("avx2") != 0;
+  return supported;
+#else
+  return false;
+#endif
+}
+
+// The integer type the AVX2 kernels move values of kSize bytes as, void if
+// they do not handle that size
+template <int kSize>
+struct GatherWord {
+  typedef void type;
+};
+
+template <>
+struct GatherWord<4> {
+  typedef int32_t type;
+};
+
+template <>
+struct GatherWord<8> {
+  typedef int64_t type;
+};
+
+// Whether the AVX2 kernels can be used for values of type T
+template <typename T>
+inline bool CanGatherDict() {
+  return !std::is_void<typename GatherWord<sizeof(T)>::type>::value &&
+         CpuSupportsAvx2();
+}
+
+#if defined(PARQUET_DICT_GATHER_AVX2)
+
+__attribute__((target("avx2"))) inline void GatherDictGroupsAvx2(
+    const uint8_t* packed, int bit_width, int num_groups, const int32_t* dictionary,
+    int32_t* out) {
+  const __m256i bit_offsets = _mm256_mullo_epi32(
+      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(bit_width));
+  const __m256i byte_offsets = _mm256_srli_epi32(bit_offsets, 3);
+  const __m256i shifts = _mm256_and_si256(bit_offsets, _mm256_set1_epi32(7));
+  const __m256i mask = _mm256_set1_epi32((1 << bit_width) - 1);
+  for (int i = 0; i < num_groups; ++i) {
+    const __m256i words = _mm256_i32gather_epi32(
+        reinterpret_cast<const int*>(packed), byte_offsets, 1);
+    const __m256i indices = _mm256_and_si256(_mm256_srlv_epi32(words, shifts), mask);
+    const __m256i values =
+        _mm256_i32gather_epi32(reinterpret_cast<const int*>(dictionary), indices, 4);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), values);
+    packed += bit_width;
+    out += 8;
+  }
+}
+
+__attribute__((target("avx2"))) inline void GatherDictGroupsAvx2(
+    const uint8_t* packed, int bit_width, int num_groups, const int64_t* dictionary,
+    int64_t* out) {
+  const __m256i bit_offsets = _mm256_mullo_epi32(
+      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(bit_width));
+  const __m256i byte_offsets = _mm256_srli_epi32(bit_offsets, 3);
+  const __m256i shifts = _mm256_and_si256(bit_offsets, _mm256_set1_epi32(7));
+  const __m256i mask = _mm256_set1_epi32((1 << bit_width) - 1);
+  const long long* base = reinterpret_cast<const long long*>(dictionary);  // NOLINT
+  for (int i = 0; i < num_groups; ++i) {
+    const __m256i words = _mm256_i32gather_epi32(
+        reinterpret_cast<const int*>(packed), byte_offsets, 1);
+    const __m256i indices = _mm256_and_si256(_mm256_srlv_epi32(words, shifts), mask);
+    const __m256i low =
+        _mm256_i32gather_epi64(base, _mm256_castsi256_si128(indices), 8);
+    const __m256i high =
+        _mm256_i32gather_epi64(base, _mm256_extracti128_si256(indices, 1), 8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4), high);
+    packed += bit_width;
+    out += 8;
+  }
+}
+
+__attribute__((target("avx2"))) inline void BroadcastAvx2(const __m256i value,
+                                                          int num_bytes,
+                                                          uint8_t* out) {
+  int i = 0;
+  for (; i + 32 <= num_bytes; i += 32) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), value);
+  }
+  // num_bytes is a multiple of the value size, which divides 32
+  uint8_t tail[32];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(tail), value);
+  memcpy(out + i, tail, num_bytes - i);
+}
+
+__attribute__((target("avx2"))) inline void FillAvx2(const int32_t* value,
+                                                     int num_values, int32_t* out) {
+  BroadcastAvx2(_mm256_set1_epi32(*value), num_values * 4,
+                reinterpret_cast<uint8_t*>(out));
+}
+
+__attribute__((target("avx2"))) inline void FillAvx2(const int64_t* value,
+                                                     int num_values, int64_t* out) {
+  BroadcastAvx2(_mm256_set1_epi64x(*value), num_values * 8,
+                reinterpret_cast<uint8_t*>(out));
+}
+
+#endif
+
+template <typename T, typename Word = typename GatherWord<sizeof(T)>::type>
+struct DictGather {
+  static void Gather(const uint8_t* packed, int bit_width, int num_groups,
+                     const T* dictionary, T* out) {
+#if defined(PARQUET_DICT_GATHER_AVX2)
+    GatherDictGroupsAvx2(packed, bit_width, num_groups,
+                         reinterpret_cast<const Word*>(dictionary),
+                         reinterpret_cast<Word*>(out));
+#endif
+  }
+
+  static void Fill(const T& value, int num_values, T* out) {
+#if defined(PARQUET_DICT_GATHER_AVX2)
+    Word word;
+    memcpy(&word, &value, sizeof(Word));
+    FillAvx2(&word, num_values, reinterpret_cast<Word*>(out));
+#endif
+  }
+};
+
+template <typename T>
+struct DictGather<T, void> {
+  static void Gather(const uint8_t*, int, int, const T*, T*) {}
+  static void Fill(const T&, int, T*) {}
+};
+
+// Unpack the num_groups groups of 8 indices of bit_width bits at packed and
+// write their values in dictionary to out. Only valid if CanGatherDict<T>(),
+// 0 < bit_width <= kMaxGatherBitWidth and kGatherPadding bytes past the last
+// group are readable. Like the scalar lookup, indices are not bounds checked
+template <typename T>
+inline void GatherDictGroups(const uint8_t* packed, int bit_width, int num_groups,
+                             const T* dictionary, T* out) {
+  DictGather<T>::Gather(packed, bit_width, num_groups, dictionary, out);
+}
+
+// Write num_values copies of value to out
+template <typename T>
+inline void FillValues(const T& value, int num_values, T* out) {
+  if (CanGatherDict<T>()) {
+    DictGather<T>::Fill(value, num_values, out);
+  } else {
+    std::fill(out, out + num_values, value);
+  }
+}
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_DICT_GATHER_INTERNAL_H
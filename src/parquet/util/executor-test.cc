@@ -0,0 +1,168 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/exception.h"
+#include "parquet/util/executor.h"
+
+using arrow::Status;
+
+namespace parquet {
+
+namespace test {
+
+TEST(TestWorkStealingExecutor, ParallelFor) {
+  WorkStealingExecutor executor(4);
+  ASSERT_EQ(4, executor.capacity());
+
+  std::vector<int> visits(1000, 0);
+  ASSERT_TRUE(executor
+                  .ParallelFor(3, static_cast<int>(visits.size()),
+                               [&visits](int i) {
+                                 ++visits[i];
+                                 return Status::OK();
+                               })
+                  .ok());
+  ASSERT_EQ(std::vector<int>(visits.size(), 1), visits);
+}
+
+TEST(TestWorkStealingExecutor, CostHints) {
+  WorkStealingExecutor executor(2);
+
+  // With one task at a time, the tasks run by decreasing cost
+  const std::vector<int64_t> costs = {5, 50, 1, 20, 20};
+  std::vector<int> order;
+  ASSERT_TRUE(executor
+                  .ParallelFor(1, 5,
+                               [&order](int i) {
+                                 order.push_back(i);
+                                 return Status::OK();
+                               },
+                               costs)
+                  .ok());
+  ASSERT_EQ(std::vector<int>({1, 3, 4, 0, 2}), order);
+}
+
+TEST(TestWorkStealingExecutor, Errors) {
+  WorkStealingExecutor executor(2);
+
+  Status status = executor.ParallelFor(2, 100, [](int i) {
+    if (i == 10) {
+      return Status::Invalid("task failed");
+    }
+    return Status::OK();
+  });
+  ASSERT_TRUE(status.IsInvalid());
+
+  status = executor.ParallelFor(2, 100, [](int i) -> Status {
+    if (i == 50) {
+      throw ParquetException("task threw");
+    }
+    return Status::OK();
+  });
+  ASSERT_TRUE(status.IsIOError());
+
+  ASSERT_THROW(WorkStealingExecutor(0), ParquetException);
+}
+
+TEST(TestWorkStealingExecutor, NestedParallelFor) {
+  // Every thread waits on tasks queued behind it, which only completes if the
+  // waiting threads run them
+  WorkStealingExecutor executor(2);
+  std::atomic<int> count(0);
+  ASSERT_TRUE(executor
+                  .ParallelFor(8, 8,
+                               [&executor, &count](int) {
+                                 return executor.ParallelFor(8, 8, [&count](int) {
+                                   ++count;
+                                   return Status::OK();
+                                 });
+                               })
+                  .ok());
+  ASSERT_EQ(64, count);
+}
+
+TEST(TestWorkStealingExecutor, ThrowingTask) {
+  std::atomic<bool> ran(false);
+  {
+    WorkStealingExecutor executor(1);
+    executor.Submit([]() { throw ParquetException("task threw"); });
+    executor.Submit([&ran]() { ran = true; });
+  }
+  ASSERT_TRUE(ran);
+}
+
+TEST(TestWorkStealingExecutor, HelpOnlyWithGroup) {
+  // The only thread waits on a task of group a, with a task of group b queued
+  // after it. It runs the former but not the latter
+  const int a = 0, b = 0;
+  std::atomic<bool> ran_b(false);
+  std::atomic<bool> ran_b_while_waiting(true);
+  {
+    WorkStealingExecutor executor(1);
+    executor.Submit([&]() {
+      std::atomic<bool> done_a(false);
+      executor.Submit([&done_a]() { done_a = true; }, 1, &a);
+      executor.Submit([&ran_b]() { ran_b = true; }, 1, &b);
+      while (!done_a) {
+        ASSERT_TRUE(executor.RunPendingTask(&a));
+      }
+      ASSERT_FALSE(executor.RunPendingTask(&a));
+      ran_b_while_waiting = ran_b.load();
+    });
+  }
+  ASSERT_FALSE(ran_b_while_waiting);
+  ASSERT_TRUE(ran_b);
+}
+
+TEST(TestWorkStealingExecutor, SharedByThreads) {
+  // Several callers share the executor, as concurrently open files would
+  WorkStealingExecutor executor(3);
+  std::atomic<int64_t> sum(0);
+  std::vector<std::thread> callers;
+  for (int caller = 0; caller < 8; ++caller) {
+    callers.emplace_back([&executor, &sum]() {
+      ASSERT_TRUE(executor
+                      .ParallelFor(4, 100,
+                                   [&sum](int i) {
+                                     sum += i;
+                                     return Status::OK();
+                                   })
+                      .ok());
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+  ASSERT_EQ(8 * 4950, sum);
+
+  ASSERT_FALSE(executor.RunPendingTask(nullptr));
+  ASSERT_NE(nullptr, default_executor());
+  ASSERT_EQ(default_executor(), default_executor());
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,289 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/executor.h"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+#include "parquet/exception.h"
+
+using arrow::Status;
+
+namespace parquet {
+
+// ----------------------------------------------------------------------
+// Executor
+
+Executor::~Executor() {}
+
+Status Executor::ParallelFor(int max_parallelism, int num_tasks,
+                             const std::function<Status(int)>& func,
+                             const std::vector<int64_t>& costs) {
+  if (num_tasks <= 0) {
+    return Status::OK();
+  }
+  if (!costs.empty() && static_cast<int>(costs.size()) != num_tasks) {
+    return Status::Invalid("Expected one cost per task");
+  }
+
+  // Start the costliest tasks first, so that the cheap ones fill in at the end
+  std::vector<int> order(num_tasks);
+  std::iota(order.begin(), order.end(), 0);
+  int64_t total_cost = num_tasks;
+  if (!costs.empty()) {
+    std::stable_sort(order.begin(), order.end(),
+                     [&costs](int a, int b) { return costs[a] > costs[b]; });
+    total_cost = std::accumulate(costs.begin(), costs.end(), static_cast<int64_t>(0));
+  }
+
+  struct State {
+    std::mutex mutex;
+    std::condition_variable runner_done;
+    int num_runners;
+    std::atomic<int> next_task;
+    std::atomic<bool> failed;
+    Status status;
+  };
+  auto state = std::make_shared<State>();
+  state->num_runners = std::max(1, std::min(max_parallelism, num_tasks));
+  state->next_task = 0;
+  state->failed = false;
+
+  // Each runner takes the next task until none are left, which bounds the
+  // parallelism of the loop whatever the capacity of the executor
+  auto Runner = [state, &order, &func, num_tasks]() {
+    while (!state->failed) {
+      const int i = state->next_task++;
+      if (i >= num_tasks) {
+        break;
+      }
+      Status status;
+      try {
+        status = func(order[i]);
+      } catch (const std::exception& e) {
+        status = Status::IOError(e.what());
+      }
+      if (!status.ok()) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->status.ok()) {
+          state->status = status;
+        }
+        state->failed = true;
+      }
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    --state->num_runners;
+    state->runner_done.notify_all();
+  };
+
+  const int num_runners = state->num_runners;
+  for (int i = 0; i < num_runners; ++i) {
+    Submit(Runner, std::max<int64_t>(1, total_cost / num_runners), state.get());
+  }
+
+  // order and func are used by the runners until they are all done
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (state->num_runners > 0) {
+    lock.unlock();
+    const bool ran_task = RunPendingTask(state.get());
+    lock.lock();
+    if (!ran_task && state->num_runners > 0) {
+      // Nothing left to help with, the runners are all running elsewhere
+      state->runner_done.wait(lock);
+    }
+  }
+  return state->status;
+}
+
+// ----------------------------------------------------------------------
+// WorkStealingExecutor
+
+namespace {
+
+// Executor and deque of the current thread, if it is a worker
+thread_local const WorkStealingExecutor* current_executor = nullptr;
+thread_local int current_worker = -1;
+
+}  // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(int num_threads)
+    : num_queued_(0), shutdown_(false) {
+  if (num_threads < 1) {
+    throw ParquetException("An executor needs at least one thread");
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    queues_.emplace_back(new TaskQueue());
+    queues_.back()->queued_cost = 0;
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(&WorkStealingExecutor::WorkerLoop, this, i);
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    shutdown_ = true;
+  }
+  idle_cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkStealingExecutor::Submit(std::function<void()> task, int64_t cost,
+                                  const void* group) {
+  TaskQueue* queue;
+  if (current_executor == this) {
+    // Tasks spawned by a task stay with its thread, unless they are stolen
+    queue = queues_[current_worker].get();
+  } else {
+    queue = queues_[0].get();
+    for (const auto& candidate : queues_) {
+      if (candidate->queued_cost < queue->queued_cost) {
+        queue = candidate.get();
+      }
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->tasks.push_back({std::move(task), cost, group});
+    queue->queued_cost += cost;
+  }
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    ++num_queued_;
+  }
+  idle_cv_.notify_one();
+}
+
+void WorkStealingExecutor::TakeTask(TaskQueue* queue, std::deque<Task>::iterator task,
+                                    Task* out) {
+  *out = std::move(*task);
+  queue->tasks.erase(task);
+  queue->queued_cost -= out->cost;
+  --num_queued_;
+}
+
+bool WorkStealingExecutor::PopTask(int index, Task* out) {
+  auto Pop = [this, out](TaskQueue* queue, bool newest) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->tasks.empty()) {
+      return false;
+    }
+    TakeTask(queue, newest ? queue->tasks.end() - 1 : queue->tasks.begin(), out);
+    return true;
+  };
+
+  if (Pop(queues_[index].get(), true)) {
+    return true;
+  }
+
+  // Steal from the thread with the most queued work, then from any thread
+  TaskQueue* victim = nullptr;
+  int64_t victim_cost = 0;
+  for (const auto& queue : queues_) {
+    if (queue->queued_cost > victim_cost) {
+      victim = queue.get();
+      victim_cost = queue->queued_cost;
+    }
+  }
+  if (victim != nullptr && Pop(victim, false)) {
+    return true;
+  }
+  for (const auto& queue : queues_) {
+    if (Pop(queue.get(), false)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingExecutor::PopGroupTask(int index, const void* group, Task* out) {
+  auto IsInGroup = [group](const Task& task) { return task.group == group; };
+  {
+    TaskQueue* queue = queues_[index].get();
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    auto task = std::find_if(queue->tasks.rbegin(), queue->tasks.rend(), IsInGroup);
+    if (task != queue->tasks.rend()) {
+      TakeTask(queue, std::next(task).base(), out);
+      return true;
+    }
+  }
+  for (int i = 0; i < static_cast<int>(queues_.size()); ++i) {
+    if (i == index) {
+      continue;
+    }
+    TaskQueue* queue = queues_[i].get();
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    auto task = std::find_if(queue->tasks.begin(), queue->tasks.end(), IsInGroup);
+    if (task != queue->tasks.end()) {
+      TakeTask(queue, task, out);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingExecutor::RunTask(Task* task) {
+  try {
+    task->func();
+  } catch (...) {
+    // Nobody waits on the task as such, see Submit
+  }
+}
+
+bool WorkStealingExecutor::RunPendingTask(const void* group) {
+  if (current_executor != this) {
+    return false;
+  }
+  Task task;
+  if (!PopGroupTask(current_worker, group, &task)) {
+    return false;
+  }
+  RunTask(&task);
+  return true;
+}
+
+void WorkStealingExecutor::WorkerLoop(int index) {
+  current_executor = this;
+  current_worker = index;
+  while (true) {
+    Task task;
+    if (PopTask(index, &task)) {
+      RunTask(&task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    idle_cv_.wait(lock, [this]() { return shutdown_ || num_queued_ > 0; });
+    if (shutdown_ && num_queued_ <= 0) {
+      return;
+    }
+  }
+}
+
+std::shared_ptr<Executor> default_executor() {
+  static std::shared_ptr<Executor> executor = std::make_shared<WorkStealingExecutor>(
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+  return executor;
+}
+
+}  // namespace parquet
@@ -0,0 +1,134 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_EXECUTOR_H
+#define PARQUET_UTIL_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "arrow/status.h"
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+/// \brief Runs tasks on a set of threads that can be shared by any number of
+/// readers and writers, so that concurrent scans do not oversubscribe the CPU
+class PARQUET_EXPORT Executor {
+ public:
+  virtual ~Executor();
+
+  /// \brief Queue task to run on one of the executor's threads. cost is a
+  /// hint of the relative amount of work in the task, e.g. a number of bytes
+  /// to decode; costlier tasks are spread first. group tags the task for
+  /// RunPendingTask, usually with the address of the state it shares with the
+  /// tasks it is waited on with. Exceptions escaping task are caught and
+  /// dropped: tasks that can fail report their errors through that state, as
+  /// those of ParallelFor do
+  virtual void Submit(std::function<void()> task, int64_t cost = 1,
+                      const void* group = nullptr) = 0;
+
+  /// \brief If called from one of the executor's threads, run one queued task
+  /// of group and return true. Tasks waiting on other tasks of the same
+  /// executor call this, so that they help instead of holding a thread idle.
+  /// Only tasks of the group are run, so a wait lasts as long as the tasks it
+  /// waits on and not as long as unrelated ones, e.g. the read of another
+  /// column, and waits only nest as deep as the groups they wait on do
+  virtual bool RunPendingTask(const void* group) = 0;
+
+  /// \brief Number of threads running the tasks
+  virtual int capacity() const = 0;
+
+  /// \brief Run func(0), ..., func(num_tasks - 1) with at most
+  /// max_parallelism of them at once, and wait for all of them. Tasks are
+  /// started by decreasing costs[i] if costs is not empty
+  /// \return the error of one of the failed tasks, if any
+  ::arrow::Status ParallelFor(int max_parallelism, int num_tasks,
+                              const std::function<::arrow::Status(int)>& func,
+                              const std::vector<int64_t>& costs = {});
+};
+
+/// \brief Executor with one task deque per thread. A thread runs the most
+/// recent task it queued itself and, when its deque is empty, steals the
+/// oldest task of the thread with the most queued cost
+class PARQUET_EXPORT WorkStealingExecutor : public Executor {
+ public:
+  explicit WorkStealingExecutor(int num_threads);
+
+  /// \brief Finish the queued tasks and join the threads
+  ~WorkStealingExecutor() override;
+
+  void Submit(std::function<void()> task, int64_t cost = 1,
+              const void* group = nullptr) override;
+
+  bool RunPendingTask(const void* group) override;
+
+  int capacity() const override { return static_cast<int>(workers_.size()); }
+
+ private:
+  struct Task {
+    std::function<void()> func;
+    int64_t cost;
+    const void* group;
+  };
+
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::atomic<int64_t> queued_cost;
+  };
+
+  void WorkerLoop(int index);
+
+  // Pop the newest task queued by thread index, or steal the oldest task of
+  // another thread
+  bool PopTask(int index, Task* out);
+
+  // Pop the newest task of group queued by thread index, or the oldest one of
+  // another thread
+  bool PopGroupTask(int index, const void* group, Task* out);
+
+  // Move task out of queue, whose mutex must be held, to out
+  void TakeTask(TaskQueue* queue, std::deque<Task>::iterator task, Task* out);
+
+  static void RunTask(Task* task);
+
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+  // Tasks submitted and not popped yet
+  std::atomic<int64_t> num_queued_;
+  bool shutdown_;
+};
+
+/// \brief Process-wide WorkStealingExecutor with one thread per hardware
+/// thread, used unless a reader or writer is given an executor of its own
+std::shared_ptr<Executor> PARQUET_EXPORT default_executor();
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_EXECUTOR_H
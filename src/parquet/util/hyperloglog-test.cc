@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "parquet/exception.h"
+#include "parquet/util/hyperloglog.h"
+
+namespace parquet {
+
+namespace test {
+
+// Hash of value, any bijection will do since sketches remix their hashes
+static uint64_t TestHash(uint32_t value) { return value * 2654435761U; }
+
+static void ExpectWithin(double tolerance, int64_t expected, int64_t actual) {
+  EXPECT_LE(std::abs(static_cast<double>(actual - expected)),
+            tolerance * static_cast<double>(expected))
+      << "expected about " << expected << ", estimated " << actual;
+}
+
+TEST(TestHyperLogLog, Estimate) {
+  HyperLogLog sketch;
+  ASSERT_EQ(0, sketch.Estimate());
+
+  // Small cardinalities are counted almost exactly
+  for (uint32_t i = 0; i < 100; ++i) {
+    sketch.AddHash(TestHash(i));
+    sketch.AddHash(TestHash(i));
+  }
+  ExpectWithin(0.02, 100, sketch.Estimate());
+
+  for (uint32_t i = 100; i < 200000; ++i) {
+    sketch.AddHash(TestHash(i));
+  }
+  // Four standard errors of the default precision
+  ExpectWithin(0.065, 200000, sketch.Estimate());
+
+  HyperLogLog precise(16);
+  for (uint32_t i = 0; i < 1000000; ++i) {
+    precise.AddHash(TestHash(i % 500000));
+  }
+  ExpectWithin(0.02, 500000, precise.Estimate());
+}
+
+TEST(TestHyperLogLog, Merge) {
+  HyperLogLog a;
+  HyperLogLog b;
+  HyperLogLog both;
+  for (uint32_t i = 0; i < 30000; ++i) {
+    a.AddHash(TestHash(i));
+    both.AddHash(TestHash(i));
+  }
+  for (uint32_t i = 20000; i < 50000; ++i) {
+    b.AddHash(TestHash(i));
+    both.AddHash(TestHash(i));
+  }
+  a.Merge(b);
+  ASSERT_EQ(both.Estimate(), a.Estimate());
+  ExpectWithin(0.065, 50000, a.Estimate());
+
+  HyperLogLog other_precision(10);
+  ASSERT_THROW(a.Merge(other_precision), ParquetException);
+}
+
+TEST(TestHyperLogLog, Serialize) {
+  for (int precision : {kHyperLogLogMinPrecision, 11, kHyperLogLogDefaultPrecision}) {
+    HyperLogLog sketch(precision);
+    for (uint32_t i = 0; i < 10000; ++i) {
+      sketch.AddHash(TestHash(i));
+    }
+    const std::string serialized = sketch.Serialize();
+    std::unique_ptr<HyperLogLog> deserialized = HyperLogLog::Deserialize(serialized);
+    ASSERT_EQ(precision, deserialized->precision());
+    ASSERT_EQ(sketch.Estimate(), deserialized->Estimate());
+    ASSERT_EQ(serialized, deserialized->Serialize());
+  }
+
+  ASSERT_THROW(HyperLogLog::Deserialize(""), ParquetException);
+  // Sketches of another hash function
+  ASSERT_THROW(HyperLogLog::Deserialize("1:4:AAAAAAAAAAAAAAAAAAAAAA=="),
+               ParquetException);
+  ASSERT_THROW(HyperLogLog::Deserialize("3:4:AAAAAAAAAAAAAAAAAAAAAA=="),
+               ParquetException);
+  ASSERT_THROW(HyperLogLog::Deserialize("2:x:AAAAAAAAAAAAAAAAAAAAAA=="),
+               ParquetException);
+  // Too few registers, invalid characters and out of range ranks
+  ASSERT_THROW(HyperLogLog::Deserialize("2:4:AAAA"), ParquetException);
+  ASSERT_THROW(HyperLogLog::Deserialize("2:4:AAAAAAAAAAAAAAAAAAAAA*=="),
+               ParquetException);
+  ASSERT_THROW(HyperLogLog::Deserialize("2:4:/wAAAAAAAAAAAAAAAAAAAA=="),
+               ParquetException);
+  ASSERT_NO_THROW(HyperLogLog::Deserialize("2:4:AAAAAAAAAAAAAAAAAAAAAA=="));
+
+  ASSERT_THROW(HyperLogLog(kHyperLogLogMinPrecision - 1), ParquetException);
+  ASSERT_THROW(HyperLogLog(kHyperLogLogMaxPrecision + 1), ParquetException);
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,205 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/hyperloglog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+#include "parquet/exception.h"
+
+namespace parquet {
+
+namespace {
+
+// Serialized sketches are "<version>:<precision>:<base64 of the registers>".
+// Version 2 sketches hash values with HashUtil::MurmurHash2_64 and seed 0
+// (DistinctCountHash). Version 1 used the CPU-dependent HashUtil::Hash, so its
+// sketches cannot be merged and are refused
+constexpr char kSerializationVersion[] = "2";
+
+constexpr char kBase64Chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string Base64Encode(const std::vector<uint8_t>& data) {
+  std::string result;
+  result.reserve((data.size() + 2) / 3 * 4);
+  size_t i = 0;
+  for (; i + 2 < data.size(); i += 3) {
+    const uint32_t triple = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+    result.push_back(kBase64Chars[(triple >> 18) & 0x3F]);
+    result.push_back(kBase64Chars[(triple >> 12) & 0x3F]);
+    result.push_back(kBase64Chars[(triple >> 6) & 0x3F]);
+    result.push_back(kBase64Chars[triple & 0x3F]);
+  }
+  if (i < data.size()) {
+    uint32_t triple = data[i] << 16;
+    if (i + 1 < data.size()) {
+      triple |= data[i + 1] << 8;
+    }
+    result.push_back(kBase64Chars[(triple >> 18) & 0x3F]);
+    result.push_back(kBase64Chars[(triple >> 12) & 0x3F]);
+    result.push_back(i + 1 < data.size() ? kBase64Chars[(triple >> 6) & 0x3F] : '=');
+    result.push_back('=');
+  }
+  return result;
+}
+
+// Return false if encoded is not valid base64
+bool Base64Decode(const std::string& encoded, std::vector<uint8_t>* out) {
+  if (encoded.size() % 4 != 0) {
+    return false;
+  }
+  out->clear();
+  out->reserve(encoded.size() / 4 * 3);
+  for (size_t i = 0; i < encoded.size(); i += 4) {
+    // Only the last two characters of the input can be padding
+    const bool last = i + 4 == encoded.size();
+    uint32_t quad = 0;
+    int num_padding = 0;
+    for (size_t j = 0; j < 4; ++j) {
+      const char c = encoded[i + j];
+      uint32_t value = 0;
+      if (c == '=') {
+        if (!last || j < 2) {
+          return false;
+        }
+        ++num_padding;
+      } else {
+        const char* pos = c == '\0' ? nullptr : std::strchr(kBase64Chars, c);
+        if (pos == nullptr || num_padding > 0) {
+          return false;
+        }
+        value = static_cast<uint32_t>(pos - kBase64Chars);
+      }
+      quad = (quad << 6) | value;
+    }
+    out->push_back(static_cast<uint8_t>(quad >> 16));
+    if (num_padding < 2) {
+      out->push_back(static_cast<uint8_t>(quad >> 8));
+    }
+    if (num_padding < 1) {
+      out->push_back(static_cast<uint8_t>(quad));
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+HyperLogLog::HyperLogLog(int precision) : precision_(precision) {
+  if (precision < kHyperLogLogMinPrecision || precision > kHyperLogLogMaxPrecision) {
+    std::stringstream ss;
+    ss << "HyperLogLog precision must be between " << kHyperLogLogMinPrecision
+       << " and " << kHyperLogLogMaxPrecision << ", got " << precision;
+    throw ParquetException(ss.str());
+  }
+  registers_.assign(static_cast<size_t>(1) << precision, 0);
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+  if (other.precision_ != precision_) {
+    std::stringstream ss;
+    ss << "Cannot merge HyperLogLog sketches of precisions " << precision_ << " and "
+       << other.precision_;
+    throw ParquetException(ss.str());
+  }
+  for (size_t i = 0; i < registers_.size(); ++i) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+int64_t HyperLogLog::Estimate() const {
+  const double num_registers = static_cast<double>(registers_.size());
+  double sum = 0;
+  int64_t num_zeros = 0;
+  for (uint8_t rank : registers_) {
+    sum += std::ldexp(1.0, -rank);
+    num_zeros += rank == 0;
+  }
+
+  double alpha;
+  switch (registers_.size()) {
+    case 16:
+      alpha = 0.673;
+      break;
+    case 32:
+      alpha = 0.697;
+      break;
+    case 64:
+      alpha = 0.709;
+      break;
+    default:
+      alpha = 0.7213 / (1.0 + 1.079 / num_registers);
+      break;
+  }
+  double estimate = alpha * num_registers * num_registers / sum;
+
+  // The raw estimate is biased for small cardinalities, where linear counting
+  // of the empty registers is more accurate. Hashes have 64 bits, so collisions
+  // only bias the estimate far beyond 2^32 values and there is no large range
+  // correction
+  if (estimate <= 2.5 * num_registers && num_zeros > 0) {
+    estimate = num_registers * std::log(num_registers / static_cast<double>(num_zeros));
+  }
+  return static_cast<int64_t>(std::llround(estimate));
+}
+
+std::string HyperLogLog::Serialize() const {
+  std::stringstream ss;
+  ss << kSerializationVersion << ":" << precision_ << ":" << Base64Encode(registers_);
+  return ss.str();
+}
+
+std::unique_ptr<HyperLogLog> HyperLogLog::Deserialize(const std::string& serialized) {
+  const size_t version_end = serialized.find(':');
+  const size_t precision_end = version_end == std::string::npos
+                                   ? std::string::npos
+                                   : serialized.find(':', version_end + 1);
+  if (precision_end == std::string::npos ||
+      serialized.compare(0, version_end, kSerializationVersion) != 0) {
+    throw ParquetException("Invalid serialized HyperLogLog sketch");
+  }
+
+  const std::string precision_str =
+      serialized.substr(version_end + 1, precision_end - version_end - 1);
+  if (precision_str.empty() || precision_str.size() > 2 ||
+      !std::all_of(precision_str.begin(), precision_str.end(),
+                   [](char c) { return c >= '0' && c <= '9'; })) {
+    throw ParquetException("Invalid serialized HyperLogLog sketch");
+  }
+  std::unique_ptr<HyperLogLog> sketch(new HyperLogLog(std::stoi(precision_str)));
+
+  std::vector<uint8_t> registers;
+  if (!Base64Decode(serialized.substr(precision_end + 1), &registers) ||
+      registers.size() != sketch->registers_.size()) {
+    throw ParquetException("Invalid serialized HyperLogLog sketch");
+  }
+  const int max_rank = 64 - sketch->precision_ + 1;
+  for (uint8_t rank : registers) {
+    if (rank > max_rank) {
+      throw ParquetException("Invalid serialized HyperLogLog sketch");
+    }
+  }
+  sketch->registers_ = std::move(registers);
+  return sketch;
+}
+
+}  // namespace parquet
@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_HYPERLOGLOG_H
+#define PARQUET_UTIL_HYPERLOGLOG_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+static constexpr int kHyperLogLogMinPrecision = 4;
+static constexpr int kHyperLogLogMaxPrecision = 16;
+static constexpr int kHyperLogLogDefaultPrecision = 12;
+
+/// \brief HyperLogLog sketch of the number of distinct values in a column.
+///
+/// Values are added by their 64-bit hash. Each of the 2^precision one-byte registers
+/// keeps the longest run of leading zeros seen among the hashes of its bucket.
+/// The relative standard error of the estimate is about 1.04 / sqrt(2^precision),
+/// i.e. 1.6% for the default precision, and sketches of the same precision merge
+/// losslessly, e.g. across the row groups of a file or across files. Sketches
+/// are only comparable if their values were hashed with the same function, so
+/// the column writer uses a fixed one, DistinctCountHash, whose identity is part
+/// of the serialization version
+class PARQUET_EXPORT HyperLogLog {
+ public:
+  /// \brief Throws ParquetException if precision is not within
+  /// [kHyperLogLogMinPrecision, kHyperLogLogMaxPrecision]
+  explicit HyperLogLog(int precision = kHyperLogLogDefaultPrecision);
+
+  int precision() const { return precision_; }
+
+  /// \brief Add a value by its 64-bit hash. Equal values must have equal
+  /// hashes; the hash is remixed before use
+  void AddHash(uint64_t hash) {
+    const uint64_t mixed = Mix(hash);
+    const uint64_t index = mixed >> (64 - precision_);
+    const uint8_t rank = Rank(mixed << precision_);
+    if (rank > registers_[index]) {
+      registers_[index] = rank;
+    }
+  }
+
+  /// \brief Make this sketch count the values of other too. Throws
+  /// ParquetException if the precisions differ
+  void Merge(const HyperLogLog& other);
+
+  /// \brief Estimated number of distinct values added
+  int64_t Estimate() const;
+
+  /// \brief Printable encoding of the sketch, e.g. for key-value metadata
+  std::string Serialize() const;
+
+  /// \brief Throws ParquetException if serialized is not a valid sketch
+  static std::unique_ptr<HyperLogLog> Deserialize(const std::string& serialized);
+
+ private:
+  // Spread weak hashes over all 64 bits (splitmix64 finalizer)
+  static uint64_t Mix(uint64_t hash) {
+    uint64_t z = hash + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  // Position of the first set bit of the hash bits left of the bucket index
+  uint8_t Rank(uint64_t bits) const {
+    const int max_rank = 64 - precision_ + 1;
+    if (bits == 0) {
+      return static_cast<uint8_t>(max_rank);
+    }
+#if defined(__GNUC__)
+    return static_cast<uint8_t>(__builtin_clzll(bits) + 1);
+#else
+    uint8_t rank = 1;
+    while ((bits & (1ULL << 63)) == 0) {
+      bits <<= 1;
+      ++rank;
+    }
+    return rank;
+#endif
+  }
+
+  int precision_;
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_HYPERLOGLOG_H
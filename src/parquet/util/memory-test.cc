@@ -358,4 +358,94 @@ TEST(TestArrowInputFile, Read) {
   ASSERT_EQ(16, source->Tell());
 }
 
+// Records the writes it gets, and fails the ones after max_writes
+class RecordingOutputStream : public OutputStream {
+ public:
+  explicit RecordingOutputStream(int max_writes = -1)
+      : max_writes_(max_writes), closed_(false) {}
+
+  void Close() override { closed_ = true; }
+
+  int64_t Tell() override { return static_cast<int64_t>(data_.size()); }
+
+  void Write(const uint8_t* data, int64_t length) override {
+    if (max_writes_ >= 0 && static_cast<int>(write_sizes_.size()) >= max_writes_) {
+      throw ParquetException("No space left on device");
+    }
+    write_sizes_.push_back(length);
+    data_.insert(data_.end(), data, data + length);
+  }
+
+  const std::vector<uint8_t>& data() const { return data_; }
+  const std::vector<int64_t>& write_sizes() const { return write_sizes_; }
+  bool closed() const { return closed_; }
+
+ private:
+  int max_writes_;
+  bool closed_;
+  std::vector<uint8_t> data_;
+  std::vector<int64_t> write_sizes_;
+};
+
+TEST(TestAsyncOutputStream, CoalescesWrites) {
+  auto sink = std::make_shared<RecordingOutputStream>();
+  std::vector<uint8_t> expected = {'P', 'A', 'R', '1'};
+  sink->Write(expected.data(), 4);
+
+  AsyncOutputStream stream(sink, 1000, 2);
+  ASSERT_EQ(4, stream.Tell());
+  std::vector<uint8_t> chunk;
+  for (int i = 0; i < 5000; ++i) {
+    chunk.assign(i % 37, static_cast<uint8_t>(i));
+    stream.Write(chunk.data(), static_cast<int64_t>(chunk.size()));
+    expected.insert(expected.end(), chunk.begin(), chunk.end());
+  }
+  // A write larger than the buffers
+  chunk.assign(2500, 42);
+  stream.Write(chunk.data(), static_cast<int64_t>(chunk.size()));
+  expected.insert(expected.end(), chunk.begin(), chunk.end());
+  ASSERT_EQ(static_cast<int64_t>(expected.size()), stream.Tell());
+
+  stream.Close();
+  ASSERT_TRUE(sink->closed());
+  ASSERT_EQ(expected, sink->data());
+
+  // All writes but the first and the last are of whole buffers
+  const std::vector<int64_t>& write_sizes = sink->write_sizes();
+  ASSERT_EQ(2 + (static_cast<int64_t>(expected.size()) - 4) / 1000,
+            static_cast<int64_t>(write_sizes.size()));
+  for (size_t i = 1; i < write_sizes.size() - 1; ++i) {
+    ASSERT_EQ(1000, write_sizes[i]);
+  }
+
+  ASSERT_THROW(stream.Write(chunk.data(), 1), ParquetException);
+}
+
+TEST(TestAsyncOutputStream, Errors) {
+  auto sink = std::make_shared<RecordingOutputStream>(2);
+  AsyncOutputStream stream(sink, 100, 2);
+  std::vector<uint8_t> chunk(10, 0);
+  try {
+    // Fails once the writer thread reports the error
+    for (int i = 0; i < 1000; ++i) {
+      stream.Write(chunk.data(), static_cast<int64_t>(chunk.size()));
+    }
+  } catch (const ParquetException&) {
+  }
+  ASSERT_THROW(stream.Close(), ParquetException);
+  ASSERT_TRUE(sink->closed());
+  ASSERT_EQ(2, static_cast<int>(sink->write_sizes().size()));
+
+  ASSERT_THROW(AsyncOutputStream(sink, 0, 2), ParquetException);
+  ASSERT_THROW(AsyncOutputStream(sink, 100, 1), ParquetException);
+
+  // Destroyed without being closed, which writes the data
+  auto other_sink = std::make_shared<RecordingOutputStream>();
+  {
+    AsyncOutputStream other(other_sink, 100, 2);
+    other.Write(chunk.data(), static_cast<int64_t>(chunk.size()));
+  }
+  ASSERT_EQ(chunk, other_sink->data());
+}
+
 }  // namespace parquet
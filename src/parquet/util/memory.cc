@@ -18,11 +18,19 @@
 #include "parquet/util/memory.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <sstream>
 #include <string>
 #include <utility>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "arrow/io/file.h"
 #include "arrow/status.h"
 #include "arrow/util/bit-util.h"
 
@@ -335,7 +343,19 @@ int64_t ArrowFileMethods::Tell() {
 
 ArrowInputFile::ArrowInputFile(
     const std::shared_ptr<::arrow::io::ReadableFileInterface>& file)
-    : file_(file) {}
+    : file_(file), fd_(-1), serialize_reads_(true), position_(-1) {
+#ifndef _WIN32
+  auto local_file = dynamic_cast<::arrow::io::ReadableFile*>(file.get());
+  if (local_file != nullptr) {
+    fd_ = local_file->file_descriptor();
+    serialize_reads_ = false;
+  }
+#endif
+  // BufferReader::ReadAt only slices or copies the buffer
+  if (dynamic_cast<::arrow::io::BufferReader*>(file.get()) != nullptr) {
+    serialize_reads_ = false;
+  }
+}
 
 ::arrow::io::FileInterface* ArrowInputFile::file_interface() { return file_.get(); }
 
@@ -345,27 +365,93 @@ int64_t ArrowInputFile::Size() const {
   return size;
 }
 
+int64_t* ArrowInputFile::position() {
+  if (position_ < 0) {
+    position_ = ArrowFileMethods::Tell();
+  }
+  return &position_;
+}
+
+int64_t ArrowInputFile::Tell() {
+  std::lock_guard<std::mutex> lock(lock_);
+  return *position();
+}
+
 // Returns bytes read
 int64_t ArrowInputFile::Read(int64_t nbytes, uint8_t* out) {
-  int64_t bytes_read = 0;
-  PARQUET_THROW_NOT_OK(file_->Read(nbytes, &bytes_read, out));
+  std::lock_guard<std::mutex> lock(lock_);
+  int64_t* current = position();
+  const int64_t bytes_read = ReadAtUnlocked(*current, nbytes, out);
+  *current += bytes_read;
   return bytes_read;
 }
 
 std::shared_ptr<Buffer> ArrowInputFile::Read(int64_t nbytes) {
+  std::lock_guard<std::mutex> lock(lock_);
+  int64_t* current = position();
   std::shared_ptr<Buffer> out;
-  PARQUET_THROW_NOT_OK(file_->Read(nbytes, &out));
+  if (fd_ >= 0) {
+    auto buffer = AllocateBuffer(::arrow::default_memory_pool(), nbytes);
+    const int64_t bytes_read = ReadAtUnlocked(*current, nbytes, buffer->mutable_data());
+    PARQUET_THROW_NOT_OK(buffer->Resize(bytes_read, false));
+    out = buffer;
+  } else {
+    PARQUET_THROW_NOT_OK(file_->ReadAt(*current, nbytes, &out));
+  }
+  *current += out->size();
   return out;
 }
 
 std::shared_ptr<Buffer> ArrowInputFile::ReadAt(int64_t position, int64_t nbytes) {
+  if (fd_ >= 0) {
+    auto buffer = AllocateBuffer(::arrow::default_memory_pool(), nbytes);
+    const int64_t bytes_read = ReadAtUnlocked(position, nbytes, buffer->mutable_data());
+    PARQUET_THROW_NOT_OK(buffer->Resize(bytes_read, false));
+    return buffer;
+  }
+  std::unique_lock<std::mutex> lock(lock_, std::defer_lock);
+  if (serialize_reads_) {
+    lock.lock();
+  }
   std::shared_ptr<Buffer> out;
   PARQUET_THROW_NOT_OK(file_->ReadAt(position, nbytes, &out));
   return out;
 }
 
 int64_t ArrowInputFile::ReadAt(int64_t position, int64_t nbytes, uint8_t* out) {
+  std::unique_lock<std::mutex> lock(lock_, std::defer_lock);
+  if (serialize_reads_) {
+    lock.lock();
+  }
+  return ReadAtUnlocked(position, nbytes, out);
+}
+
+int64_t ArrowInputFile::ReadAtUnlocked(int64_t position, int64_t nbytes, uint8_t* out) {
   int64_t bytes_read = 0;
+#ifndef _WIN32
+  if (fd_ >= 0) {
+    // pread neither moves nor depends on the offset of the descriptor
+    while (bytes_read < nbytes) {
+      const ssize_t ret = pread(fd_, out + bytes_read,
+                                static_cast<size_t>(nbytes - bytes_read),
+                                static_cast<off_t>(position + bytes_read));
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ret < 0) {
+        std::stringstream ss;
+        ss << "Error reading " << nbytes << " bytes at offset " << position << ": "
+           << std::strerror(errno);
+        throw ParquetException(ss.str());
+      }
+      if (ret == 0) {
+        break;
+      }
+      bytes_read += ret;
+    }
+    return bytes_read;
+  }
+#endif
   PARQUET_THROW_NOT_OK(file_->ReadAt(position, nbytes, &bytes_read, out));
   return bytes_read;
 }
@@ -449,6 +535,152 @@ std::shared_ptr<Buffer> InMemoryOutputStream::GetBuffer() {
   return result;
 }
 
+// ----------------------------------------------------------------------
+// AsyncOutputStream
+
+AsyncOutputStream::AsyncOutputStream(const std::shared_ptr<OutputStream>& sink,
+                                     int64_t buffer_size, int num_buffers,
+                                     MemoryPool* pool)
+    : sink_(sink),
+      buffer_size_(buffer_size),
+      num_buffers_(num_buffers),
+      pool_(pool),
+      position_(sink->Tell()),
+      closed_(false),
+      current_size_(0),
+      num_allocated_(0),
+      shutdown_(false) {
+  if (buffer_size <= 0 || num_buffers < 2) {
+    throw ParquetException(
+        "AsyncOutputStream needs at least two buffers of at least one byte");
+  }
+  writer_ = std::thread(&AsyncOutputStream::WriterLoop, this);
+}
+
+AsyncOutputStream::~AsyncOutputStream() {
+  try {
+    Close();
+  } catch (const std::exception&) {
+  }
+  if (writer_.joinable()) {
+    // Close failed before stopping the writer thread
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    write_pending_.notify_one();
+    writer_.join();
+  }
+}
+
+void AsyncOutputStream::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  if (current_size_ > 0) {
+    SubmitBuffer();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  write_pending_.notify_one();
+  writer_.join();
+
+  current_.reset();
+  free_buffers_.clear();
+  try {
+    sink_->Close();
+  } catch (const std::exception& e) {
+    if (error_.empty()) {
+      error_ = e.what();
+    }
+  }
+  if (!error_.empty()) {
+    throw ParquetException(error_);
+  }
+}
+
+int64_t AsyncOutputStream::Tell() { return position_; }
+
+void AsyncOutputStream::Write(const uint8_t* data, int64_t length) {
+  if (closed_) {
+    throw ParquetException("Write to a closed AsyncOutputStream");
+  }
+  while (length > 0) {
+    if (current_ == nullptr) {
+      current_ = AcquireBuffer();
+    }
+    int64_t bytes_to_copy = std::min(length, buffer_size_ - current_size_);
+    memcpy(current_->mutable_data() + current_size_, data, bytes_to_copy);
+    current_size_ += bytes_to_copy;
+    position_ += bytes_to_copy;
+    data += bytes_to_copy;
+    length -= bytes_to_copy;
+    if (current_size_ == buffer_size_) {
+      SubmitBuffer();
+    }
+  }
+}
+
+std::shared_ptr<ResizableBuffer> AsyncOutputStream::AcquireBuffer() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  buffer_free_.wait(lock, [this]() {
+    return !error_.empty() || !free_buffers_.empty() || num_allocated_ < num_buffers_;
+  });
+  if (!error_.empty()) {
+    throw ParquetException(error_);
+  }
+  if (free_buffers_.empty()) {
+    ++num_allocated_;
+    return AllocateBuffer(pool_, buffer_size_);
+  }
+  std::shared_ptr<ResizableBuffer> buffer = std::move(free_buffers_.back());
+  free_buffers_.pop_back();
+  return buffer;
+}
+
+void AsyncOutputStream::SubmitBuffer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back({std::move(current_), current_size_});
+  }
+  write_pending_.notify_one();
+  current_ = nullptr;
+  current_size_ = 0;
+}
+
+void AsyncOutputStream::WriterLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    write_pending_.wait(lock, [this]() { return shutdown_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      return;
+    }
+    PendingWrite write = std::move(pending_.front());
+    pending_.pop_front();
+    const bool failed = !error_.empty();
+    lock.unlock();
+
+    std::string error;
+    if (!failed) {
+      try {
+        sink_->Write(write.buffer->data(), write.size);
+      } catch (const std::exception& e) {
+        error = e.what();
+      }
+    }
+
+    lock.lock();
+    if (!error.empty()) {
+      error_ = std::move(error);
+    }
+    free_buffers_.push_back(std::move(write.buffer));
+    buffer_free_.notify_one();
+  }
+}
+
 // ----------------------------------------------------------------------
 // BufferedInputStream
 
@@ -19,11 +19,15 @@
 #define PARQUET_UTIL_MEMORY_H
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "arrow/buffer.h"
@@ -70,6 +74,8 @@ static inline std::unique_ptr<::arrow::Codec> GetCodecFromArrow(Compression::typ
 }
 
 static constexpr int64_t kInMemoryDefaultCapacity = 1024;
+static constexpr int64_t kAsyncOutputDefaultBufferSize = 4 * 1024 * 1024;
+static constexpr int kAsyncOutputDefaultNumBuffers = 4;
 
 using Buffer = ::arrow::Buffer;
 using MutableBuffer = ::arrow::MutableBuffer;
@@ -87,6 +93,7 @@ class PARQUET_EXPORT Vector {
   inline T& operator[](int64_t i) const { return data_[i]; }
 
   const T* data() const { return data_; }
+  int64_t size() const { return size_; }
 
  private:
   std::unique_ptr<PoolBuffer> buffer_;
@@ -253,8 +260,12 @@ class PARQUET_EXPORT FileInterface {
   virtual int64_t Tell() = 0;
 };
 
-/// It is the responsibility of implementations to mind threadsafety of shared
-/// resources
+/// Implementations must allow ReadAt to be called from several threads at once,
+/// and ReadAt must not move the position of Read and Tell, like pread. Read and
+/// Tell need not be thread-safe.
+///
+/// ParquetFileReader only reads its source with ReadAt, so that different
+/// threads can read the column chunks of one file concurrently
 class PARQUET_EXPORT RandomAccessSource : virtual public FileInterface {
  public:
   virtual ~RandomAccessSource() = default;
@@ -291,7 +302,10 @@ class PARQUET_EXPORT ArrowFileMethods : virtual public FileInterface {
   virtual ::arrow::io::FileInterface* file_interface() = 0;
 };
 
-/// This interface depends on the threadsafety of the underlying Arrow file interface
+/// RandomAccessSource of an Arrow file, whichever its own thread-safety. Local
+/// files are read with pread, and buffers are sliced without locking. Reads of
+/// other files are serialized, as their ReadAt may seek. Read and Tell use a
+/// position of their own, that ReadAt does not move
 class PARQUET_EXPORT ArrowInputFile : public ArrowFileMethods, public RandomAccessSource {
  public:
   explicit ArrowInputFile(
@@ -299,6 +313,8 @@ class PARQUET_EXPORT ArrowInputFile : public ArrowFileMethods, public RandomAcce
 
   int64_t Size() const override;
 
+  int64_t Tell() override;
+
   // Returns bytes read
   int64_t Read(int64_t nbytes, uint8_t* out) override;
 
@@ -313,11 +329,24 @@ class PARQUET_EXPORT ArrowInputFile : public ArrowFileMethods, public RandomAcce
 
   // Diamond inheritance
   using ArrowFileMethods::Close;
-  using ArrowFileMethods::Tell;
 
  private:
   ::arrow::io::FileInterface* file_interface() override;
+
+  // ReadAt, with lock_ held if reads are serialized
+  int64_t ReadAtUnlocked(int64_t position, int64_t nbytes, uint8_t* out);
+
+  // Position of Read and Tell, starting at the position of the file when they
+  // are first called. Requires lock_
+  int64_t* position();
+
   std::shared_ptr<::arrow::io::ReadableFileInterface> file_;
+  // Descriptor of a local file, read with pread, or -1
+  int fd_;
+  bool serialize_reads_;
+
+  std::mutex lock_;
+  int64_t position_;
 };
 
 class PARQUET_EXPORT ArrowOutputStream : public ArrowFileMethods, public OutputStream {
@@ -373,6 +402,71 @@ class PARQUET_EXPORT InMemoryOutputStream : public OutputStream {
   DISALLOW_COPY_AND_ASSIGN(InMemoryOutputStream);
 };
 
+/// OutputStream that writes to another one on a background thread, so that
+/// encoding goes on while the data is written. Writes are copied into buffers
+/// of buffer_size bytes, which are written to the sink once full: the page
+/// headers, pages and metadata are written as few large sequential writes.
+/// Write only blocks when all num_buffers are waiting to be written.
+///
+/// The errors of the background writes are thrown by a later Write, or by
+/// Close, which writes the remaining data and closes the sink.
+class PARQUET_EXPORT AsyncOutputStream : public OutputStream {
+ public:
+  explicit AsyncOutputStream(const std::shared_ptr<OutputStream>& sink,
+                             int64_t buffer_size = kAsyncOutputDefaultBufferSize,
+                             int num_buffers = kAsyncOutputDefaultNumBuffers,
+                             ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  // Closes the stream, ignoring errors
+  ~AsyncOutputStream() override;
+
+  void Close() override;
+
+  int64_t Tell() override;
+
+  void Write(const uint8_t* data, int64_t length) override;
+
+ private:
+  struct PendingWrite {
+    std::shared_ptr<ResizableBuffer> buffer;
+    int64_t size;
+  };
+
+  // Take a free buffer, waiting for one to be written if all are in use
+  std::shared_ptr<ResizableBuffer> AcquireBuffer();
+
+  // Queue the current buffer to be written
+  void SubmitBuffer();
+
+  void WriterLoop();
+
+  std::shared_ptr<OutputStream> sink_;
+  const int64_t buffer_size_;
+  const int num_buffers_;
+  ::arrow::MemoryPool* pool_;
+
+  int64_t position_;
+  bool closed_;
+
+  // Buffer being filled by Write
+  std::shared_ptr<ResizableBuffer> current_;
+  int64_t current_size_;
+
+  std::mutex mutex_;
+  std::condition_variable write_pending_;
+  std::condition_variable buffer_free_;
+  std::deque<PendingWrite> pending_;
+  std::vector<std::shared_ptr<ResizableBuffer>> free_buffers_;
+  int num_allocated_;
+  bool shutdown_;
+  // First error of the writer thread, the buffers after it are dropped
+  std::string error_;
+
+  std::thread writer_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncOutputStream);
+};
+
 // ----------------------------------------------------------------------
 // Streaming input interfaces
 
@@ -0,0 +1,479 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_RLE_INTERNAL_H
+#define PARQUET_UTIL_RLE_INTERNAL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "arrow/util/bit-stream-utils.h"
+#include "arrow/util/bit-util.h"
+
+#include "parquet/util/bitmap-internal.h"
+#include "parquet/util/dict-gather-internal.h"
+#include "parquet/util/macros.h"
+
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace parquet {
+
+// ----------------------------------------------------------------------
+// RLE / bit-packed hybrid decoder
+//
+// The format (see https://github.com/Parquet/parquet-format) is a sequence of
+// runs, each preceded by a ULEB128 header:
+//
+//   header & 1 == 0: repeated run of (header >> 1) copies of a single value
+//                    stored in ceil(bit_width / 8) little-endian bytes
+//   header & 1 == 1: literal run of (header >> 1) groups of 8 bit-packed values
+//
+// Unlike ::arrow::RleDecoder, this decoder exposes the current run to the
+// caller and keeps track of byte positions itself, so repeated runs can be
+// consumed in O(1) and bit-packed values can be skipped without unpacking
+// them. This is the building block for skipping and counting levels and
+// dictionary indices.
+
+// Size of the scratch buffers used to unpack literal runs
+static constexpr int kRleBatchBufferSize = 1024;
+
+class RleRunDecoder {
+ public:
+  RleRunDecoder() { Reset(nullptr, 0, 0); }
+
+  RleRunDecoder(const uint8_t* data, int len, int bit_width) {
+    Reset(data, len, bit_width);
+  }
+
+  void Reset(const uint8_t* data, int len, int bit_width) {
+    data_ = data;
+    end_ = data + len;
+    bit_width_ = bit_width;
+    value_bytes_ = static_cast<int>(::arrow::BitUtil::Ceil(bit_width, 8));
+    repeat_count_ = 0;
+    current_value_ = 0;
+    literal_data_ = nullptr;
+    literal_bytes_ = 0;
+    literal_offset_ = 0;
+    literal_count_ = 0;
+  }
+
+  // Load the next run if the current one is exhausted. Returns false if there
+  // is no more encoded data.
+  bool NextRun() {
+    while (repeat_count_ == 0 && literal_count_ == 0) {
+      if (!ReadRunHeader()) return false;
+    }
+    return true;
+  }
+
+  // Properties of the current run. Only meaningful after NextRun() returned true.
+  bool is_repeated() const { return repeat_count_ > 0; }
+  int run_remaining() const { return repeat_count_ > 0 ? repeat_count_ : literal_count_; }
+  uint64_t repeated_value() const { return current_value_; }
+
+  int bit_width() const { return bit_width_; }
+
+  // Decode up to batch_size values. Returns the number of values decoded.
+  template <typename T>
+  int GetBatch(T* values, int batch_size);
+
+  // Decode up to batch_size dictionary indices and look up their values.
+  // Returns the number of values decoded.
+  template <typename T>
+  int GetBatchWithDict(const T* dictionary, T* values, int batch_size);
+
+  // Like GetBatchWithDict, but leave a slot set to T() for each null according
+  // to valid_bits. Returns the number of slots (including nulls) filled.
+  template <typename T>
+  int GetBatchWithDictSpaced(const T* dictionary, T* values, int batch_size,
+                             int null_count, const uint8_t* valid_bits,
+                             int64_t valid_bits_offset);
+
+  // Advance over up to num_values values without decoding them. Returns the
+  // number of values skipped.
+  int Skip(int num_values);
+
+  // Advance over up to num_values values, adding the number of them equal to
+  // value to *num_matching. Returns the number of values skipped.
+  int SkipAndCount(int num_values, uint64_t value, int64_t* num_matching);
+
+ private:
+  bool ReadRunHeader() {
+    uint32_t header = 0;
+    int shift = 0;
+    while (true) {
+      if (data_ >= end_ || shift > 28) return false;
+      const uint8_t byte = *data_++;
+      header |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) break;
+      shift += 7;
+    }
+
+    if (header & 1) {
+      const int64_t num_groups = header >> 1;
+      const int64_t available = end_ - data_;
+      literal_data_ = data_;
+      literal_bytes_ = static_cast<int>(std::min(num_groups * bit_width_, available));
+      literal_offset_ = 0;
+      int64_t num_literals = num_groups * 8;
+      if (bit_width_ > 0) {
+        // Tolerate a truncated final group
+        num_literals = std::min<int64_t>(num_literals, literal_bytes_ * 8 / bit_width_);
+      }
+      literal_count_ = static_cast<int>(
+          std::min<int64_t>(num_literals, std::numeric_limits<int>::max()));
+      data_ += literal_bytes_;
+    } else {
+      if (end_ - data_ < value_bytes_) return false;
+      current_value_ = 0;
+      memcpy(&current_value_, data_, value_bytes_);
+      data_ += value_bytes_;
+      repeat_count_ = static_cast<int>(header >> 1);
+    }
+    return true;
+  }
+
+  // Unpack num_values <= literal_count_ values of the current literal run
+  template <typename T>
+  int UnpackLiterals(T* values, int num_values) {
+    if (bit_width_ == 0) {
+      std::fill(values, values + num_values, static_cast<T>(0));
+      ConsumeLiterals(num_values);
+      return num_values;
+    }
+    // Bit-packed groups of 8 values always start on a byte boundary
+    const uint8_t* start = literal_data_ + (literal_offset_ / 8) * bit_width_;
+    ::arrow::BitReader reader(start,
+                              static_cast<int>(literal_data_ + literal_bytes_ - start));
+    T unused;
+    for (int i = 0; i < literal_offset_ % 8; ++i) {
+      reader.GetValue(bit_width_, &unused);
+    }
+    int values_read = reader.GetBatch(bit_width_, values, num_values);
+    if (values_read < num_values) {
+      // Data ended prematurely
+      literal_count_ = 0;
+    } else {
+      ConsumeLiterals(values_read);
+    }
+    return values_read;
+  }
+
+  // Look up the values of whole bit-packed groups at the start of the current
+  // literal run with the fused AVX2 kernel, if the CPU, the value size and the
+  // run allow it. Returns the number of values decoded, a multiple of 8 that
+  // may be 0
+  template <typename T>
+  int GatherLiterals(const T* dictionary, T* values, int num_values) {
+    if (bit_width_ == 0 || bit_width_ > internal::kMaxGatherBitWidth ||
+        literal_offset_ % 8 != 0 || num_values < 8 || !internal::CanGatherDict<T>()) {
+      return 0;
+    }
+    const uint8_t* start = literal_data_ + (literal_offset_ / 8) * bit_width_;
+    // The groups of the run are whole, but the kernel reads a little past the
+    // last one, which has to stay within the data
+    const int64_t readable_groups =
+        (end_ - start - internal::kGatherPadding) / bit_width_;
+    const int num_groups =
+        static_cast<int>(std::min<int64_t>(num_values / 8, readable_groups));
+    if (num_groups <= 0) return 0;
+    internal::GatherDictGroups(start, bit_width_, num_groups, dictionary, values);
+    ConsumeLiterals(num_groups * 8);
+    return num_groups * 8;
+  }
+
+  void ConsumeLiterals(int num_values) {
+    literal_offset_ += num_values;
+    literal_count_ -= num_values;
+  }
+
+  // Position of the next run header
+  const uint8_t* data_;
+  const uint8_t* end_;
+
+  int bit_width_;
+  int value_bytes_;
+
+  // State of a repeated run
+  int repeat_count_;
+  uint64_t current_value_;
+
+  // State of a literal run
+  const uint8_t* literal_data_;
+  int literal_bytes_;
+  int literal_offset_;
+  int literal_count_;
+};
+
+template <typename T>
+inline int RleRunDecoder::GetBatch(T* values, int batch_size) {
+  int values_read = 0;
+  while (values_read < batch_size && NextRun()) {
+    int num_values = std::min(batch_size - values_read, run_remaining());
+    if (repeat_count_ > 0) {
+      std::fill(values + values_read, values + values_read + num_values,
+                static_cast<T>(current_value_));
+      repeat_count_ -= num_values;
+    } else {
+      num_values = UnpackLiterals(values + values_read, num_values);
+    }
+    values_read += num_values;
+  }
+  return values_read;
+}
+
+template <typename T>
+inline int RleRunDecoder::GetBatchWithDict(const T* dictionary, T* values,
+                                           int batch_size) {
+  int32_t indices[kRleBatchBufferSize];
+  int values_read = 0;
+  while (values_read < batch_size && NextRun()) {
+    int num_values = std::min(batch_size - values_read, run_remaining());
+    T* out = values + values_read;
+    if (repeat_count_ > 0) {
+      internal::FillValues(dictionary[current_value_], num_values, out);
+      repeat_count_ -= num_values;
+    } else {
+      const int num_gathered = GatherLiterals(dictionary, out, num_values);
+      if (num_gathered > 0) {
+        num_values = num_gathered;
+      } else {
+        if (literal_offset_ % 8 != 0) {
+          // Stop at the end of the group, so the next ones can be gathered
+          num_values = std::min(num_values, 8 - literal_offset_ % 8);
+        }
+        num_values =
+            UnpackLiterals(indices, std::min(num_values, kRleBatchBufferSize));
+        for (int i = 0; i < num_values; ++i) {
+          out[i] = dictionary[indices[i]];
+        }
+      }
+    }
+    values_read += num_values;
+  }
+  return values_read;
+}
+
+template <typename T>
+inline int RleRunDecoder::GetBatchWithDictSpaced(const T* dictionary, T* values,
+                                                 int batch_size, int null_count,
+                                                 const uint8_t* valid_bits,
+                                                 int64_t valid_bits_offset) {
+  // Look the values up densely and expand them into their slots, a block of
+  // slots at a time
+  T dense[kRleBatchBufferSize];
+  int values_read = 0;
+  while (values_read < batch_size) {
+    const int num_slots = std::min(batch_size - values_read, kRleBatchBufferSize);
+    const int64_t slots_offset = valid_bits_offset + values_read;
+    const int num_dense =
+        static_cast<int>(::arrow::CountSetBits(valid_bits, slots_offset, num_slots));
+    if (GetBatchWithDict(dictionary, dense, num_dense) != num_dense) break;
+    internal::ExpandSpaced(reinterpret_cast<const uint8_t*>(dense), num_slots,
+                           num_slots - num_dense, valid_bits, slots_offset,
+                           values + values_read);
+    values_read += num_slots;
+  }
+  return values_read;
+}
+
+inline int RleRunDecoder::Skip(int num_values) {
+  int values_skipped = 0;
+  while (values_skipped < num_values && NextRun()) {
+    const int n = std::min(num_values - values_skipped, run_remaining());
+    if (repeat_count_ > 0) {
+      repeat_count_ -= n;
+    } else {
+      ConsumeLiterals(n);
+    }
+    values_skipped += n;
+  }
+  return values_skipped;
+}
+
+inline int RleRunDecoder::SkipAndCount(int num_values, uint64_t value,
+                                       int64_t* num_matching) {
+  uint32_t buffer[kRleBatchBufferSize];
+  int values_skipped = 0;
+  while (values_skipped < num_values && NextRun()) {
+    int n = std::min(num_values - values_skipped, run_remaining());
+    if (repeat_count_ > 0) {
+      if (current_value_ == value) *num_matching += n;
+      repeat_count_ -= n;
+    } else {
+      n = UnpackLiterals(buffer, std::min(n, kRleBatchBufferSize));
+      *num_matching += std::count(buffer, buffer + n, static_cast<uint32_t>(value));
+    }
+    values_skipped += n;
+  }
+  return values_skipped;
+}
+
+// ----------------------------------------------------------------------
+// RLE / bit-packed hybrid encoder
+//
+// Counterpart of RleRunDecoder that takes whole runs of equal values instead
+// of one value at a time like ::arrow::RleEncoder. Runs of 8 or more values
+// become repeated runs, written in O(1) however long they are, and shorter
+// ones are gathered into literal runs of at most 63 groups of 8 values, so
+// that the run headers fit in one byte. The output stays within
+// ::arrow::RleEncoder::MaxBufferSize.
+
+class RleRunEncoder {
+ public:
+  RleRunEncoder(uint8_t* buffer, int buffer_len, int bit_width)
+      : bit_writer_(buffer, buffer_len),
+        bit_width_(bit_width),
+        value_bytes_(static_cast<int>(::arrow::BitUtil::Ceil(bit_width, 8))),
+        run_value_(0),
+        run_length_(0),
+        num_literals_(0),
+        num_written_(0),
+        buffer_full_(false) {}
+
+  // Append run_length copies of value. Returns false if the buffer is full.
+  bool PutRun(uint64_t value, int run_length) {
+    if (run_length_ > 0 && value == run_value_) {
+      run_length_ += run_length;
+      return !buffer_full_;
+    }
+    FlushRun();
+    run_value_ = value;
+    run_length_ = run_length;
+    return !buffer_full_;
+  }
+
+  // Append num_values values, finding the boundaries of their runs eight at a
+  // time with SSE. Returns the number of values appended before the buffer
+  // was full.
+  int Put(const int16_t* values, int num_values);
+
+  // Write out the buffered values and return the encoded length in bytes
+  int Flush() {
+    FlushRun();
+    FlushLiterals();
+    bit_writer_.Flush();
+    return len();
+  }
+
+  int len() const { return bit_writer_.bytes_written(); }
+
+  // Number of values written out completely, which after Flush() falls short
+  // of the number of values appended only if the buffer was full
+  int values_written() const { return num_written_; }
+
+ private:
+  static constexpr int kMaxLiteralRunLength = 63 * 8;
+
+  // Index of the first of values[begin, end) that differs from value, or end
+  static int FindRunEnd(const int16_t* values, int begin, int end, int16_t value) {
+    int i = begin;
+#if defined(PARQUET_USE_SSE) && defined(__SSE4_2__)
+    const __m128i expected = _mm_set1_epi16(value);
+    for (; i + 8 <= end; i += 8) {
+      const __m128i batch = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+      const int mismatch = ~_mm_movemask_epi8(_mm_cmpeq_epi16(batch, expected)) & 0xFFFF;
+      if (mismatch != 0) {
+        return i + __builtin_ctz(mismatch) / 2;
+      }
+    }
+#endif
+    while (i < end && values[i] == value) {
+      ++i;
+    }
+    return i;
+  }
+
+  // Write out the pending run, first completing the current group of literals
+  // with its values
+  void FlushRun() {
+    int run_length = run_length_;
+    run_length_ = 0;
+    while (run_length > 0 && num_literals_ % 8 != 0) {
+      AppendLiteral(run_value_);
+      --run_length;
+    }
+    if (run_length >= 8) {
+      FlushLiterals();
+      if (buffer_full_) return;
+      buffer_full_ |= !bit_writer_.PutVlqInt(static_cast<uint32_t>(run_length) << 1);
+      buffer_full_ |= !bit_writer_.PutAligned(run_value_, value_bytes_);
+      if (!buffer_full_) num_written_ += run_length;
+    } else {
+      for (; run_length > 0; --run_length) {
+        AppendLiteral(run_value_);
+      }
+    }
+  }
+
+  void AppendLiteral(uint64_t value) {
+    literals_[num_literals_++] = value;
+    if (num_literals_ == kMaxLiteralRunLength) {
+      FlushLiterals();
+    }
+  }
+
+  // Write the literals as one literal run, padding the last group with zeros
+  void FlushLiterals() {
+    if (num_literals_ == 0 || buffer_full_) {
+      num_literals_ = 0;
+      return;
+    }
+    const int num_groups = static_cast<int>(::arrow::BitUtil::Ceil(num_literals_, 8));
+    buffer_full_ |= !bit_writer_.PutVlqInt(static_cast<uint32_t>(num_groups << 1 | 1));
+    for (int i = 0; i < num_groups * 8; ++i) {
+      const uint64_t value = i < num_literals_ ? literals_[i] : 0;
+      buffer_full_ |= !bit_writer_.PutValue(value, bit_width_);
+    }
+    if (!buffer_full_) num_written_ += num_literals_;
+    num_literals_ = 0;
+  }
+
+  ::arrow::BitWriter bit_writer_;
+  int bit_width_;
+  int value_bytes_;
+
+  // The last run is kept open until a different value is appended
+  uint64_t run_value_;
+  int run_length_;
+
+  uint64_t literals_[kMaxLiteralRunLength];
+  int num_literals_;
+
+  int num_written_;
+  bool buffer_full_;
+};
+
+inline int RleRunEncoder::Put(const int16_t* values, int num_values) {
+  int i = 0;
+  while (i < num_values) {
+    const int16_t value = values[i];
+    const int run_end = FindRunEnd(values, i + 1, num_values, value);
+    if (!PutRun(static_cast<uint16_t>(value), run_end - i)) break;
+    i = run_end;
+  }
+  return i;
+}
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_RLE_INTERNAL_H